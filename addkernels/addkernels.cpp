@@ -28,9 +28,17 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#if ADDKERNELS_USE_ZLIB
+#include <zlib.h>
+#endif
 
 void Bin2Hex(std::istream& source,
              std::ostream& target,
@@ -79,6 +87,8 @@ void Bin2Hex(std::istream& source,
 
     if(nullTerminate)
         target << "0x00,";
+    else if(sourceSize == 0)
+        target << "0x00,"; // Not counted in <VAR>_SIZE. Arrays of zero length are ill-formed.
 
     if(variable.length() != 0)
     {
@@ -99,6 +109,8 @@ void PrintHelp()
     std::cout << "           -l[ine-size] <number>: bytes in one line. Default: 16." << std::endl;
     std::cout << "           -b[uffer] <number>: read buffer size. Default: 512." << std::endl;
     std::cout << "           -g[uard] <string>: guard name. Default: no guard" << std::endl;
+    std::cout << "           -c[ompress]: deflate sources with a shared dictionary. Default: off"
+              << std::endl;
 }
 
 [[gnu::noreturn]] void WrongUsage(const std::string& error)
@@ -116,10 +128,13 @@ void PrintHelp()
     WrongUsage(ss.str());
 }
 
-void Process(const std::string& sourcePath,
-             std::ostream& target,
-             size_t bufferSize,
-             size_t lineSize)
+struct KernelSource
+{
+    std::string variable;
+    std::string text;
+};
+
+KernelSource LoadSource(const std::string& sourcePath)
 {
     std::string fileName(sourcePath);
     std::string extension, root;
@@ -139,7 +154,8 @@ void Process(const std::string& sourcePath,
         fileName = fileName.substr(slashPos + 1);
     }
 
-    std::string variable(fileName);
+    KernelSource result;
+    result.variable = fileName;
     std::ifstream sourceFile(sourcePath, std::ios::in | std::ios::binary);
     std::istream* source = &sourceFile;
 
@@ -173,10 +189,133 @@ void Process(const std::string& sourcePath,
         source = &inlinerTemp;
     }
 
-    std::transform(variable.begin(), variable.end(), variable.begin(), ::toupper);
-    Bin2Hex(*source, target, variable, true, bufferSize, lineSize);
+    std::transform(
+        result.variable.begin(), result.variable.end(), result.variable.begin(), ::toupper);
+    result.text.assign(std::istreambuf_iterator<char>(*source), std::istreambuf_iterator<char>());
+    return result;
+}
+
+void Process(const std::string& sourcePath,
+             std::ostream& target,
+             size_t bufferSize,
+             size_t lineSize)
+{
+    const auto kernel = LoadSource(sourcePath);
+    std::istringstream source(kernel.text);
+    Bin2Hex(source, target, kernel.variable, true, bufferSize, lineSize);
+}
+
+#if ADDKERNELS_USE_ZLIB
+// Lines shared by several kernels (license headers, common macros, asm prologues) make up a
+// large part of the sources. They are gathered into a preset dictionary, so every blob can
+// refer to them instead of each carrying its own copy. The most widely shared lines are put
+// at the end, where deflate reaches them with the shortest distances.
+std::string BuildDictionary(const std::vector<KernelSource>& kernels, size_t maxSize)
+{
+    const size_t minLine = 8;
+    const size_t maxLine = 256;
+    std::unordered_map<std::string, std::size_t> files;
+
+    for(const auto& kernel : kernels)
+    {
+        std::unordered_set<std::string> seen;
+        std::istringstream lines(kernel.text);
+        std::string line;
+
+        while(std::getline(lines, line))
+        {
+            if(line.size() < minLine || line.size() > maxLine)
+                continue;
+            if(seen.insert(line).second)
+                ++files[line];
+        }
+    }
+
+    std::vector<std::pair<std::size_t, std::string>> scored;
+    for(auto& entry : files)
+        if(entry.second > 1)
+            scored.emplace_back((entry.second - 1) * (entry.first.size() + 1), entry.first);
+
+    std::sort(scored.begin(), scored.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first != rhs.first ? lhs.first > rhs.first : lhs.second < rhs.second;
+    });
+
+    std::vector<const std::string*> picked;
+    std::size_t size = 0;
+    for(const auto& entry : scored)
+    {
+        if(size + entry.second.size() + 1 > maxSize)
+            continue;
+        size += entry.second.size() + 1;
+        picked.push_back(&entry.second);
+    }
+
+    std::string dictionary;
+    dictionary.reserve(size);
+    for(auto it = picked.rbegin(); it != picked.rend(); ++it)
+        dictionary.append(**it).append(1, '\n');
+    return dictionary;
 }
 
+std::string Deflate(const std::string& data, const std::string& dictionary)
+{
+    z_stream stream{};
+    if(deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, 15, 9, Z_DEFAULT_STRATEGY) != Z_OK)
+    {
+        std::cerr << "deflateInit2 failed" << std::endl;
+        std::exit(1);
+    }
+
+    if(!dictionary.empty())
+        deflateSetDictionary(&stream,
+                             reinterpret_cast<const Bytef*>(dictionary.data()),
+                             static_cast<uInt>(dictionary.size()));
+
+    std::string result(deflateBound(&stream, static_cast<uLong>(data.size())), '\0');
+    stream.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+    stream.avail_in  = static_cast<uInt>(data.size());
+    stream.next_out  = reinterpret_cast<Bytef*>(&result[0]);
+    stream.avail_out = static_cast<uInt>(result.size());
+
+    const auto status = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+
+    if(status != Z_STREAM_END)
+    {
+        std::cerr << "deflate failed: " << status << std::endl;
+        std::exit(1);
+    }
+
+    result.resize(stream.total_out);
+    return result;
+}
+
+// Emits <VAR>_SIZE (the inflated size) and the deflated bytes as <VAR>_DEFLATED, all sharing
+// ADDKERNELS_DICTIONARY.
+void ProcessCompressed(const std::vector<std::string>& sourcePaths,
+                       std::ostream& target,
+                       size_t bufferSize,
+                       size_t lineSize)
+{
+    std::vector<KernelSource> kernels;
+    for(const auto& sourcePath : sourcePaths)
+        kernels.push_back(LoadSource(sourcePath));
+
+    // 32 KiB is the deflate window; dictionary bytes beyond it could never be referenced.
+    const auto dictionary = BuildDictionary(kernels, 32 * 1024);
+    std::istringstream dictionarySource(dictionary);
+    Bin2Hex(dictionarySource, target, "ADDKERNELS_DICTIONARY", false, bufferSize, lineSize);
+
+    for(const auto& kernel : kernels)
+    {
+        std::istringstream source(Deflate(kernel.text, dictionary));
+        target << "const size_t " << kernel.variable << "_SIZE = " << std::setbase(10)
+               << kernel.text.size() << ";" << std::endl;
+        Bin2Hex(source, target, kernel.variable + "_DEFLATED", false, bufferSize, lineSize);
+    }
+}
+#endif
+
 int main(int argsn, char** args)
 {
     if(argsn == 1)
@@ -188,6 +327,7 @@ int main(int argsn, char** args)
     std::string guard;
     size_t bufferSize = 512;
     size_t lineSize   = 16;
+    bool compress     = false;
 
     std::ofstream targetFile;
     std::ostream* target = &std::cout;
@@ -207,9 +347,18 @@ int main(int argsn, char** args)
                 *target << "#include <stddef.h>" << std::endl;
             }
 
-            while(++i < argsn)
+            if(compress)
+            {
+#if ADDKERNELS_USE_ZLIB
+                ProcessCompressed({args + i + 1, args + argsn}, *target, bufferSize, lineSize);
+#endif
+            }
+            else
             {
-                Process(args[i], *target, bufferSize, lineSize);
+                while(++i < argsn)
+                {
+                    Process(args[i], *target, bufferSize, lineSize);
+                }
             }
 
             if(guard.length() > 0)
@@ -230,6 +379,14 @@ int main(int argsn, char** args)
             bufferSize = std::stol(args[++i]);
         else if(arg == "g" || arg == "guard")
             guard = args[++i];
+        else if(arg == "c" || arg == "compress")
+        {
+#if ADDKERNELS_USE_ZLIB
+            compress = true;
+#else
+            WrongUsage("compression requires addkernels to be built with zlib");
+#endif
+        }
         else
             UnknownArgument(arg);
     }
@@ -0,0 +1,119 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_binary.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+void PrintHelp()
+{
+    std::cout << "Usage: compiledb {<option>}" << std::endl;
+    std::cout << "Option format: -<option name>[ <option value>]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "[REQUIRED] -s[ource] <path>: text perf db to be compiled." << std::endl;
+    std::cout << "           -t[arget] <path>: binary perf db. Default: derived from source."
+              << std::endl;
+}
+
+[[gnu::noreturn]] void WrongUsage(const std::string& error)
+{
+    std::cout << "Wrong usage: " << error << std::endl;
+    std::cout << std::endl;
+    PrintHelp();
+    std::exit(1);
+}
+
+[[gnu::noreturn]] void UnknownArgument(const std::string& arg)
+{
+    std::ostringstream ss;
+    ss << "unknown argument - " << arg;
+    WrongUsage(ss.str());
+}
+
+int main(int argsn, char** args)
+{
+    if(argsn == 1)
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    std::string source;
+    std::string target;
+
+    for(int i = 1; i < argsn; ++i)
+    {
+        std::string arg(args[i] + 1);
+        std::transform(arg.begin(), arg.end(), arg.begin(), ::tolower);
+
+        if(i + 1 >= argsn)
+            WrongUsage("value expected - " + arg);
+
+        if(arg == "s" || arg == "source")
+            source = args[++i];
+        else if(arg == "t" || arg == "target")
+            target = args[++i];
+        else
+            UnknownArgument(arg);
+    }
+
+    if(source.empty())
+        WrongUsage("source key is required");
+
+    if(target.empty())
+        target = miopen::GetDbBinaryPath(source);
+
+    std::ifstream sourceFile(source, std::ios::in | std::ios::binary);
+
+    if(!sourceFile.good())
+    {
+        std::cerr << "File not found: " << source << std::endl;
+        return 1;
+    }
+
+    // Write to a temporary file first so an interrupted build never leaves a truncated db.
+    const auto temp = target + ".tmp";
+    std::ofstream targetFile(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+    const auto records = miopen::CompileDb(sourceFile, targetFile);
+    targetFile.close();
+
+    if(!targetFile.good() || std::rename(temp.c_str(), target.c_str()) != 0)
+    {
+        std::cerr << "Unable to write: " << target << std::endl;
+        std::remove(temp.c_str());
+        return 1;
+    }
+
+    std::cout << "Compiled " << records << " records: " << source << " -> " << target
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/binary_cache.hpp>
+#include <miopen/db.hpp>
+#include <miopen/packed_cache.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using Records = std::vector<std::pair<std::string, std::string>>;
+
+Records ReadRecords(const std::string& path)
+{
+    if(!boost::filesystem::exists(path))
+    {
+        std::cerr << "File not found: " << path << std::endl;
+        std::exit(1);
+    }
+
+    Records records;
+    miopen::PackedCache cache(path);
+    cache.Visit([&](const std::string& key, const char* blob, std::size_t size) {
+        records.emplace_back(key, std::string(blob, size));
+    });
+    std::sort(records.begin(), records.end());
+    return records;
+}
+
+int List(const std::string& path)
+{
+    const auto records = ReadRecords(path);
+    std::size_t total  = 0;
+
+    for(const auto& record : records)
+    {
+        std::cout << record.second.size() << '\t' << record.first << std::endl;
+        total += record.second.size();
+    }
+
+    std::cout << "Programs: " << records.size() << ", bytes: " << total
+              << ", file size: " << boost::filesystem::file_size(path) << std::endl;
+    return 0;
+}
+
+/// Writes actual records only, replacing the target file atomically.
+int Export(const std::string& path, const std::string& target)
+{
+    const auto records   = ReadRecords(path);
+    const auto temp_path = target + ".kcache-tool.tmp";
+    std::remove(temp_path.c_str());
+
+    if(miopen::PackedCache(temp_path).Store(records) < 0)
+    {
+        std::cerr << "Unable to write: " << temp_path << std::endl;
+        std::remove(temp_path.c_str());
+        return 1;
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(temp_path, target, ec);
+    std::remove(miopen::LockFilePath(temp_path).c_str());
+
+    if(ec)
+    {
+        std::cerr << "Unable to replace " << target << ": " << ec.message() << std::endl;
+        std::remove(temp_path.c_str());
+        return 1;
+    }
+
+    std::cout << "Exported " << records.size() << " programs to " << target << std::endl;
+    return 0;
+}
+
+int Import(const std::string& path, const std::string& target)
+{
+    const auto records  = ReadRecords(path);
+    const auto appended = miopen::PackedCache(target).Store(records);
+
+    if(appended < 0)
+    {
+        std::cerr << "Unable to write: " << target << std::endl;
+        return 1;
+    }
+
+    std::cout << "Imported " << appended << " of " << records.size() << " programs to " << target
+              << std::endl;
+    return 0;
+}
+
+void PrintHelp()
+{
+    std::cout << "Usage: kcache-tool <command> {<argument>}" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Commands:" << std::endl;
+    std::cout << "  list <cache>: prints size and key of each program in a packed kernel cache."
+              << std::endl;
+    std::cout << "  export <cache> <target>: writes the programs to target, dropping overridden "
+                 "and corrupted ones."
+              << std::endl;
+    std::cout << "  import <cache> [<target>]: appends the programs missing in target (default: "
+                 "the file with the same name in the user kernel cache directory)."
+              << std::endl;
+    std::cout << std::endl;
+    std::cout << "Kernel cache directory: " << miopen::GetCachePath().string() << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::vector<std::string> args(argv + 1, argv + argc);
+
+    if(args.empty())
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    const auto& command = args[0];
+
+    if(command == "list" && args.size() == 2)
+        return List(args[1]);
+    if(command == "export" && args.size() == 3)
+        return Export(args[1], args[2]);
+    if(command == "import" && args.size() == 2)
+        return Import(
+            args[1],
+            (miopen::GetCachePath() / boost::filesystem::path(args[1]).filename()).string());
+    if(command == "import" && args.size() == 3)
+        return Import(args[1], args[2]);
+
+    PrintHelp();
+    return 2;
+}
@@ -36,6 +36,7 @@
 #include "pool_driver.hpp"
 #include "softmax_driver.hpp"
 #include "rnn_driver.hpp"
+#include "warmup_driver.hpp"
 #include "miopen/config.h"
 
 int main(int argc, char* argv[])
@@ -128,6 +129,10 @@ int main(int argc, char* argv[])
     {
         drv = new RNNDriver<float16, double>();
     }
+    else if(base_arg == "warmup")
+    {
+        drv = new WarmUpDriver();
+    }
     else
     {
         printf("Incorrect BaseArg\n");
@@ -0,0 +1,405 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db.hpp>
+#include <miopen/db_index.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/solver.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+/// Gives access to VALUES as is.
+struct RawValues
+{
+    std::string values;
+
+    bool Deserialize(const std::string& s)
+    {
+        values = s;
+        return true;
+    }
+    void Serialize(std::ostream& s) const { s << values; }
+};
+
+struct RawKey
+{
+    std::string key;
+
+    void Serialize(std::ostream& s) const { s << key; }
+};
+
+using Validators = std::unordered_map<std::string, std::function<bool(const std::string&)>>;
+
+template <class Solver>
+void AddValidator(Validators& validators)
+{
+    using PerformanceConfig =
+        decltype(Solver{}.GetPerformanceConfig(std::declval<const miopen::ConvolutionContext&>()));
+
+    validators[miopen::solver::SolverDbId(Solver{})] = [](const std::string& values) {
+        PerformanceConfig config{};
+        return config.Deserialize(values);
+    };
+}
+
+/// VALUES of a record are valid if a tunable solver with the ID is able to deserialize those.
+const Validators& GetValidators()
+{
+    static const auto validators = [] {
+        using namespace miopen::solver;
+        Validators v;
+        AddValidator<ConvAsm3x3U>(v);
+        AddValidator<ConvAsm1x1U>(v);
+        AddValidator<ConvBiasActivAsm1x1U>(v);
+        AddValidator<ConvOclDirectFwd>(v);
+        AddValidator<ConvOclDirectFwdFused>(v);
+        AddValidator<ConvOclDirectFwd1x1>(v);
+        AddValidator<ConvAsmBwdWrW3x3>(v);
+        AddValidator<ConvAsmBwdWrW1x1>(v);
+        AddValidator<ConvOclBwdWrW2<1>>(v);
+        AddValidator<ConvOclBwdWrW2<2>>(v);
+        AddValidator<ConvOclBwdWrW2<4>>(v);
+        AddValidator<ConvOclBwdWrW2<8>>(v);
+        AddValidator<ConvOclBwdWrW2<16>>(v);
+        return v;
+    }();
+    return validators;
+}
+
+bool IsValid(const std::string& id, const std::string& values)
+{
+    const auto& validators = GetValidators();
+    const auto validator   = validators.find(id);
+    return validator != validators.end() && validator->second(values);
+}
+
+/// User dbs are named "*.updb.txt" by MIOpen, see GetUserPerfDbPath(). Whether there is a
+/// journal tells nothing: there is none right after a user db has been compacted.
+bool IsUserDb(const std::string& path)
+{
+    const std::string suffix = ".updb.txt";
+    return path.size() >= suffix.size() &&
+           path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/// A user db may consist of the journal only.
+bool Exists(const std::string& path)
+{
+    return boost::filesystem::exists(path) ||
+           (IsUserDb(path) && boost::filesystem::exists(miopen::DbJournal::GetPath(path)));
+}
+
+std::vector<miopen::DbRecord> ReadRecords(const std::string& path)
+{
+    if(!Exists(path))
+    {
+        std::cerr << "File not found: " << path << std::endl;
+        std::exit(1);
+    }
+
+    return miopen::Db(path, !IsUserDb(path)).GetAllRecords();
+}
+
+/// Drops invalid VALUES and records which become empty.
+std::vector<miopen::DbRecord> Validate(const std::vector<miopen::DbRecord>& records,
+                                       std::size_t& dropped)
+{
+    std::vector<miopen::DbRecord> valid;
+    dropped = 0;
+
+    for(const auto& record : records)
+    {
+        miopen::DbRecord copy(RawKey{record.GetKey()});
+
+        for(const auto& pair : record.As<RawValues>())
+        {
+            if(IsValid(pair.first, pair.second.values))
+                copy.SetValues(pair.first, pair.second);
+            else
+                ++dropped;
+        }
+
+        if(copy.As<RawValues>().begin() != copy.As<RawValues>().end())
+            valid.push_back(copy);
+    }
+
+    return valid;
+}
+
+/// Replaces the db and its journal by the records edit() makes out of the actual ones, under
+/// the lock of the db, so records appended by running MIOpen processes are not lost.
+bool Rewrite(const std::string& path,
+             const std::function<void(std::vector<miopen::DbRecord>&)>& edit)
+{
+    std::size_t written = 0;
+    const auto ok = miopen::Db(path, !IsUserDb(path)).Rewrite([&](auto& records) {
+        edit(records);
+        written = records.size();
+    });
+
+    if(!ok)
+    {
+        std::cerr << "Unable to replace " << path << std::endl;
+        return false;
+    }
+
+    std::cout << "Written " << written << " records to " << path << std::endl;
+    return true;
+}
+
+/// Writes records sorted by KEY, replacing the target file atomically.
+bool Write(const std::vector<miopen::DbRecord>& records, const std::string& path)
+{
+    return Rewrite(path, [&](auto& all) { all = records; });
+}
+
+struct LineStats
+{
+    std::size_t lines      = 0;
+    std::size_t malformed  = 0;
+    std::size_t duplicates = 0;
+};
+
+LineStats ScanLines(const std::string& path)
+{
+    LineStats stats;
+    std::set<std::string> keys;
+    std::ifstream file(path);
+    std::string line;
+
+    while(std::getline(file, line))
+    {
+        ++stats.lines;
+        if(line.empty())
+            continue;
+
+        const auto eq = line.find('=');
+        if(eq == std::string::npos || eq == 0 || eq + 1 == line.size())
+        {
+            ++stats.malformed;
+            continue;
+        }
+
+        std::size_t begin = eq + 1;
+        do
+        {
+            const auto end = std::min(line.find(';', begin), line.size());
+            const auto colon = line.find(':', begin);
+            if(colon == std::string::npos || colon == begin || colon > end)
+            {
+                ++stats.malformed;
+                break;
+            }
+            begin = end + 1;
+        } while(begin < line.size());
+
+        if(!keys.insert(line.substr(0, eq)).second)
+            ++stats.duplicates;
+    }
+
+    return stats;
+}
+
+void PrintFileStats(const std::string& path)
+{
+    if(!boost::filesystem::exists(path))
+        return;
+
+    const auto stats = ScanLines(path);
+    std::cout << path << ":" << std::endl;
+    std::cout << "  size:           " << boost::filesystem::file_size(path) << std::endl;
+    std::cout << "  lines:          " << stats.lines << std::endl;
+    std::cout << "  malformed:      " << stats.malformed << std::endl;
+    std::cout << "  duplicate keys: " << stats.duplicates << std::endl;
+}
+
+int Stat(const std::string& path)
+{
+    PrintFileStats(path);
+    PrintFileStats(miopen::DbJournal::GetPath(path));
+
+    const auto records = ReadRecords(path);
+    std::map<std::string, std::pair<std::size_t, std::size_t>> solvers;
+
+    for(const auto& record : records)
+    {
+        for(const auto& pair : record.As<RawValues>())
+        {
+            auto& counts = solvers[pair.first];
+            ++counts.first;
+            if(!IsValid(pair.first, pair.second.values))
+                ++counts.second;
+        }
+    }
+
+    std::cout << "Records: " << records.size() << std::endl;
+    std::cout << std::left << std::setw(40) << "Solver" << std::setw(10) << "Count"
+              << "Invalid" << std::endl;
+
+    for(const auto& solver : solvers)
+        std::cout << std::left << std::setw(40) << solver.first << std::setw(10)
+                  << solver.second.first << solver.second.second << std::endl;
+
+    return 0;
+}
+
+int Compact(const std::string& path, const std::string& target, bool keep_invalid)
+{
+    if(!Exists(path))
+    {
+        std::cerr << "File not found: " << path << std::endl;
+        return 1;
+    }
+
+    std::size_t dropped = 0;
+    const auto validate = [&](std::vector<miopen::DbRecord>& records) {
+        if(!keep_invalid)
+            records = Validate(records, dropped);
+    };
+
+    if(target == path)
+    {
+        // Read under the same lock, the journal is applied and removed.
+        if(!Rewrite(path, validate))
+            return 1;
+    }
+    else
+    {
+        auto records = ReadRecords(path);
+        validate(records);
+        if(!Write(records, target))
+            return 1;
+    }
+
+    std::cout << "Dropped invalid values: " << dropped << std::endl;
+    return 0;
+}
+
+int Merge(const std::string& user_path,
+          const std::string& installed_path,
+          const std::string& target,
+          bool keep_invalid)
+{
+    const auto user_records = ReadRecords(user_path);
+    auto records            = ReadRecords(installed_path);
+
+    std::map<std::string, std::size_t> positions;
+    for(std::size_t i = 0; i < records.size(); ++i)
+        positions.emplace(records[i].GetKey(), i);
+
+    // Values of the user db take precedence.
+    for(auto record : user_records)
+    {
+        const auto it = positions.find(record.GetKey());
+        if(it == positions.end())
+        {
+            records.push_back(record);
+            continue;
+        }
+
+        record.Merge(records[it->second]);
+        records[it->second] = record;
+    }
+
+    std::size_t dropped = 0;
+    if(!keep_invalid)
+        records = Validate(records, dropped);
+
+    std::cout << "Merged " << user_records.size() << " user records, dropped invalid values: "
+              << dropped << std::endl;
+
+    return Write(records, target) ? 0 : 1;
+}
+
+void PrintHelp()
+{
+    std::cout << "Usage: pdb-tool <command> {<argument>} [--keep-invalid]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Commands:" << std::endl;
+    std::cout << "  stat <db>: prints file size, malformed lines, duplicate keys and record counts "
+                 "per solver."
+              << std::endl;
+    std::cout << "  compact <db> [<target>]: applies journal, removes duplicate keys and invalid "
+                 "values, sorts records and writes those to target (default: db itself)."
+              << std::endl;
+    std::cout << "  merge <user db> <installed db> <target>: writes records of both dbs to target "
+                 "in the installed format, values of the user db take precedence."
+              << std::endl;
+    std::cout << std::endl;
+    std::cout << "Values are invalid if there is no tunable solver with the ID able to "
+                 "deserialize those; --keep-invalid retains them."
+              << std::endl;
+    std::cout << "Dbs named *.updb.txt are user dbs: their journals are applied and replaced "
+                 "as well."
+              << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> args;
+    bool keep_invalid = false;
+
+    for(int i = 1; i < argc; ++i)
+    {
+        const std::string arg = argv[i];
+        if(arg == "--keep-invalid")
+            keep_invalid = true;
+        else
+            args.push_back(arg);
+    }
+
+    if(args.empty())
+    {
+        PrintHelp();
+        return 2;
+    }
+
+    const auto& command = args[0];
+
+    if(command == "stat" && args.size() == 2)
+        return Stat(args[1]);
+    if(command == "compact" && (args.size() == 2 || args.size() == 3))
+        return Compact(args[1], args.back(), keep_invalid);
+    if(command == "merge" && args.size() == 4)
+        return Merge(args[1], args[2], args[3], keep_invalid);
+
+    PrintHelp();
+    return 2;
+}
@@ -0,0 +1,94 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_WARMUP_DRIVER_HPP
+#define GUARD_MIOPEN_WARMUP_DRIVER_HPP
+
+#include "InputFlags.hpp"
+#include "driver.hpp"
+#include <chrono>
+#include <cstdio>
+#include <miopen/miopen.h>
+#include <string>
+
+class WarmUpDriver : public Driver
+{
+    public:
+    WarmUpDriver() : Driver() {}
+
+    int AddCmdLineArgs()
+    {
+        inflags.AddInputFlag(
+            "problems", 'i', "", "File with one convolution perf-db key per line", "string");
+        inflags.AddInputFlag("forw", 'F', "1", "Build the kernels (Default=1)", "int");
+        inflags.AddInputFlag("verify", 'V', "0", "Unused (Default=0)", "int");
+        return miopenStatusSuccess;
+    }
+
+    int ParseCmdLineArgs(int argc, char* argv[])
+    {
+        inflags.Parse(argc, argv);
+        if(inflags.GetValueStr("problems").empty())
+        {
+            printf("A problems file is required (-i)\n");
+            exit(EXIT_FAILURE);
+        }
+        return miopenStatusSuccess;
+    }
+
+    InputFlags& GetInputFlags() { return inflags; }
+
+    int GetandSetData() { return miopenStatusSuccess; }
+    int AllocateBuffersAndCopy() { return miopenStatusSuccess; }
+
+    int RunForwardGPU()
+    {
+        const auto start  = std::chrono::steady_clock::now();
+        size_t built      = 0;
+        size_t failed     = 0;
+        const auto status = miopenWarmUpConvolutions(
+            GetHandle(), inflags.GetValueStr("problems").c_str(), &built, &failed);
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+
+        printf("Programs built: %zu, failed: %zu\n", built, failed);
+        if(status != miopenStatusSuccess)
+        {
+            printf("Warm-up failed\n");
+            exit(EXIT_FAILURE);
+        }
+        printf("Warm-up done in %lld ms\n", static_cast<long long>(elapsed.count()));
+        return miopenStatusSuccess;
+    }
+
+    int VerifyForward() { return miopenStatusSuccess; }
+    int RunBackwardGPU() { return miopenStatusSuccess; }
+    int VerifyBackward() { return miopenStatusSuccess; }
+
+    private:
+    InputFlags inflags;
+};
+
+#endif // GUARD_MIOPEN_WARMUP_DRIVER_HPP
@@ -1244,6 +1244,24 @@ MIOPEN_EXPORT miopenStatus_t miopenConvolutionBackwardBias(miopenHandle_t handle
                                                            const miopenTensorDescriptor_t dbDesc,
                                                            void* db);
 
+/*! @brief Builds the kernels of a list of convolution problems ahead of time.
+ *
+ * Reads the problems from a file with one perf-db key per line (the part after '=' and lines
+ * starting with '#' are ignored), finds their solutions through the perf-db without running any
+ * search, and builds all the kernels in parallel into the binary cache. No tensors are allocated.
+ *
+ * @param handle         MIOpen handle (input)
+ * @param problemsFile   Path to the file with the problem descriptions (input)
+ * @param builtPrograms  Number of programs built or loaded from the binary cache, may be NULL
+ * (output)
+ * @param failedPrograms Number of programs which failed to build, may be NULL (output)
+ * @return               miopenStatus_t, miopenStatusUnknownError if any program failed to build
+ */
+MIOPEN_EXPORT miopenStatus_t miopenWarmUpConvolutions(miopenHandle_t handle,
+                                                      const char* problemsFile,
+                                                      size_t* builtPrograms,
+                                                      size_t* failedPrograms);
+
 /** @} */
 // CLOSEOUT CONVOLUTIONS DOXYGEN GROUP
 
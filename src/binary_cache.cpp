@@ -27,18 +27,24 @@
 #include <miopen/binary_cache.hpp>
 #include <miopen/md5.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/fast_hash.hpp>
 #include <miopen/env.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/expanduser.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/packed_cache.hpp>
 #include <miopen/miopen.h>
 #include <miopen/version.h>
 #include <boost/filesystem.hpp>
+#include <cctype>
 #include <fstream>
 #include <iostream>
 
 namespace miopen {
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DISABLE_CACHE)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_CACHE_SIZE_LIMIT_MB)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_LOG_CACHE_STATS)
 
 boost::filesystem::path ComputeCachePath()
 {
@@ -82,6 +88,49 @@ boost::filesystem::path GetCacheFile(const std::string& device,
     return GetCachePath() / miopen::md5(device + ":" + args) / filename;
 }
 
+boost::filesystem::path GetPackedCacheFile(const std::string& device)
+{
+    auto filename = device;
+    for(auto& c : filename)
+    {
+        if(std::isalnum(static_cast<unsigned char>(c)) == 0 && c != '-' && c != '.')
+            c = '_';
+    }
+    return GetCachePath() / (filename + ".kdb");
+}
+
+static PackedCache& GetPackedCache(const std::string& device)
+{
+    static const auto limit = Value(MIOPEN_CACHE_SIZE_LIMIT_MB{}) * 1024 * 1024;
+    auto& cache             = PackedCache::Get(GetPackedCacheFile(device).string());
+    cache.SetSizeLimit(limit);
+    return cache;
+}
+
+/// Options and kernel sources run to kilobytes, so KEYs hold their hashes instead.
+static std::string
+GetCacheKey(const std::string& name, const std::string& args, bool is_kernel_str)
+{
+    return (is_kernel_str ? FastHashHex(name) : name) + ":" + FastHashHex(args);
+}
+
+/// Whether the cache directory holds any of the per-file caches (a subdirectory per md5 of
+/// the device and options) left from before the packed cache. Checked once per process.
+static bool HasLegacyCache()
+{
+    static const bool has_legacy = [] {
+        boost::system::error_code ec;
+        for(boost::filesystem::directory_iterator it(GetCachePath(), ec), end; !ec && it != end;
+            it.increment(ec))
+        {
+            if(boost::filesystem::is_directory(it->path(), ec))
+                return true;
+        }
+        return false;
+    }();
+    return has_legacy;
+}
+
 std::string LoadBinary(const std::string& device,
                        const std::string& name,
                        const std::string& args,
@@ -89,32 +138,85 @@ std::string LoadBinary(const std::string& device,
 {
     if(miopen::IsCacheDisabled())
         return {};
-    auto f = GetCacheFile(device, name, args, is_kernel_str);
-    if(boost::filesystem::exists(f))
-    {
-        return f.string();
-    }
-    else
-    {
+
+    auto& cache    = GetPackedCache(device);
+    const auto key = GetCacheKey(name, args, is_kernel_str);
+    auto binary    = cache.Load(key);
+    if(!binary.empty())
+        return binary;
+
+    // Programs cached one per file are moved to the packed cache on first use. Such a
+    // cache is either there at startup or never, so misses skip it once it is known to be
+    // absent instead of hashing the names with md5 and probing the file system each time.
+    if(!HasLegacyCache())
+        return {};
+    const auto legacy_file = GetCacheFile(device, name, args, is_kernel_str);
+    if(!boost::filesystem::exists(legacy_file))
         return {};
+
+    binary = miopen::LoadFile(legacy_file.string());
+    if(cache.Store(key, binary))
+    {
+        boost::system::error_code ec;
+        boost::filesystem::remove(legacy_file, ec);
+        boost::filesystem::remove(legacy_file.parent_path(), ec); // Only if empty.
     }
+    return binary;
 }
-void SaveBinary(const boost::filesystem::path& binary_path,
+
+void SaveBinary(const std::string& binary,
                 const std::string& device,
                 const std::string& name,
                 const std::string& args,
                 bool is_kernel_str)
 {
     if(miopen::IsCacheDisabled())
-    {
-        boost::filesystem::remove(binary_path);
-    }
-    else
-    {
-        auto p = GetCacheFile(device, name, args, is_kernel_str);
-        boost::filesystem::create_directories(p.parent_path());
-        boost::filesystem::rename(binary_path, p);
-    }
+        return;
+
+    GetPackedCache(device).Store(GetCacheKey(name, args, is_kernel_str), binary);
+}
+
+static double ElapsedMs(BinaryCacheCounters::Clock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(BinaryCacheCounters::Clock::now() - start)
+        .count();
+}
+
+void BinaryCacheCounters::AddHit(Clock::time_point start)
+{
+    const auto elapsed = ElapsedMs(start);
+    std::lock_guard<std::mutex> lock(mutex);
+    ++stats.hits;
+    stats.load_time += elapsed;
+}
+
+void BinaryCacheCounters::AddMiss(Clock::time_point start)
+{
+    const auto elapsed = ElapsedMs(start);
+    std::lock_guard<std::mutex> lock(mutex);
+    ++stats.misses;
+    stats.compile_time += elapsed;
+}
+
+BinaryCacheStats BinaryCacheCounters::Get() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+std::ostream& operator<<(std::ostream& os, const BinaryCacheStats& stats)
+{
+    return os << "hits: " << stats.hits << " (" << stats.load_time << " ms), misses: "
+              << stats.misses << " (" << stats.compile_time << " ms compiling)";
+}
+
+void LogBinaryCacheStats(const BinaryCacheStats& stats)
+{
+    if(!miopen::IsEnabled(MIOPEN_LOG_CACHE_STATS{}))
+        return;
+    if(stats.hits == 0 && stats.misses == 0)
+        return;
+    std::cerr << "MIOpen binary cache " << stats << std::endl;
 }
 
 } // namespace miopen
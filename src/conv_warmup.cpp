@@ -0,0 +1,275 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv_warmup.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <set>
+#include <sstream>
+#include <utility>
+
+namespace miopen {
+
+static int ParseInt(const std::string& s)
+{
+    char* end    = nullptr;
+    const auto v = std::strtol(s.c_str(), &end, 10);
+    if(s.empty() || *end != '\0' || v < 0 || v > std::numeric_limits<int>::max())
+        MIOPEN_THROW(miopenStatusBadParm, "Not a number: " + s);
+    return static_cast<int>(v);
+}
+
+static std::pair<int, int> ParsePair(const std::string& s)
+{
+    const auto x = s.find('x');
+    if(x == std::string::npos)
+        MIOPEN_THROW(miopenStatusBadParm, "Not a pair: " + s);
+    return {ParseInt(s.substr(0, x)), ParseInt(s.substr(x + 1))};
+}
+
+/// Parses one or three concatenated data type names, see EncodeDataTypesForKey().
+static std::vector<miopenDataType_t> ParseDataTypes(const std::string& s)
+{
+    // Longer names go first, so that INT8 does not match a prefix of INT8x4.
+    static const miopenDataType_t types[] = {
+        miopenInt8x4, miopenInt32, miopenInt8, miopenFloat, miopenHalf};
+
+    std::vector<miopenDataType_t> result;
+    for(std::size_t pos = 0; pos < s.size();)
+    {
+        const auto found = std::find_if(std::begin(types), std::end(types), [&](auto type) {
+            return s.compare(pos, GetDataTypeName(type).size(), GetDataTypeName(type)) == 0;
+        });
+        if(found == std::end(types))
+            MIOPEN_THROW(miopenStatusBadParm, "Unknown data type: " + s);
+        result.push_back(*found);
+        pos += GetDataTypeName(*found).size();
+    }
+
+    if(result.size() == 1)
+        result.resize(3, result.front());
+    if(result.size() != 3)
+        MIOPEN_THROW(miopenStatusBadParm, "Unknown data types: " + s);
+    return result;
+}
+
+ConvolutionProblem ConvolutionProblem::Parse(const std::string& key)
+{
+    // 576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F[_g2]
+    const auto optional_pos = key.find('_');
+    std::vector<std::string> fields;
+    {
+        std::istringstream ss(key.substr(0, optional_pos));
+        std::string field;
+        while(std::getline(ss, field, '-'))
+            fields.push_back(field);
+    }
+
+    if(fields.size() != 15)
+        MIOPEN_THROW(miopenStatusBadParm, "Malformed problem: " + key);
+
+    int group_count = 1;
+    if(optional_pos != std::string::npos)
+    {
+        const auto optional = key.substr(optional_pos + 1);
+        if(optional.empty() || optional[0] != 'g')
+            MIOPEN_THROW(miopenStatusBadParm, "Malformed problem: " + key);
+        group_count = ParseInt(optional.substr(1));
+    }
+
+    const auto n_inputs   = ParseInt(fields[0]);
+    const auto in_height  = ParseInt(fields[1]);
+    const auto in_width   = ParseInt(fields[2]);
+    const auto kernel     = ParsePair(fields[3]);
+    const auto n_outputs  = ParseInt(fields[4]);
+    const auto out_height = ParseInt(fields[5]);
+    const auto out_width  = ParseInt(fields[6]);
+    const auto batch      = ParseInt(fields[7]);
+    const auto pad        = ParsePair(fields[8]);
+    const auto stride     = ParsePair(fields[9]);
+    const auto dilation   = ParsePair(fields[10]);
+    const auto types      = ParseDataTypes(fields[13]);
+
+    if(fields[12] != "NCHW" || fields[14].size() != 1 || group_count < 1)
+        MIOPEN_THROW(miopenStatusBadParm, "Unsupported problem: " + key);
+
+    ProblemDescription::Direction direction;
+    switch(fields[14][0])
+    {
+    case 'F': direction.Set(1); break;
+    case 'B': direction.Set(0); break;
+    case 'W': direction.SetBackwardWrW(); break;
+    default: MIOPEN_THROW(miopenStatusBadParm, "Unknown direction: " + key);
+    }
+
+    // In backward directions, inputs of the problem are outputs of the convolution.
+    const auto forward = direction.IsForward();
+    const auto c       = forward ? n_inputs : n_outputs;
+    const auto k       = forward ? n_outputs : n_inputs;
+    const auto x_type  = forward ? types[0] : types[2];
+    const auto y_type  = forward ? types[2] : types[0];
+
+    if(c % group_count != 0)
+        MIOPEN_THROW(miopenStatusBadParm, "Invalid group count: " + key);
+
+    return {
+        TensorDescriptor(x_type,
+                         {static_cast<std::size_t>(batch),
+                          static_cast<std::size_t>(c),
+                          static_cast<std::size_t>(forward ? in_height : out_height),
+                          static_cast<std::size_t>(forward ? in_width : out_width)}),
+        TensorDescriptor(types[1],
+                         {static_cast<std::size_t>(k),
+                          static_cast<std::size_t>(c / group_count),
+                          static_cast<std::size_t>(kernel.first),
+                          static_cast<std::size_t>(kernel.second)}),
+        TensorDescriptor(y_type,
+                         {static_cast<std::size_t>(batch),
+                          static_cast<std::size_t>(k),
+                          static_cast<std::size_t>(forward ? out_height : in_height),
+                          static_cast<std::size_t>(forward ? out_width : in_width)}),
+        ConvolutionDescriptor({pad.first, pad.second},
+                              {stride.first, stride.second},
+                              {dilation.first, dilation.second},
+                              {0, 0},
+                              group_count),
+        direction};
+}
+
+std::vector<ConvolutionProblem> ReadConvolutionProblems(const std::string& filename)
+{
+    std::ifstream file(filename);
+    if(!file)
+        MIOPEN_THROW(miopenStatusBadParm, "Unable to read: " + filename);
+
+    std::vector<ConvolutionProblem> problems;
+    std::string line;
+    for(auto n_line = 1; std::getline(file, line); ++n_line)
+    {
+        const auto key = line.substr(0, line.find('='));
+        if(key.empty() || key[0] == '#')
+            continue;
+
+        try
+        {
+            problems.push_back(ConvolutionProblem::Parse(key));
+        }
+        catch(const Exception&)
+        {
+            MIOPEN_LOG_E("Malformed problem: " << filename << "#" << n_line);
+            throw;
+        }
+    }
+    return problems;
+}
+
+/// Returns solutions Find would evaluate without exhaustive search.
+static std::vector<solver::ConvSolution> GetSolutions(Handle& handle,
+                                                      const ConvolutionProblem& problem)
+{
+    std::vector<solver::ConvSolution> solutions;
+    const auto& conv = problem.conv;
+
+    if(problem.direction.IsBackwardWrW())
+    {
+        mlo_construct_BwdWrW2D direct(problem.x, problem.w, problem.y, conv, 0);
+        direct.setDoSearch(false);
+        direct.setStream(&handle);
+        solutions = FindAllSolutions(direct);
+
+        mlo_construct_winograd_wrw winograd(problem.x, problem.w, problem.y, conv, 0);
+        winograd.setStream(&handle);
+        const auto solution = FindFirstSolution(winograd);
+        if(solution.Succeeded())
+            solutions.push_back(solution);
+    }
+    else
+    {
+        const auto dir = problem.direction.IsForward() ? 1 : 0;
+        std::string network_config;
+        ExtraKernelArgs eka;
+        solutions = conv.FindDataDirectSolutions(
+            handle, problem.x, problem.w, problem.y, false, dir == 1, network_config, eka);
+
+        mlo_construct_winograd winograd(problem.x, problem.w, problem.y, conv, dir);
+        winograd.setStream(&handle);
+        const auto solution = FindFirstSolution(winograd);
+        if(solution.Succeeded())
+            solutions.push_back(solution);
+    }
+
+    return solutions;
+}
+
+WarmUpStats WarmUpConvolutions(Handle& handle, const std::vector<ConvolutionProblem>& problems)
+{
+    WarmUpStats stats;
+    std::set<std::pair<std::string, std::string>> programs;
+
+    for(const auto& problem : problems)
+    {
+        std::vector<solver::ConvSolution> solutions;
+        try
+        {
+            solutions = GetSolutions(handle, problem);
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_W("Unable to find solutions: " << ex.what());
+        }
+
+        if(solutions.empty())
+            continue;
+        ++stats.problems;
+
+        for(const auto& solution : solutions)
+        {
+            for(const auto& k : solution.construction_params)
+            {
+                if(programs.emplace(k.kernel_file, k.comp_options).second)
+                    handle.BuildProgramAsync(k.kernel_file, k.comp_options);
+            }
+        }
+    }
+
+    stats.programs = programs.size();
+    stats.failed   = handle.FinishBuilds();
+    MIOPEN_LOG_I("Warmed up " << stats.problems << " of " << problems.size() << " problems, "
+                              << stats.programs
+                              << " programs, failed: "
+                              << stats.failed);
+    return stats;
+}
+
+} // namespace miopen
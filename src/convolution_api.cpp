@@ -23,6 +23,7 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <miopen/conv_warmup.hpp>
 #include <miopen/convolution.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
@@ -822,3 +823,23 @@ extern "C" miopenStatus_t miopenConvolutionBackwardBias(miopenHandle_t handle,
                                 DataCast(db));
     });
 }
+
+extern "C" miopenStatus_t miopenWarmUpConvolutions(miopenHandle_t handle,
+                                                   const char* problemsFile,
+                                                   size_t* builtPrograms,
+                                                   size_t* failedPrograms)
+{
+    MIOPEN_LOG_FUNCTION(problemsFile, builtPrograms, failedPrograms);
+    return miopen::try_([&] {
+        const auto stats = miopen::WarmUpConvolutions(
+            miopen::deref(handle), miopen::ReadConvolutionProblems(problemsFile));
+        if(builtPrograms != nullptr)
+            *builtPrograms = stats.programs - stats.failed;
+        if(failedPrograms != nullptr)
+            *failedPrograms = stats.failed;
+        // The cache is still cold for the failed ones, which shall not go unnoticed.
+        if(stats.failed > 0)
+            MIOPEN_THROW(miopenStatusUnknownError,
+                         std::to_string(stats.failed) + " programs failed to build");
+    });
+}
@@ -24,6 +24,8 @@
  *
  *******************************************************************************/
 #include <miopen/db.hpp>
+#include <miopen/db_cache.hpp>
+#include <miopen/db_index.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
@@ -39,12 +41,17 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <fstream>
 #include <ios>
+#include <map>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <utility>
+#include <vector>
 #include "include/miopen/db.hpp"
 
 namespace miopen {
@@ -73,7 +80,8 @@ std::string LockFilePath(const boost::filesystem::path& filename_)
 Db::Db(const std::string& filename_, bool is_system)
     : filename(filename_),
       lock_file(LockFile::Get(LockFilePath(filename_).c_str())),
-      warn_if_unreadable(is_system)
+      is_system(is_system),
+      journal_filename(is_system ? "" : DbJournal::GetPath(filename_))
 {
     if(!is_system)
     {
@@ -98,6 +106,7 @@ Db::Db(const std::string& filename_, bool is_system)
     } while(false)
 
 static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
+static std::uintmax_t GetMinJournalSizeToCompact() { return 1024 * 1024; }
 
 using exclusive_lock = std::unique_lock<LockFile>;
 using shared_lock    = std::shared_lock<LockFile>;
@@ -123,6 +132,65 @@ bool Db::UpdateRecord(DbRecord& record)
     return UpdateRecordUnsafe(record);
 }
 
+bool Db::StoreRecords(const std::vector<DbRecord>& records)
+{
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+
+    std::map<std::string, const DbRecord*> last;
+    for(const auto& record : records)
+        last[record.key] = &record;
+
+    std::vector<const DbRecord*> flushed;
+    flushed.reserve(last.size());
+    for(const auto& record : last)
+        flushed.push_back(record.second);
+
+    MIOPEN_LOG_I2("Storing " << flushed.size() << " records");
+    return FlushUnsafe(flushed);
+}
+
+bool Db::UpdateRecords(std::vector<DbRecord>& records)
+{
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+
+    std::vector<DbRecord> new_records;
+    std::map<std::string, std::size_t> last;
+    new_records.reserve(records.size());
+
+    for(const auto& record : records)
+    {
+        new_records.push_back(record);
+        auto& new_record = new_records.back();
+        const auto it    = last.find(record.key);
+
+        if(it != last.end())
+        {
+            new_record.Merge(new_records[it->second]);
+            it->second = new_records.size() - 1;
+            continue;
+        }
+
+        RecordPositions pos;
+        const auto old_record = FindRecordUnsafe(record.key, &pos);
+        if(old_record)
+            new_record.Merge(*old_record);
+        last.emplace(record.key, new_records.size() - 1);
+    }
+
+    std::vector<const DbRecord*> flushed;
+    flushed.reserve(last.size());
+    for(const auto& record : last)
+        flushed.push_back(&new_records[record.second]);
+
+    MIOPEN_LOG_I2("Updating " << flushed.size() << " records");
+    const auto result = FlushUnsafe(flushed);
+    if(result)
+        records = std::move(new_records);
+    return result;
+}
+
 bool Db::RemoveRecord(const std::string& key)
 {
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
@@ -130,6 +198,13 @@ bool Db::RemoveRecord(const std::string& key)
     return RemoveRecordUnsafe(key);
 }
 
+bool Db::Compact()
+{
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return CompactUnsafe();
+}
+
 bool Db::Remove(const std::string& key, const std::string& id)
 {
     const auto lock = exclusive_lock(lock_file, GetLockTimeout());
@@ -153,11 +228,41 @@ boost::optional<DbRecord> Db::FindRecordUnsafe(const std::string& key, RecordPos
 
     MIOPEN_LOG_I2("Looking for key: " << key);
 
-    std::ifstream file(filename);
+    // Positions are only needed for modification, which goes through the text file.
+    if(pos == nullptr && is_system)
+    {
+        const auto binary = DbBinary::Get(filename);
+        if(binary)
+            return FindCompiledRecord(binary->View(), key);
+    }
 
-    if(!file)
+    if(!journal_filename.empty())
     {
-        if(warn_if_unreadable)
+        const auto journal = DbJournal::Get(journal_filename);
+        const auto entry   = journal ? journal->Find(key) : nullptr;
+
+        if(entry != nullptr)
+        {
+            MIOPEN_LOG_I2("Key match in journal: " << key);
+
+            if(entry->contents_size == 0)
+                return boost::none; // Removed.
+
+            DbRecord record(key);
+            if(!record.ParseContents(journal->GetContents(*entry)))
+                MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file "
+                                                                     << journal_filename
+                                                                     << "#"
+                                                                     << entry->line);
+            return record;
+        }
+    }
+
+    const auto index = DbIndex::Get(filename);
+
+    if(!index)
+    {
+        if(is_system)
             MIOPEN_LOG_W("File is unreadable: " << filename);
         else
             MIOPEN_LOG_I("File is unreadable: " << filename);
@@ -165,65 +270,72 @@ boost::optional<DbRecord> Db::FindRecordUnsafe(const std::string& key, RecordPos
         return boost::none;
     }
 
-    int n_line = 0;
-    while(true)
+    return FindIndexedRecord(*index, key, filename, pos);
+}
+
+boost::optional<DbRecord> Db::FindIndexedRecord(const DbIndex& index,
+                                                const std::string& key,
+                                                const std::string& filename,
+                                                RecordPositions* pos)
+{
+    const auto entry = index.Find(key);
+
+    if(entry == nullptr)
     {
-        std::string line;
-        const auto line_begin = file.tellg();
-        if(!std::getline(file, line))
-            break;
-        ++n_line;
-        const auto next_line_begin = file.tellg();
-
-        const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
-        if(!is_key)
-        {
-            if(!line.empty()) // Do not blame empty lines.
-            {
-                MIOPEN_LOG_E("Ill-formed record: key not found: " << filename << "#" << n_line);
-            }
-            continue;
-        }
-        const auto current_key = line.substr(0, key_size);
+        // Record was not found
+        return boost::none;
+    }
 
-        if(current_key != key)
-        {
-            continue;
-        }
-        MIOPEN_LOG_I2("Key match: " << current_key);
-        const auto contents = line.substr(key_size + 1);
+    MIOPEN_LOG_I2("Key match: " << key);
+    const auto contents = index.GetContents(*entry);
+    MIOPEN_LOG_I2("Contents found: " << contents);
 
-        if(contents.empty())
-        {
-            MIOPEN_LOG_E("None contents under the key: " << current_key << " form file " << filename
-                                                         << "#"
-                                                         << n_line);
-            continue;
-        }
-        MIOPEN_LOG_I2("Contents found: " << contents);
+    DbRecord record(key);
+    const bool is_parse_ok = record.ParseContents(contents);
 
-        DbRecord record(key);
-        const bool is_parse_ok = record.ParseContents(contents);
+    if(!is_parse_ok)
+    {
+        MIOPEN_LOG_E("Error parsing payload under the key: " << key << " form file " << filename
+                                                             << "#"
+                                                             << entry->line);
+        MIOPEN_LOG_E("Contents: " << contents);
+    }
+    // A record with matching key have been found.
+    if(pos != nullptr)
+    {
+        pos->begin = entry->begin;
+        pos->end   = entry->end;
+    }
+    return record;
+}
 
-        if(!is_parse_ok)
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: " << current_key << " form file "
-                                                                 << filename
-                                                                 << "#"
-                                                                 << n_line);
-            MIOPEN_LOG_E("Contents: " << contents);
-        }
-        // A record with matching key have been found.
-        if(pos != nullptr)
+boost::optional<DbRecord> Db::FindCompiledRecord(const DbBinaryView& view, const std::string& key)
+{
+    const auto found = view.Find(key);
+
+    if(found == nullptr)
+        return boost::none;
+
+    MIOPEN_LOG_I2("Key match (compiled): " << key);
+    DbRecord record(key);
+
+    for(std::uint32_t i = 0; i < found->n_values; ++i)
+    {
+        const auto& value  = view.GetValue(*found, i);
+        const auto& id     = view.GetId(value);
+        const auto id_str  = std::string(view.GetString(id), id.size);
+        const auto val_str = std::string(view.GetString(value.values), value.values.size);
+
+        record.map.emplace(id_str, val_str);
+
+        if(value.n_fields >= 0)
         {
-            pos->begin = line_begin;
-            pos->end   = next_line_begin;
+            const auto fields = view.GetFields(value);
+            record.SetFields(id_str, std::vector<int>(fields, fields + value.n_fields));
         }
-        return record;
     }
-    // Record was not found
-    return boost::none;
+
+    return record;
 }
 
 static void Copy(std::istream& from, std::ostream& to, std::streamoff count)
@@ -246,6 +358,12 @@ bool Db::FlushUnsafe(const DbRecord& record, const RecordPositions* pos)
 {
     assert(pos);
 
+    if(!journal_filename.empty())
+        return AppendUnsafe({&record});
+
+    // The file is about to change, so its shared view is useless from now.
+    DbIndex::Invalidate(filename);
+
     if(pos->begin < 0 || pos->end < 0)
     {
         {
@@ -301,6 +419,328 @@ bool Db::FlushUnsafe(const DbRecord& record, const RecordPositions* pos)
     return true;
 }
 
+bool Db::FlushUnsafe(const std::vector<const DbRecord*>& records)
+{
+    if(records.empty())
+        return true;
+
+    if(!journal_filename.empty())
+        return AppendUnsafe(records);
+
+    struct Replacement
+    {
+        std::size_t begin;
+        std::size_t end;
+        const DbRecord* record;
+    };
+
+    auto index = DbIndex::Get(filename);
+    std::vector<Replacement> replacements;
+    std::vector<const DbRecord*> appended;
+
+    // The file is about to change, so its shared view is useless from now.
+    DbIndex::Invalidate(filename);
+
+    for(const auto record : records)
+    {
+        const auto entry = index ? index->Find(record->key) : nullptr;
+        if(entry != nullptr)
+            replacements.push_back({entry->begin, entry->end, record});
+        else
+            appended.push_back(record);
+    }
+
+    std::sort(replacements.begin(),
+              replacements.end(),
+              [](const Replacement& lhs, const Replacement& rhs) { return lhs.begin < rhs.begin; });
+
+    const auto size         = index ? index->Size() : 0;
+    const auto unterminated = size > 0 && index->Data()[size - 1] != '\n';
+
+    if(replacements.empty())
+    {
+        {
+            std::ofstream file(filename, std::ios::app);
+
+            if(!file)
+            {
+                MIOPEN_LOG_E("File is unwritable: " << filename);
+                return false;
+            }
+
+            if(unterminated && !appended.empty())
+                file << std::endl;
+            for(const auto record : appended)
+                record->WriteContents(file);
+        }
+
+        boost::filesystem::permissions(filename, boost::filesystem::all_all);
+        return true;
+    }
+
+    const auto temp_name = filename + ".temp";
+
+    {
+        std::ofstream to(temp_name);
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+
+        const auto data   = index->Data();
+        std::size_t begin = 0;
+
+        for(const auto& replacement : replacements)
+        {
+            to.write(data + begin, replacement.begin - begin);
+            replacement.record->WriteContents(to);
+            begin = replacement.end;
+        }
+
+        to.write(data + begin, size - begin);
+        if(unterminated && begin < size && !appended.empty())
+            to << std::endl;
+        for(const auto record : appended)
+            record->WriteContents(to);
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Unable to write: " << temp_name);
+            to.close();
+            std::remove(temp_name.c_str());
+            return false;
+        }
+    }
+
+    index.reset();
+
+    boost::system::error_code ec;
+    boost::filesystem::rename(temp_name, filename, ec);
+
+    if(ec)
+    {
+        MIOPEN_LOG_E("Unable to replace " << filename << ": " << ec.message());
+        std::remove(temp_name.c_str());
+        return false;
+    }
+
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
+    return true;
+}
+
+bool Db::AppendUnsafe(const std::vector<const DbRecord*>& records)
+{
+    const auto journal = DbJournal::Get(journal_filename);
+
+    // Drop the tail left by an interrupted write, so it is not glued to the new record.
+    if(journal && journal->CompleteSize() != journal->Size())
+    {
+        MIOPEN_LOG_W("Truncating incomplete record: " << journal_filename);
+        boost::filesystem::resize_file(journal_filename, journal->CompleteSize());
+    }
+
+    {
+        std::ofstream file(journal_filename, std::ios::app);
+
+        if(!file)
+        {
+            MIOPEN_LOG_E("File is unwritable: " << journal_filename);
+            return false;
+        }
+
+        for(const auto record : records)
+        {
+            if(record->map.empty())
+                file << record->key << '=' << std::endl; // Removal mark.
+            else
+                record->WriteContents(file);
+        }
+
+        if(!file)
+        {
+            MIOPEN_LOG_E("Unable to write: " << journal_filename);
+            return false;
+        }
+    }
+
+    boost::filesystem::permissions(journal_filename, boost::filesystem::all_all);
+
+    // Compaction cost is amortized by letting the journal grow as large as the db.
+    const auto journal_size = FileStamp::Get(journal_filename).size;
+    const auto db_size      = FileStamp::Get(filename).size;
+
+    if(journal_size > std::max(db_size, GetMinJournalSizeToCompact()) && !CompactUnsafe())
+        MIOPEN_LOG_W("Journal compaction has failed: " << journal_filename);
+    return true;
+}
+
+using RecordRefs = std::map<std::string, std::pair<const DbIndex*, const DbIndex::Entry*>>;
+
+/// Returns actual records of a db and its journal, sorted by KEY.
+/// The first record wins in the db, the last one wins in the journal.
+static RecordRefs CollectRecords(const DbIndex* index, const DbIndex* journal)
+{
+    RecordRefs records;
+    const auto get_key = [](const DbIndex& view, const DbIndex::Entry& entry) {
+        return std::string(view.Data() + entry.begin, entry.key_size);
+    };
+
+    if(index != nullptr)
+        for(const auto& entry : index->Entries())
+            records.emplace(get_key(*index, entry), std::make_pair(index, &entry));
+    if(journal != nullptr)
+        for(const auto& entry : journal->Entries())
+            records[get_key(*journal, entry)] = std::make_pair(journal, &entry);
+    return records;
+}
+
+std::vector<DbRecord> Db::GetAllRecords()
+{
+    const auto lock = shared_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    return GetAllRecordsUnsafe();
+}
+
+bool Db::Rewrite(const std::function<void(std::vector<DbRecord>&)>& edit)
+{
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+
+    auto records = GetAllRecordsUnsafe();
+    edit(records);
+    std::sort(records.begin(), records.end(), [](const DbRecord& left, const DbRecord& right) {
+        return left.GetKey() < right.GetKey();
+    });
+
+    const auto temp_name = filename + ".temp";
+
+    {
+        std::ofstream to(temp_name);
+
+        for(const auto& record : records)
+            record.WriteContents(to);
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Unable to write: " << temp_name);
+            to.close();
+            std::remove(temp_name.c_str());
+            return false;
+        }
+    }
+
+    records.clear();
+    return ReplaceUnsafe(temp_name);
+}
+
+std::vector<DbRecord> Db::GetAllRecordsUnsafe()
+{
+    const auto index = DbIndex::Get(filename);
+    std::shared_ptr<const DbJournal> journal;
+    if(!journal_filename.empty())
+        journal = DbJournal::Get(journal_filename);
+
+    std::vector<DbRecord> records;
+
+    for(const auto& ref : CollectRecords(index.get(), journal.get()))
+    {
+        const auto& view  = *ref.second.first;
+        const auto& entry = *ref.second.second;
+
+        if(entry.contents_size == 0)
+            continue; // Removed.
+
+        DbRecord record(ref.first);
+        if(!record.ParseContents(view.GetContents(entry)))
+            MIOPEN_LOG_E("Error parsing payload under the key: " << ref.first << " form file "
+                                                                 << filename
+                                                                 << "#"
+                                                                 << entry.line);
+        records.push_back(std::move(record));
+    }
+
+    return records;
+}
+
+bool Db::CompactUnsafe()
+{
+    if(journal_filename.empty())
+        return true;
+
+    auto journal = DbJournal::Get(journal_filename);
+    if(!journal)
+        return true;
+
+    auto index   = DbIndex::Get(filename);
+    auto records = CollectRecords(index.get(), journal.get());
+
+    const auto temp_name = filename + ".temp";
+
+    {
+        std::ofstream to(temp_name);
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+
+        for(const auto& record : records)
+        {
+            const auto& view  = *record.second.first;
+            const auto& entry = *record.second.second;
+
+            if(entry.contents_size == 0)
+                continue; // Removed.
+
+            to.write(view.Data() + entry.begin, entry.key_size + 1 + entry.contents_size);
+            to << '\n';
+        }
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Unable to write: " << temp_name);
+            to.close();
+            std::remove(temp_name.c_str());
+            return false;
+        }
+    }
+
+    records.clear();
+    index.reset();
+    journal.reset();
+    return ReplaceUnsafe(temp_name);
+}
+
+bool Db::ReplaceUnsafe(const std::string& temp_name)
+{
+    DbIndex::Invalidate(filename);
+    if(!journal_filename.empty())
+        DbJournal::Invalidate(journal_filename);
+
+    // Replaces the db atomically. Should the journal removal below be interrupted,
+    // the journal would just be applied to the compacted db once again.
+    boost::system::error_code ec;
+    boost::filesystem::rename(temp_name, filename, ec);
+
+    if(ec)
+    {
+        MIOPEN_LOG_E("Unable to replace " << filename << ": " << ec.message());
+        std::remove(temp_name.c_str());
+        return false;
+    }
+
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
+    if(!journal_filename.empty())
+    {
+        std::remove(journal_filename.c_str());
+        MIOPEN_LOG_I("Journal has been applied to " << filename);
+    }
+    return true;
+}
+
 bool Db::StoreRecordUnsafe(const DbRecord& record)
 {
     MIOPEN_LOG_I2("Storing record: " << record.key);
@@ -335,9 +775,109 @@ bool Db::RemoveRecordUnsafe(const std::string& key)
     // This will remove record
     MIOPEN_LOG_I("Removing record: " << key);
     RecordPositions pos;
-    FindRecordUnsafe(key, &pos);
+    const auto old_record = FindRecordUnsafe(key, &pos);
+    if(!old_record && !journal_filename.empty())
+        return true; // Nothing to mark as removed.
     const DbRecord empty_record(key);
     return FlushUnsafe(empty_record, &pos);
 }
 
+boost::optional<DbRecord> ReadonlyDb::FindRecord(const std::string& key) const
+{
+    MIOPEN_LOG_I2("Looking for key: " << key);
+
+    const auto binary = DbBinary::Get(filename);
+    if(binary)
+        return Db::FindCompiledRecord(binary->View(), key);
+
+    const auto index = DbIndex::Get(filename);
+
+    if(!index)
+    {
+        MIOPEN_LOG_W("File is unreadable: " << filename);
+        return boost::none;
+    }
+
+    return Db::FindIndexedRecord(*index, key, filename, nullptr);
+}
+
+boost::optional<DbRecord> MultiFileDb::FindRecord(const DbKey& key)
+{
+    // Stamps are taken before reading, so changes made meanwhile invalidate the entry.
+    const DbCache::Stamps stamps = {{FileStamp::Get(_installed_path),
+                                     FileStamp::Get(_user_path),
+                                     FileStamp::Get(DbJournal::GetPath(_user_path))}};
+    auto& cache = DbCache::Instance();
+    boost::optional<DbRecord> record;
+
+    if(cache.Find(_cache_id, key, stamps, record))
+    {
+        MIOPEN_LOG_I2("Cache hit: " << key.ToString());
+        return record;
+    }
+
+    record = FindRecordUncached(key.ToString());
+    cache.Insert(_cache_id, key, stamps, record);
+    return record;
+}
+
+boost::optional<DbRecord> MultiFileDb::FindRecordUncached(const std::string& key)
+{
+    auto users           = _user.FindRecord(key);
+    const auto installed = _installed.FindRecord(key);
+
+    if(users && installed)
+    {
+        users->Merge(installed.value());
+        return users;
+    }
+
+    if(users)
+        return users;
+
+    return installed;
+}
+
+bool MultiFileDb::StoreRecord(const DbRecord& record)
+{
+    const auto ok = _user.StoreRecord(record);
+    InvalidateCache(DbKey(record.key));
+    return ok;
+}
+
+bool MultiFileDb::UpdateRecord(DbRecord& record)
+{
+    const auto ok = _user.UpdateRecord(record);
+    InvalidateCache(DbKey(record.key));
+    return ok;
+}
+
+bool MultiFileDb::StoreRecords(const std::vector<DbRecord>& records)
+{
+    const auto ok = _user.StoreRecords(records);
+    for(const auto& record : records)
+        InvalidateCache(DbKey(record.key));
+    return ok;
+}
+
+bool MultiFileDb::UpdateRecords(std::vector<DbRecord>& records)
+{
+    const auto ok = _user.UpdateRecords(records);
+    for(const auto& record : records)
+        InvalidateCache(DbKey(record.key));
+    return ok;
+}
+
+bool MultiFileDb::RemoveRecord(const std::string& key)
+{
+    const auto ok = _user.RemoveRecord(key);
+    InvalidateCache(DbKey(key));
+    return ok;
+}
+
+void MultiFileDb::InvalidateCache(const DbKey& key)
+{
+    DbCache::Instance().Invalidate(_cache_id, key);
+}
+
 } // namespace miopen
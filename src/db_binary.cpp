@@ -0,0 +1,301 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_binary.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <istream>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+int CompareDbKeys(const char* lhs, std::size_t lhs_size, const char* rhs, std::size_t rhs_size)
+{
+    const auto cmp = std::memcmp(lhs, rhs, std::min(lhs_size, rhs_size));
+    if(cmp != 0)
+        return cmp;
+    return lhs_size < rhs_size ? -1 : (lhs_size > rhs_size ? 1 : 0);
+}
+
+DbBinaryView::DbBinaryView(const char* data_, std::size_t size_)
+{
+    if(data_ == nullptr || size_ < sizeof(DbBinaryHeader))
+        return;
+
+    const auto h = reinterpret_cast<const DbBinaryHeader*>(data_);
+    if(std::memcmp(h->magic, DbBinaryHeader::Magic(), sizeof(h->magic)) != 0 ||
+       h->version != DbBinaryHeader::CurrentVersion())
+        return;
+
+    const std::uint64_t records_offset = sizeof(DbBinaryHeader);
+    const std::uint64_t ids_offset =
+        records_offset + std::uint64_t{h->n_records} * sizeof(DbBinaryRecord);
+    const std::uint64_t values_offset =
+        ids_offset + std::uint64_t{h->n_ids} * sizeof(DbBinaryString);
+    const std::uint64_t fields_offset =
+        values_offset + std::uint64_t{h->n_values} * sizeof(DbBinaryValue);
+    const std::uint64_t strings_offset =
+        fields_offset + std::uint64_t{h->n_fields} * sizeof(std::int32_t);
+
+    if(strings_offset + h->strings_size != size_)
+        return;
+
+    const auto r = reinterpret_cast<const DbBinaryRecord*>(data_ + records_offset);
+    const auto i = reinterpret_cast<const DbBinaryString*>(data_ + ids_offset);
+    const auto v = reinterpret_cast<const DbBinaryValue*>(data_ + values_offset);
+
+    const auto is_valid_string = [&](const DbBinaryString& s) {
+        return std::uint64_t{s.offset} + s.size <= h->strings_size;
+    };
+
+    for(auto n = 0u; n < h->n_records; ++n)
+        if(!is_valid_string(r[n].key) ||
+           std::uint64_t{r[n].first_value} + r[n].n_values > h->n_values)
+            return;
+
+    for(auto n = 0u; n < h->n_ids; ++n)
+        if(!is_valid_string(i[n]))
+            return;
+
+    for(auto n = 0u; n < h->n_values; ++n)
+        if(v[n].id >= h->n_ids || !is_valid_string(v[n].values) ||
+           (v[n].n_fields > 0 && std::uint64_t{v[n].first_field} + v[n].n_fields > h->n_fields))
+            return;
+
+    header  = h;
+    records = r;
+    ids     = i;
+    values  = v;
+    fields  = reinterpret_cast<const std::int32_t*>(data_ + fields_offset);
+    strings = data_ + strings_offset;
+}
+
+const DbBinaryRecord* DbBinaryView::Find(const std::string& key) const
+{
+    const auto end   = records + header->n_records;
+    const auto found = std::lower_bound(
+        records, end, key, [this](const DbBinaryRecord& record, const std::string& k) {
+            return CompareDbKeys(GetString(record.key), record.key.size, k.data(), k.size()) < 0;
+        });
+
+    if(found == end ||
+       CompareDbKeys(GetString(found->key), found->key.size, key.data(), key.size()) != 0)
+        return nullptr;
+    return found;
+}
+
+std::string GetDbBinaryPath(const std::string& text_path)
+{
+    static const std::string text_ext = ".txt";
+
+    if(text_path.size() >= text_ext.size() &&
+       text_path.compare(text_path.size() - text_ext.size(), text_ext.size(), text_ext) == 0)
+        return text_path.substr(0, text_path.size() - text_ext.size()) + ".bin";
+    return text_path + ".bin";
+}
+
+namespace {
+
+struct CompiledValue
+{
+    std::string id;
+    std::string values;
+};
+
+class DbBinaryWriter
+{
+    public:
+    void Add(const std::string& key, const std::vector<CompiledValue>& record)
+    {
+        DbBinaryRecord r{};
+        r.key         = Intern(key, false);
+        r.first_value = static_cast<std::uint32_t>(values.size());
+        r.n_values    = static_cast<std::uint32_t>(record.size());
+        records.push_back(r);
+
+        for(const auto& value : record)
+        {
+            DbBinaryValue v{};
+            v.id     = InternId(value.id);
+            v.values = Intern(value.values, true);
+            AddFields(value.values, v);
+            values.push_back(v);
+        }
+    }
+
+    void Write(std::ostream& out) const
+    {
+        DbBinaryHeader header{};
+        std::memcpy(header.magic, DbBinaryHeader::Magic(), sizeof(header.magic));
+        header.version      = DbBinaryHeader::CurrentVersion();
+        header.n_records    = static_cast<std::uint32_t>(records.size());
+        header.n_ids        = static_cast<std::uint32_t>(ids.size());
+        header.n_values     = static_cast<std::uint32_t>(values.size());
+        header.n_fields     = static_cast<std::uint32_t>(fields.size());
+        header.strings_size = static_cast<std::uint32_t>(strings.size());
+
+        WriteArray(out, &header, 1);
+        WriteArray(out, records.data(), records.size());
+        WriteArray(out, ids.data(), ids.size());
+        WriteArray(out, values.data(), values.size());
+        WriteArray(out, fields.data(), fields.size());
+        WriteArray(out, strings.data(), strings.size());
+    }
+
+    private:
+    std::vector<DbBinaryRecord> records;
+    std::vector<DbBinaryString> ids;
+    std::vector<DbBinaryValue> values;
+    std::vector<std::int32_t> fields;
+    std::string strings;
+    std::unordered_map<std::string, std::uint32_t> id_indices;
+    std::unordered_map<std::string, DbBinaryString> interned;
+
+    template <class T>
+    static void WriteArray(std::ostream& out, const T* data, std::size_t count)
+    {
+        out.write(reinterpret_cast<const char*>(data), count * sizeof(T));
+    }
+
+    DbBinaryString Intern(const std::string& s, bool reuse)
+    {
+        if(reuse)
+        {
+            const auto found = interned.find(s);
+            if(found != interned.end())
+                return found->second;
+        }
+
+        if(strings.size() + s.size() > std::numeric_limits<std::uint32_t>::max())
+            throw std::length_error("Compiled db is too big");
+
+        const DbBinaryString ret{static_cast<std::uint32_t>(strings.size()),
+                                 static_cast<std::uint32_t>(s.size())};
+        strings += s;
+        if(reuse)
+            interned.emplace(s, ret);
+        return ret;
+    }
+
+    std::uint32_t InternId(const std::string& id)
+    {
+        const auto found = id_indices.find(id);
+        if(found != id_indices.end())
+            return found->second;
+
+        const auto index = static_cast<std::uint32_t>(ids.size());
+        ids.push_back(Intern(id, true));
+        id_indices.emplace(id, index);
+        return index;
+    }
+
+    void AddFields(const std::string& s, DbBinaryValue& value)
+    {
+        const auto first = fields.size();
+        value.first_field = static_cast<std::uint32_t>(first);
+        value.n_fields    = -1;
+
+        if(s.empty())
+            return;
+
+        for(const char* p = s.c_str();;)
+        {
+            char* end;
+            errno            = 0;
+            const auto field = std::strtol(p, &end, 10);
+
+            if(end == p || errno != 0 || field < std::numeric_limits<std::int32_t>::min() ||
+               field > std::numeric_limits<std::int32_t>::max() || (*end != ',' && *end != 0))
+            {
+                fields.resize(first);
+                return;
+            }
+
+            fields.push_back(static_cast<std::int32_t>(field));
+            if(*end == 0)
+                break;
+            p = end + 1;
+        }
+
+        value.n_fields = static_cast<std::int32_t>(fields.size() - first);
+    }
+};
+
+} // namespace
+
+std::size_t CompileDb(std::istream& text, std::ostream& binary)
+{
+    // Sorted, the first occurence of a KEY wins.
+    std::map<std::string, std::vector<CompiledValue>> records;
+    std::string line;
+
+    while(std::getline(text, line))
+    {
+        const auto key_size = line.find('=');
+        if(key_size == std::string::npos || key_size == 0 || key_size + 1 == line.size())
+            continue;
+
+        const auto inserted =
+            records.emplace(line.substr(0, key_size), std::vector<CompiledValue>{});
+        if(!inserted.second)
+            continue;
+
+        auto& record = inserted.first->second;
+        std::istringstream contents(line.substr(key_size + 1));
+        std::string id_and_values;
+
+        while(std::getline(contents, id_and_values, ';'))
+        {
+            const auto id_size = id_and_values.find(':');
+            if(id_size == std::string::npos)
+                continue;
+
+            const auto id = id_and_values.substr(0, id_size);
+            if(std::any_of(record.begin(), record.end(), [&](const CompiledValue& v) {
+                   return v.id == id;
+               }))
+                continue;
+
+            record.push_back({id, id_and_values.substr(id_size + 1)});
+        }
+    }
+
+    DbBinaryWriter writer;
+    for(const auto& record : records)
+        writer.Add(record.first, record.second);
+    writer.Write(binary);
+    return records.size();
+}
+
+} // namespace miopen
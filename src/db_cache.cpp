@@ -0,0 +1,142 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_cache.hpp>
+#include <miopen/env.hpp>
+
+#include <iterator>
+#include <utility>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DB_CACHE_SIZE)
+
+DbCache& DbCache::Instance()
+{
+    static const auto size = Value(MIOPEN_DB_CACHE_SIZE{});
+    static DbCache instance(size != 0 ? size : DefaultCapacity());
+    return instance;
+}
+
+bool DbCache::Find(const std::string& db,
+                   const DbKey& key,
+                   const Stamps& stamps,
+                   boost::optional<DbRecord>& record)
+{
+    const auto id = MakeId(db, key);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto it = entries.find(id);
+    if(it == entries.end() || it->second->stamps != stamps)
+    {
+        ++misses;
+        return false;
+    }
+
+    lru.splice(lru.begin(), lru, it->second);
+    record = it->second->record;
+    ++hits;
+    return true;
+}
+
+void DbCache::Insert(const std::string& db,
+                     const DbKey& key,
+                     const Stamps& stamps,
+                     const boost::optional<DbRecord>& record)
+{
+    if(capacity == 0)
+        return;
+
+    auto id = MakeId(db, key);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto it = entries.find(id);
+    if(it != entries.end())
+    {
+        it->second->stamps = stamps;
+        it->second->record = record;
+        lru.splice(lru.begin(), lru, it->second);
+        return;
+    }
+
+    if(lru.size() >= capacity)
+    {
+        entries.erase(lru.back().id);
+        lru.pop_back();
+    }
+
+    lru.push_front(Entry{std::move(id), db.size(), stamps, record});
+    entries.emplace(lru.front().id, lru.begin());
+}
+
+void DbCache::Invalidate(const std::string& db, const DbKey& key)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const auto it = entries.find(MakeId(db, key));
+    if(it == entries.end())
+        return;
+
+    lru.erase(it->second);
+    entries.erase(it);
+}
+
+void DbCache::Invalidate(const std::string& db)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    for(auto it = lru.begin(); it != lru.end();)
+    {
+        if(it->db_size == db.size() && it->id.str.compare(0, db.size(), db) == 0)
+        {
+            entries.erase(it->id);
+            it = lru.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+std::size_t DbCache::Size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return lru.size();
+}
+
+std::size_t DbCache::Hits() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+std::size_t DbCache::Misses() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+} // namespace miopen
@@ -0,0 +1,265 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_index.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace miopen {
+
+FileStamp FileStamp::Get(const std::string& filename)
+{
+    FileStamp stamp;
+#ifndef _WIN32
+    struct stat st;
+    if(stat(filename.c_str(), &st) != 0)
+        return stamp;
+    stamp.exists = true;
+    stamp.size   = st.st_size;
+#ifdef __APPLE__
+    stamp.mtime = st.st_mtimespec.tv_sec * 1000000000LL + st.st_mtimespec.tv_nsec;
+#else
+    stamp.mtime = st.st_mtim.tv_sec * 1000000000LL + st.st_mtim.tv_nsec;
+#endif
+    stamp.node = st.st_ino;
+#else
+    boost::system::error_code ec;
+    const auto size = boost::filesystem::file_size(filename, ec);
+    if(ec)
+        return stamp;
+    const auto mtime = boost::filesystem::last_write_time(filename, ec);
+    if(ec)
+        return stamp;
+    stamp.exists = true;
+    stamp.size   = size;
+    stamp.mtime  = mtime * 1000000000LL;
+#endif
+    return stamp;
+}
+
+static void Map(const std::string& filename,
+                std::size_t size,
+                boost::interprocess::mapped_region& region)
+{
+    const boost::interprocess::file_mapping mapping(filename.c_str(),
+                                                    boost::interprocess::read_only);
+    boost::interprocess::mapped_region(mapping, boost::interprocess::read_only, 0, size)
+        .swap(region);
+}
+
+DbIndex::DbIndex(const std::string& filename, const FileStamp& stamp_, bool is_journal_)
+    : stamp(stamp_), is_journal(is_journal_)
+{
+    if(stamp.size == 0)
+        return;
+
+    Map(filename, stamp.size, region);
+
+    const auto data = Data();
+    const auto size = Size();
+    int n_line      = 0;
+
+    for(std::size_t begin = 0; begin < size;)
+    {
+        const auto eol = static_cast<const char*>(std::memchr(data + begin, '\n', size - begin));
+        const std::size_t line_end = eol != nullptr ? eol - data : size;
+        const std::size_t next     = eol != nullptr ? line_end + 1 : size;
+        ++n_line;
+
+        if(eol == nullptr && is_journal)
+        {
+            MIOPEN_LOG_W("Incomplete journal record ignored: " << filename << "#" << n_line);
+            break;
+        }
+
+        const auto eq = static_cast<const char*>(std::memchr(data + begin, '=', line_end - begin));
+        if(eq == nullptr || eq == data + begin)
+        {
+            if(line_end != begin) // Do not blame empty lines.
+                MIOPEN_LOG_E("Ill-formed record: key not found: " << filename << "#" << n_line);
+        }
+        else
+        {
+            const std::size_t key_size      = eq - (data + begin);
+            const std::size_t contents_size = line_end - begin - key_size - 1;
+
+            if(contents_size == 0 && !is_journal)
+                MIOPEN_LOG_E("None contents under the key: "
+                             << std::string(data + begin, key_size)
+                             << " form file "
+                             << filename
+                             << "#"
+                             << n_line);
+            else
+                entries.push_back({begin, next, key_size, contents_size, n_line});
+        }
+
+        begin = next;
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [data](const Entry& lhs, const Entry& rhs) {
+        return CompareDbKeys(data + lhs.begin, lhs.key_size, data + rhs.begin, rhs.key_size) < 0;
+    });
+
+    MIOPEN_LOG_I2("Indexed " << entries.size() << " records from " << filename);
+}
+
+const DbIndex::Entry* DbIndex::Find(const std::string& key) const
+{
+    const auto data  = Data();
+    const auto found = std::lower_bound(
+        entries.begin(), entries.end(), key, [data](const Entry& entry, const std::string& k) {
+            return CompareDbKeys(data + entry.begin, entry.key_size, k.data(), k.size()) < 0;
+        });
+
+    if(found == entries.end() ||
+       CompareDbKeys(data + found->begin, found->key_size, key.data(), key.size()) != 0)
+        return nullptr;
+
+    if(!is_journal)
+        return &*found;
+
+    const auto last = std::upper_bound(
+        found, entries.end(), key, [data](const std::string& k, const Entry& entry) {
+            return CompareDbKeys(k.data(), k.size(), data + entry.begin, entry.key_size) < 0;
+        });
+    return &*(last - 1);
+}
+
+template <class TView>
+struct SharedViews
+{
+    std::mutex mutex;
+    std::map<std::string, std::shared_ptr<const TView>> views;
+
+    static SharedViews& Instance()
+    {
+        static SharedViews instance;
+        return instance;
+    }
+
+    /// Returns cached view if it is still valid, or creates a new one.
+    std::shared_ptr<const TView> Get(const std::string& filename, const FileStamp& stamp)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto& cached = views[filename];
+
+        if(!stamp.exists)
+        {
+            cached = nullptr;
+            return nullptr;
+        }
+
+        if(cached != nullptr && cached->Stamp() == stamp)
+            return cached;
+
+        try
+        {
+            cached = std::make_shared<const TView>(filename, stamp);
+        }
+        catch(const boost::interprocess::interprocess_exception& ex)
+        {
+            MIOPEN_LOG_I2("Unable to map " << filename << ": " << ex.what());
+            cached = nullptr;
+        }
+        return cached;
+    }
+
+    void Invalidate(const std::string& filename)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        views.erase(filename);
+    }
+};
+
+std::shared_ptr<const DbIndex> DbIndex::Get(const std::string& filename)
+{
+    return SharedViews<DbIndex>::Instance().Get(filename, FileStamp::Get(filename));
+}
+
+void DbIndex::Invalidate(const std::string& filename)
+{
+    SharedViews<DbIndex>::Instance().Invalidate(filename);
+}
+
+std::shared_ptr<const DbJournal> DbJournal::Get(const std::string& filename)
+{
+    return SharedViews<DbJournal>::Instance().Get(filename, FileStamp::Get(filename));
+}
+
+void DbJournal::Invalidate(const std::string& filename)
+{
+    SharedViews<DbJournal>::Instance().Invalidate(filename);
+}
+
+std::size_t DbJournal::CompleteSize() const
+{
+    auto size = Size();
+    while(size > 0 && Data()[size - 1] != '\n')
+        --size;
+    return size;
+}
+
+DbBinary::DbBinary(const std::string& filename, const FileStamp& stamp_) : stamp(stamp_)
+{
+    if(stamp.size == 0)
+        return;
+
+    Map(filename, stamp.size, region);
+    view = DbBinaryView{static_cast<const char*>(region.get_address()), region.get_size()};
+
+    if(!view.IsValid())
+        MIOPEN_LOG_W("Compiled db is invalid or has unsupported version: " << filename);
+    else
+        MIOPEN_LOG_I2("Mapped " << view.RecordCount() << " records from " << filename);
+}
+
+std::shared_ptr<const DbBinary> DbBinary::Get(const std::string& text_filename)
+{
+    const auto filename    = GetDbBinaryPath(text_filename);
+    const auto stamp       = FileStamp::Get(filename);
+    const auto text_stamp  = FileStamp::Get(text_filename);
+    const auto is_outdated = text_stamp.exists && text_stamp.mtime > stamp.mtime;
+    const auto binary      = SharedViews<DbBinary>::Instance().Get(filename, stamp);
+
+    if(binary == nullptr || is_outdated || !binary->View().IsValid())
+        return nullptr;
+    return binary;
+}
+
+} // namespace miopen
@@ -23,6 +23,7 @@
  * SOFTWARE.
  *
  *******************************************************************************/
+#include <cassert>
 #include <iostream>
 #include <numeric>
 #include <ostream>
@@ -46,6 +47,7 @@ bool DbRecord::SetValues(const std::string& id, const std::string& values)
                          << ':'
                          << values);
         map[id] = values;
+        fields.erase(id);
         return true;
     }
     MIOPEN_LOG_I(key << ", content is the same, not changed:" << id << ':' << values);
@@ -67,6 +69,12 @@ bool DbRecord::GetValues(const std::string& id, std::string& values) const
     return true;
 }
 
+void DbRecord::SetFields(const std::string& id, std::vector<int> values)
+{
+    assert(map.find(id) != map.end());
+    fields[id] = std::move(values);
+}
+
 bool DbRecord::EraseValues(const std::string& id)
 {
     const auto it = map.find(id);
@@ -74,6 +82,7 @@ bool DbRecord::EraseValues(const std::string& id)
     {
         MIOPEN_LOG_I(key << ", removed: " << id << ':' << it->second);
         map.erase(it);
+        fields.erase(id);
         return true;
     }
     MIOPEN_LOG_W(key << ", not found: " << id);
@@ -87,6 +96,7 @@ bool DbRecord::ParseContents(const std::string& contents)
     int found = 0;
 
     map.clear();
+    fields.clear();
 
     while(std::getline(ss, id_and_values, ';'))
     {
@@ -141,6 +151,10 @@ void DbRecord::Merge(const DbRecord& that)
         if(map.find(that_pair.first) != map.end())
             continue;
         map[that_pair.first] = that_pair.second;
+
+        const auto that_fields = that.fields.find(that_pair.first);
+        if(that_fields != that.fields.end())
+            fields[that_pair.first] = that_fields->second;
     }
 }
 } // namespace miopen
@@ -0,0 +1,145 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/fast_hash.hpp>
+
+#include <cstring>
+
+namespace miopen {
+
+namespace {
+
+constexpr std::uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+constexpr std::uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr std::uint64_t Prime3 = 0x165667B19E3779F9ull;
+constexpr std::uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+constexpr std::uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+inline std::uint64_t RotL(std::uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline std::uint64_t Read64(const char* p)
+{
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint32_t Read32(const char* p)
+{
+    std::uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline std::uint64_t Round(std::uint64_t acc, std::uint64_t input)
+{
+    acc += input * Prime2;
+    acc = RotL(acc, 31);
+    return acc * Prime1;
+}
+
+inline std::uint64_t MergeRound(std::uint64_t acc, std::uint64_t lane)
+{
+    acc ^= Round(0, lane);
+    return acc * Prime1 + Prime4;
+}
+
+} // namespace
+
+std::uint64_t FastHash64(const char* data, std::size_t size, std::uint64_t seed)
+{
+    const auto end = data + size;
+    std::uint64_t h;
+
+    if(size >= 32)
+    {
+        std::uint64_t v1 = seed + Prime1 + Prime2;
+        std::uint64_t v2 = seed + Prime2;
+        std::uint64_t v3 = seed;
+        std::uint64_t v4 = seed - Prime1;
+
+        // The lanes do not depend on each other, so their rounds overlap in the pipeline.
+        for(; end - data >= 32; data += 32)
+        {
+            v1 = Round(v1, Read64(data));
+            v2 = Round(v2, Read64(data + 8));
+            v3 = Round(v3, Read64(data + 16));
+            v4 = Round(v4, Read64(data + 24));
+        }
+
+        h = RotL(v1, 1) + RotL(v2, 7) + RotL(v3, 12) + RotL(v4, 18);
+        h = MergeRound(h, v1);
+        h = MergeRound(h, v2);
+        h = MergeRound(h, v3);
+        h = MergeRound(h, v4);
+    }
+    else
+    {
+        h = seed + Prime5;
+    }
+
+    h += size;
+
+    for(; end - data >= 8; data += 8)
+    {
+        h ^= Round(0, Read64(data));
+        h = RotL(h, 27) * Prime1 + Prime4;
+    }
+    if(end - data >= 4)
+    {
+        h ^= Read32(data) * Prime1;
+        h = RotL(h, 23) * Prime2 + Prime3;
+        data += 4;
+    }
+    for(; data != end; ++data)
+    {
+        h ^= static_cast<unsigned char>(*data) * Prime5;
+        h = RotL(h, 11) * Prime1;
+    }
+
+    h ^= h >> 33;
+    h *= Prime2;
+    h ^= h >> 29;
+    h *= Prime3;
+    h ^= h >> 32;
+    return h;
+}
+
+std::string FastHashHex(const std::string& s)
+{
+    static const char digits[] = "0123456789abcdef";
+    const std::uint64_t halves[] = {FastHash64(s), FastHash64(s, Prime5)};
+
+    std::string hex(32, '0');
+    auto out = hex.begin();
+    for(auto half : halves)
+    {
+        for(auto shift = 60; shift >= 0; shift -= 4)
+            *out++ = digits[(half >> shift) & 0xf];
+    }
+    return hex;
+}
+
+} // namespace miopen
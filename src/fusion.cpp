@@ -963,7 +963,7 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
     else
     {
         MIOPEN_LOG_I2("Precompiled kernel does not exist, compiling fused-kernel");
-        std::string compile_config;
+        KernelBuildParameters compile_config;
         auto success = true;
         // lu.cur_vertex is sorted according to the weights from MDGraph::Advance method
         std::vector<std::pair<MDGraph_vertex_ptr, cur_vertex_map>> new_list;
@@ -975,7 +975,9 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
                 MIOPEN_THROW(miopenStatusBadParm);
             }
 
-            success = true;
+            // Defines of a rejected candidate must not leak into the next one.
+            compile_config = {};
+            success        = true;
             solver::AnySolver sol;
             if(kinder.second.find("solver") != kinder.second.end())
             {
@@ -1029,11 +1031,13 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
                 {
                     if(dType == miopenFloat)
                     {
-                        compile_config += " -DMIOPEN_USE_FP16=0 -DMIOPEN_USE_FP32=1";
+                        compile_config << KernelBuildParameters{{"MIOPEN_USE_FP16", 0},
+                                                                {"MIOPEN_USE_FP32", 1}};
                     }
                     else
                     {
-                        compile_config += " -DMIOPEN_USE_FP16=1 -DMIOPEN_USE_FP32=0";
+                        compile_config << KernelBuildParameters{{"MIOPEN_USE_FP16", 1},
+                                                                {"MIOPEN_USE_FP32", 0}};
                     }
                 }
                 // TODO: This true for inference but might not be true in general
@@ -1042,14 +1046,26 @@ miopenStatus_t FusionPlanDescriptor::Compile(Handle& handle)
                 const auto& vld = ops_head->GetLocalWGSz(handle, algorithm_name);
                 const auto& vgd = ops_head->GetGlobalWGSz(handle, algorithm_name);
                 MIOPEN_LOG_I2("Program: " << program_name << ", kernel: " << kernel_name);
-                MIOPEN_LOG_I2("Build options: " << compile_config);
+                compile_config.Canonicalize();
+                auto build_options = kernel_source_type == AsmText
+                                         ? compile_config.GenerateFor(kbp::GcnAsm{})
+                                         : compile_config.GenerateFor(kbp::OpenCL{});
+                for(auto&& op : op_map)
+                {
+                    if(op->kind() == miopenFusionOpConvForward)
+                    {
+                        auto ptr      = std::dynamic_pointer_cast<ConvForwardOpDescriptor>(op);
+                        build_options = ptr->conv_compiler_options + " " + build_options;
+                    }
+                }
+                MIOPEN_LOG_I2("Build options: " << build_options);
                 handle.AddKernel(algorithm_name,
                                  network_config,
                                  program_name,
                                  kernel_name,
                                  vld,
                                  vgd,
-                                 compile_config);
+                                 build_options);
 
                 status = miopenStatusSuccess;
             }
@@ -162,6 +162,7 @@ struct HandleImpl
     float profiling_result = 0.0;
     int device             = -1;
     Allocator allocator{};
+    BinaryCacheCounters binary_cache_counters;
     KernelCache cache;
     hipCtx_t ctx;
 };
@@ -201,7 +202,15 @@ Handle::Handle() : impl(new HandleImpl())
 #endif
 }
 
-Handle::~Handle() {}
+Handle::~Handle()
+{
+    if(impl == nullptr)
+        return;
+
+    // The builds run on behalf of the handle, so they shall end before it does.
+    FinishBuilds();
+    LogBinaryCacheStats(impl->binary_cache_counters.Get());
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -214,6 +223,12 @@ void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 
 miopenAcceleratorQueue_t Handle::GetStream() const { return impl->stream.get(); }
 
+Handle Handle::CreateSibling() const
+{
+    // All the streams of a device share its context.
+    return Handle{};
+}
+
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
                           void* allocatorContext) const
@@ -282,12 +297,19 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config)
+std::shared_ptr<const std::vector<Kernel>>
+Handle::GetKernelsImpl(const std::string& algorithm, const std::string& network_config)
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
 
+void Handle::BuildProgramAsync(const std::string& program_name, const std::string& params)
+{
+    this->impl->cache.BuildProgramAsync(*this, program_name, params);
+}
+
+std::size_t Handle::FinishBuilds() { return this->impl->cache.FinishBuilds(); }
+
 bool Handle::HasKernel(const std::string& algorithm, const std::string& network_config) const
 {
     return this->impl->cache.HasKernels(algorithm, network_config);
@@ -306,25 +328,36 @@ Program Handle::LoadProgram(const std::string& program_name, std::string params,
 {
     this->impl->set_ctx();
     params += " -mcpu=" + this->GetDeviceName();
-    auto cache_file =
+    const auto start  = BinaryCacheCounters::Clock::now();
+    const auto binary =
         miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
-    if(cache_file.empty())
+    if(binary.empty())
     {
         auto p = HIPOCProgram{program_name, params, is_kernel_str};
+        this->impl->binary_cache_counters.AddMiss(start);
 
         // Save to cache
-        auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
-        boost::filesystem::copy_file(p.GetBinary(), path);
-        miopen::SaveBinary(path, this->GetDeviceName(), program_name, params, is_kernel_str);
+        miopen::SaveBinary(p.GetBinary(),
+                           this->GetDeviceName(),
+                           program_name,
+                           params,
+                           is_kernel_str);
 
         return p;
     }
     else
     {
-        return HIPOCProgram{program_name, cache_file};
+        auto p = HIPOCProgram{program_name, binary};
+        this->impl->binary_cache_counters.AddHit(start);
+        return p;
     }
 }
 
+BinaryCacheStats Handle::GetBinaryCacheStats() const
+{
+    return this->impl->binary_cache_counters.Get();
+}
+
 void Handle::Finish() const
 {
     this->impl->set_ctx();
@@ -352,6 +385,8 @@ void Handle::Finish() const
 }
 void Handle::Flush() const {}
 
+const void* Handle::GetProgramScope() const { return this->impl->ctx; }
+
 bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
 
 void Handle::ResetKernelTime() { this->impl->profiling_result = 0.0; }
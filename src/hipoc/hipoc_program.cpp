@@ -27,116 +27,68 @@
 #include <miopen/gcn_asm_utils.hpp>
 #include <miopen/hipoc_program.hpp>
 #include <miopen/kernel.hpp>
+#include <miopen/kernel_compiler.hpp>
 #include <miopen/kernel_warnings.hpp>
 #include <miopen/stringutils.hpp>
-#include <miopen/tmp_dir.hpp>
-#include <miopen/write_file.hpp>
-#include <boost/optional.hpp>
 #include <sstream>
 
-#include <unistd.h>
-
 namespace miopen {
 
-hipModulePtr CreateModule(const std::string& program_name, std::string params, bool is_kernel_str)
+static KernelCompiler& GetHipCompiler()
+{
+    static ExternalCompiler compiler{HIP_OC_COMPILER};
+    return compiler;
+}
+
+static std::string
+BuildCodeObject(const std::string& program_name, std::string params, bool is_kernel_str)
 {
     std::string filename =
         is_kernel_str ? "tinygemm.cl" : program_name; // jn : don't know what this is
-    TmpDir dir{filename};
-    auto bin_file   = dir.path / (filename + ".bin");
-    auto hsaco_file = dir.path / (filename + ".o");
-    auto obj_file   = dir.path / (filename + ".obj");
 
     std::string src = is_kernel_str ? program_name : GetKernelSrc(program_name);
     if(!is_kernel_str && miopen::EndsWith(program_name, ".so"))
-    {
-        WriteFile(src, hsaco_file);
-    }
-    else if(!is_kernel_str && miopen::EndsWith(program_name, ".s"))
+        return src;
+
+    if(!is_kernel_str && miopen::EndsWith(program_name, ".s"))
     {
         AmdgcnAssemble(src, params);
-        WriteFile(src, hsaco_file);
+        return src;
     }
-    else
-    {
-
-        WriteFile(src, dir.path / filename);
 
 #if MIOPEN_BUILD_DEV
-        params += " -Werror" + KernelWarningsString();
+    params += " -Werror" + KernelWarningsString();
 #else
-        params += " -Wno-everything";
+    params += " -Wno-everything";
 #endif
-        dir.Execute(HIP_OC_COMPILER, params + " " + filename + " -o " + hsaco_file.string());
-    }
-
-    hipModule_t raw_m;
-    auto status = hipModuleLoad(&raw_m, hsaco_file.string().c_str());
-    if(status != hipSuccess)
-        MIOPEN_THROW_HIP_STATUS(status, "Failed creating module");
-    // We construct the module after the error even though this might leak
-    // memory because it causes a nasty double free in glibc if we dont
-    hipModulePtr m{raw_m};
-    return m;
+    return GetHipCompiler().Compile(filename, src, params);
 }
 
-hipModulePtr CreateModule(const boost::filesystem::path& hsaco_file)
+hipModulePtr LoadModule(const std::string& hsaco_binary)
 {
     hipModule_t raw_m;
-    auto status = hipModuleLoad(&raw_m, hsaco_file.string().c_str());
+    auto status = hipModuleLoadData(&raw_m, hsaco_binary.data());
     hipModulePtr m{raw_m};
     if(status != hipSuccess)
-        MIOPEN_THROW_HIP_STATUS(status, "Failed creating module");
+        MIOPEN_THROW_HIP_STATUS(status, "Failed loading module");
     return m;
 }
 
 struct HIPOCProgramImpl
 {
-    HIPOCProgramImpl(const std::string& program_name, const boost::filesystem::path& hsaco)
-        : name(program_name), hsaco_file(hsaco)
+    HIPOCProgramImpl(const std::string& program_name, const std::string& hsaco_binary)
+        : name(program_name)
     {
-        this->module = CreateModule(this->hsaco_file);
+        this->module = LoadModule(hsaco_binary);
     }
     HIPOCProgramImpl(const std::string& program_name, std::string params, bool is_kernel_str)
-        : name(program_name)
+        : name(program_name), binary(BuildCodeObject(program_name, params, is_kernel_str))
     {
-        this->BuildModule(program_name, params, is_kernel_str);
-        this->module = CreateModule(this->hsaco_file);
+        this->module = LoadModule(this->binary);
     }
     std::string name;
-    boost::filesystem::path hsaco_file;
+    std::string binary;
     hipModulePtr module;
-    boost::optional<TmpDir> dir;
-    void BuildModule(const std::string& program_name, std::string params, bool is_kernel_str)
-    {
-        std::string filename =
-            is_kernel_str ? "tinygemm.cl" : program_name; // jn : don't know what this is
-        dir.emplace(filename);
-        hsaco_file = dir->path / (filename + ".o");
-
-        std::string src = is_kernel_str ? program_name : GetKernelSrc(program_name);
-        if(!is_kernel_str && miopen::EndsWith(program_name, ".so"))
-        {
-            WriteFile(src, hsaco_file);
-        }
-        else if(!is_kernel_str && miopen::EndsWith(program_name, ".s"))
-        {
-            AmdgcnAssemble(src, params);
-            WriteFile(src, hsaco_file);
-        }
-        else
-        {
-
-            WriteFile(src, dir->path / filename);
-
-#if MIOPEN_BUILD_DEV
-            params += " -Werror" + KernelWarningsString();
-#else
-            params += " -Wno-everything";
-#endif
-            dir->Execute(HIP_OC_COMPILER, params + " " + filename + " -o " + hsaco_file.string());
-        }
-    }
 };
 
 HIPOCProgram::HIPOCProgram() {}
@@ -145,13 +97,15 @@ HIPOCProgram::HIPOCProgram(const std::string& program_name, std::string params,
 {
 }
 
-HIPOCProgram::HIPOCProgram(const std::string& program_name, const boost::filesystem::path& hsaco)
-    : impl(std::make_shared<HIPOCProgramImpl>(program_name, hsaco))
+HIPOCProgram::HIPOCProgram(const std::string& program_name, const std::string& hsaco_binary)
+    : impl(std::make_shared<HIPOCProgramImpl>(program_name, hsaco_binary))
 {
 }
 
 hipModule_t HIPOCProgram::GetModule() const { return this->impl->module.get(); }
 
-boost::filesystem::path HIPOCProgram::GetBinary() const { return this->impl->hsaco_file; }
+const std::string& HIPOCProgram::GetBinary() const { return this->impl->binary; }
+
+const std::string& HIPOCProgram::GetName() const { return this->impl->name; }
 
 } // namespace miopen
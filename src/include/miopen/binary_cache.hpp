@@ -27,27 +27,68 @@
 #ifndef GUARD_MLOPEN_BINARY_CACHE_HPP
 #define GUARD_MLOPEN_BINARY_CACHE_HPP
 
+#include <chrono>
+#include <cstddef>
+#include <iosfwd>
+#include <mutex>
 #include <string>
 #include <boost/filesystem/path.hpp>
 
 namespace miopen {
 
+/// Path of the program in the one-file-per-program layout, which is no longer written.
+/// Programs found there are moved to the packed cache by LoadBinary().
 boost::filesystem::path GetCacheFile(const std::string& device,
                                      const std::string& name,
                                      const std::string& args,
                                      bool is_kernel_str);
 
 boost::filesystem::path GetCachePath();
+
+/// Compiled programs are kept in a single file per device, see packed_cache.hpp.
+/// MIOPEN_CACHE_SIZE_LIMIT_MB sets the size limit of the file, see PackedCache::SetSizeLimit().
+boost::filesystem::path GetPackedCacheFile(const std::string& device);
+
+/// Returns contents of the cached program binary, or an empty string if there is none.
 std::string LoadBinary(const std::string& device,
                        const std::string& name,
                        const std::string& args,
                        bool is_kernel_str = false);
-void SaveBinary(const boost::filesystem::path& binary_path,
+void SaveBinary(const std::string& binary,
                 const std::string& device,
                 const std::string& name,
                 const std::string& args,
                 bool is_kernel_str = false);
 
+/// Program loads of a handle, see Handle::GetBinaryCacheStats().
+struct BinaryCacheStats
+{
+    std::size_t hits    = 0; // Programs loaded from the binary cache.
+    std::size_t misses  = 0; // Programs compiled.
+    double load_time    = 0; // Milliseconds spent loading the hits.
+    double compile_time = 0; // Milliseconds spent compiling the misses.
+};
+
+std::ostream& operator<<(std::ostream& os, const BinaryCacheStats& stats);
+
+/// Prints the stats if MIOPEN_LOG_CACHE_STATS is set. Is called on destruction of a handle.
+void LogBinaryCacheStats(const BinaryCacheStats& stats);
+
+class BinaryCacheCounters
+{
+    public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Are called once the program is loaded or compiled, start is when the load has started.
+    void AddHit(Clock::time_point start);
+    void AddMiss(Clock::time_point start);
+    BinaryCacheStats Get() const;
+
+    private:
+    mutable std::mutex mutex;
+    BinaryCacheStats stats;
+};
+
 } // namespace miopen
 
 #endif
@@ -44,6 +44,8 @@ ClProgramPtr LoadProgram(cl_context ctx,
                          const std::string& program_name,
                          std::string params,
                          bool is_kernel_str);
+std::string GetProgramBinary(const ClProgramPtr& program);
+
 void SaveProgramBinary(const ClProgramPtr& program, const std::string& name);
 ClKernelPtr CreateKernel(cl_program program, const std::string& kernel_name);
 inline ClKernelPtr CreateKernel(const ClProgramPtr& program, const std::string& kernel_name)
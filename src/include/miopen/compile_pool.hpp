@@ -0,0 +1,95 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_COMPILE_POOL_HPP_
+#define GUARD_MIOPEN_COMPILE_POOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+/// Bounded pool of threads which build kernels in background.
+///
+/// Builds of different programs are independent, so Find may start builds of all its
+/// candidate solutions at once instead of building them one by one on demand.
+/// With a single thread, tasks are run by the submitting thread right away.
+class CompilePool
+{
+    public:
+    /// Number of threads may be set via MIOPEN_COMPILE_PARALLEL_LEVEL,
+    /// 0 is the number of hardware threads.
+    static CompilePool& Instance();
+
+    CompilePool(std::size_t threads);
+    CompilePool(const CompilePool&) = delete;
+    CompilePool& operator=(const CompilePool&) = delete;
+    ~CompilePool();
+
+    /// Queues the task. Exceptions thrown by the task are rethrown by the future.
+    template <class F>
+    auto Submit(F f) -> std::shared_future<decltype(f())>
+    {
+        using Result = decltype(f());
+        auto task    = std::make_shared<std::packaged_task<Result()>>(std::move(f));
+        auto future  = task->get_future().share();
+
+        if(workers.empty())
+        {
+            (*task)();
+            return future;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            tasks.emplace_back([task]() { (*task)(); });
+        }
+        has_tasks.notify_one();
+        return future;
+    }
+
+    std::size_t Size() const { return workers.empty() ? 1 : workers.size(); }
+
+    private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable has_tasks;
+    bool stopping = false;
+
+    void Work();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_POOL_HPP_
@@ -0,0 +1,73 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CONV_WARMUP_HPP_
+#define GUARD_MIOPEN_CONV_WARMUP_HPP_
+
+#include <miopen/convolution.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/tensor.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+
+/// Convolution problem made of a perf-db KEY, see ProblemDescription::Serialize().
+struct ConvolutionProblem
+{
+    TensorDescriptor x;
+    TensorDescriptor w;
+    TensorDescriptor y;
+    ConvolutionDescriptor conv;
+    ProblemDescription::Direction direction;
+
+    /// Throws miopenStatusBadParm if the KEY is malformed.
+    static ConvolutionProblem Parse(const std::string& key);
+};
+
+/// Reads problems from a file with a KEY per line. Lines of a perf-db file may be given as is,
+/// contents after the KEY are ignored. Empty lines and the ones starting with '#' are skipped.
+std::vector<ConvolutionProblem> ReadConvolutionProblems(const std::string& filename);
+
+struct WarmUpStats
+{
+    std::size_t problems = 0; // Problems which have solutions.
+    std::size_t programs = 0; // Programs requested, including the failed ones.
+    std::size_t failed   = 0; // Programs failed to build.
+};
+
+/// Builds programs of the direct and Winograd solutions of the problems, the same ones Find
+/// builds without exhaustive search, and so stores them into the binary cache. Solutions are
+/// taken from perf-db. No buffers are allocated and no kernels are run. Programs are built in
+/// parallel on the CompilePool.
+WarmUpStats WarmUpConvolutions(Handle& handle, const std::vector<ConvolutionProblem>& problems);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CONV_WARMUP_HPP_
@@ -26,13 +26,16 @@
 #ifndef GUARD_MIOPEN_DB_HPP_
 #define GUARD_MIOPEN_DB_HPP_
 
+#include <miopen/db_key.hpp>
 #include <miopen/db_record.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 
+#include <functional>
 #include <string>
+#include <vector>
 
 namespace boost {
 namespace filesystem {
@@ -44,10 +47,17 @@ namespace miopen {
 
 struct RecordPositions;
 class LockFile;
+class DbBinaryView;
+class DbIndex;
 
 std::string LockFilePath(const boost::filesystem::path& filename_);
 
 /// No instance of this class should be used from several threads at the same time.
+///
+/// User dbs (is_system == false) are journaled: modified records are appended to a journal
+/// file next to the db (see DbJournal) instead of rewriting the db. Records in the journal take
+/// precedence. The journal is merged into the db by Compact(), which is also done automatically
+/// once the journal grows larger than the db.
 class Db
 {
     public:
@@ -76,6 +86,19 @@ class Db
     /// Returns true if update was successful, false otherwise.
     bool UpdateRecord(DbRecord& record);
 
+    /// Same as StoreRecord() for each of the records, but takes the lock once and writes the
+    /// file in a single pass. If several records have the same key, the last one is stored.
+    ///
+    /// Returns true if store was successful, false otherwise.
+    bool StoreRecords(const std::vector<DbRecord>& records);
+
+    /// Same as UpdateRecord() for each of the records, but takes the lock once and writes the
+    /// file in a single pass. Records with the same key are merged in order, so each one
+    /// is updated with data of the previous ones.
+    ///
+    /// Returns true if update was successful, false otherwise.
+    bool UpdateRecords(std::vector<DbRecord>& records);
+
     /// Removes record with provided key from db
     ///
     /// Returns true if remove was successful, false otherwise.
@@ -95,6 +118,18 @@ class Db
 
     bool Remove(const std::string& key, const std::string& id);
 
+    /// Returns all records of the db sorted by KEY, with the journal applied.
+    std::vector<DbRecord> GetAllRecords();
+
+    /// Merges journal into the db file, see above. Does nothing for system dbs.
+    ///
+    /// Returns true if compaction was successful or not needed, false otherwise.
+    bool Compact();
+
+    /// Replaces the db and its journal by the records edit() makes out of all the actual ones.
+    /// Others are kept from modifying the db meanwhile. Records are written sorted by KEY.
+    bool Rewrite(const std::function<void(std::vector<DbRecord>&)>& edit);
+
     template <class T>
     inline bool RemoveRecord(const T& problem_config)
     {
@@ -139,10 +174,16 @@ class Db
     private:
     std::string filename;
     LockFile& lock_file;
-    const bool warn_if_unreadable;
+    const bool is_system;
+    const std::string journal_filename; // Empty if the db is not journaled.
 
     boost::optional<DbRecord> FindRecordUnsafe(const std::string& key, RecordPositions* pos);
+    bool AppendUnsafe(const std::vector<const DbRecord*>& records);
+    bool CompactUnsafe();
+    std::vector<DbRecord> GetAllRecordsUnsafe();
+    bool ReplaceUnsafe(const std::string& temp_name);
     bool FlushUnsafe(const DbRecord& record, const RecordPositions* pos);
+    bool FlushUnsafe(const std::vector<const DbRecord*>& records);
     bool StoreRecordUnsafe(const DbRecord& record);
     bool UpdateRecordUnsafe(DbRecord& record);
     bool RemoveRecordUnsafe(const std::string& key);
@@ -153,87 +194,115 @@ class Db
         const auto key = DbRecord::Serialize(problem_config);
         return FindRecordUnsafe(key, nullptr);
     }
+
+    static boost::optional<DbRecord> FindCompiledRecord(const DbBinaryView& view,
+                                                        const std::string& key);
+    static boost::optional<DbRecord> FindIndexedRecord(const DbIndex& index,
+                                                       const std::string& key,
+                                                       const std::string& filename,
+                                                       RecordPositions* pos);
+
+    friend class ReadonlyDb;
 };
 
-class MultiFileDb
+/// Read-only access to an installed db.
+///
+/// Installed dbs are never modified, so unlike Db this class takes no locks and may be used
+/// from several threads at the same time.
+class ReadonlyDb
 {
     public:
-    MultiFileDb(const std::string& installed_path, const std::string& user_path)
-        : _installed(installed_path), _user(user_path, false)
+    ReadonlyDb(const std::string& filename_) : filename(filename_) {}
+
+    /// Searches db for provided key and returns found record or none if key not found in database
+    boost::optional<DbRecord> FindRecord(const std::string& key) const;
+
+    template <class T>
+    boost::optional<DbRecord> FindRecord(const T& problem_config) const
     {
+        return FindRecord(DbRecord::Serialize(problem_config));
     }
 
-    boost::optional<DbRecord> FindRecord(const std::string& key)
+    /// See Db::Load().
+    template <class T, class V>
+    bool Load(const T& problem_config, const std::string& id, V& values) const
     {
-        auto users           = _user.FindRecord(key);
-        const auto installed = _installed.FindRecord(key);
-
-        if(users && installed)
-        {
-            users->Merge(installed.value());
-            return users;
-        }
+        const auto record = FindRecord(problem_config);
+        return record && record->GetValues(id, values);
+    }
 
-        if(users)
-            return users;
+    private:
+    std::string filename;
+};
 
-        return installed;
+/// Merges records of the installed db with records of the user db, which take precedence.
+/// Found records are kept in the process-wide DbCache, see db_cache.hpp.
+class MultiFileDb
+{
+    public:
+    MultiFileDb(const std::string& installed_path, const std::string& user_path)
+        : _installed(installed_path),
+          _user(user_path, false),
+          _installed_path(installed_path),
+          _user_path(user_path),
+          _cache_id(installed_path + '\n' + user_path)
+    {
     }
 
+    boost::optional<DbRecord> FindRecord(const std::string& key) { return FindRecord(DbKey(key)); }
+    boost::optional<DbRecord> FindRecord(const DbKey& key);
+
     template <class T>
     boost::optional<DbRecord> FindRecord(const T& problem_config)
     {
-        auto users           = _user.FindRecord(problem_config);
-        const auto installed = _installed.FindRecord(problem_config);
-
-        if(users && installed)
-        {
-            users->Merge(installed.value());
-            return users;
-        }
-
-        if(users)
-            return users;
-
-        return installed;
+        return FindRecord(DbRecord::Serialize(problem_config));
     }
 
-    bool StoreRecord(const DbRecord& record) { return _user.StoreRecord(record); }
-
-    bool UpdateRecord(DbRecord& record) { return _user.UpdateRecord(record); }
-
-    bool RemoveRecord(const std::string& key) { return _user.RemoveRecord(key); }
+    bool StoreRecord(const DbRecord& record);
+    bool UpdateRecord(DbRecord& record);
+    bool StoreRecords(const std::vector<DbRecord>& records);
+    bool UpdateRecords(std::vector<DbRecord>& records);
+    bool RemoveRecord(const std::string& key);
 
     template <class T>
     bool RemoveRecord(const T& problem_config)
     {
-        return _user.RemoveRecord(problem_config);
+        return RemoveRecord(DbRecord::Serialize(problem_config));
     }
 
     template <class T, class V>
     boost::optional<DbRecord>
     Update(const T& problem_config, const std::string& id, const V& values)
     {
-        return _user.Update(problem_config, id, values);
+        auto record = _user.Update(problem_config, id, values);
+        if(record)
+            InvalidateCache(DbKey(record->key));
+        return record;
     }
 
     template <class T, class V>
     bool Load(const T& problem_config, const std::string& id, V& values)
     {
-        if(_user.Load(problem_config, id, values))
-            return true;
-
-        return _installed.Load(problem_config, id, values);
+        const auto record = FindRecord(problem_config);
+        return record && record->GetValues(id, values);
     }
 
     template <class T>
     bool Remove(const T& problem_config, const std::string& id)
     {
-        return _user.Remove(problem_config, id);
+        const DbKey key(problem_config);
+        const auto ok = _user.Remove(key.ToString(), id);
+        InvalidateCache(key);
+        return ok;
     }
 
     private:
-    Db _installed, _user;
+    ReadonlyDb _installed;
+    Db _user;
+    std::string _installed_path, _user_path, _cache_id;
+
+    boost::optional<DbRecord> FindRecordUncached(const std::string& key);
+    void InvalidateCache(const DbKey& key);
 };
 } // namespace miopen
 
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_BINARY_HPP_
+#define GUARD_MIOPEN_DB_BINARY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <string>
+
+namespace miopen {
+
+/// Compiled (binary) form of a read-only db.
+///
+/// Installed perf-dbs are compiled at build time from the text format described in
+/// db_record.hpp. The layout is designed to be used in place, right from the memory-mapped
+/// file, without parsing:
+///
+///   DbBinaryHeader
+///   DbBinaryRecord records[n_records]; // Sorted by KEY.
+///   DbBinaryString ids[n_ids];         // Interned IDs (solver names).
+///   DbBinaryValue values[n_values];    // ID:VALUES pairs of all records.
+///   std::int32_t fields[n_fields];     // Pre-parsed VALUES.
+///   char strings[strings_size];        // KEYs, IDs and VALUES, not null-terminated.
+///
+/// All integers are in the byte order of the host which compiled the db.
+/// Text form of VALUES is preserved, so any Deserialize() still works.
+/// If VALUES consists of integer fields separated by ',', these are also stored
+/// pre-parsed (see DbRecord::GetValues).
+struct DbBinaryHeader
+{
+    static constexpr const char* Magic() { return "MIOPDB\x1a"; } // 8 bytes with terminator.
+    static constexpr std::uint32_t CurrentVersion() { return 1; }
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t n_records;
+    std::uint32_t n_ids;
+    std::uint32_t n_values;
+    std::uint32_t n_fields;
+    std::uint32_t strings_size;
+};
+
+struct DbBinaryString
+{
+    std::uint32_t offset;
+    std::uint32_t size;
+};
+
+struct DbBinaryRecord
+{
+    DbBinaryString key;
+    std::uint32_t first_value;
+    std::uint32_t n_values;
+};
+
+struct DbBinaryValue
+{
+    std::uint32_t id; // Index in ids[].
+    DbBinaryString values;
+    std::uint32_t first_field;
+    std::int32_t n_fields; // -1 if VALUES are not a list of integers.
+};
+
+/// Non-owning view of a compiled db. Does no copying, the underlying memory shall outlive it.
+class DbBinaryView
+{
+    public:
+    DbBinaryView() = default;
+    /// Validates layout. Check IsValid() before use.
+    DbBinaryView(const char* data_, std::size_t size_);
+
+    bool IsValid() const { return header != nullptr; }
+
+    /// Returns record with the given KEY or nullptr if there is none.
+    const DbBinaryRecord* Find(const std::string& key) const;
+
+    std::uint32_t RecordCount() const { return header->n_records; }
+    const DbBinaryRecord& GetRecord(std::uint32_t i) const { return records[i]; }
+    const DbBinaryValue& GetValue(const DbBinaryRecord& record, std::uint32_t i) const
+    {
+        return values[record.first_value + i];
+    }
+
+    const char* GetString(const DbBinaryString& s) const { return strings + s.offset; }
+    const DbBinaryString& GetId(const DbBinaryValue& value) const { return ids[value.id]; }
+    const std::int32_t* GetFields(const DbBinaryValue& value) const
+    {
+        return fields + value.first_field;
+    }
+
+    private:
+    const DbBinaryHeader* header   = nullptr;
+    const DbBinaryRecord* records  = nullptr;
+    const DbBinaryString* ids      = nullptr;
+    const DbBinaryValue* values    = nullptr;
+    const std::int32_t* fields     = nullptr;
+    const char* strings            = nullptr;
+};
+
+/// Compares KEYs byte-wise, the same way std::string does. Both db indices are sorted this way.
+int CompareDbKeys(const char* lhs, std::size_t lhs_size, const char* rhs, std::size_t rhs_size);
+
+/// Returns path of the compiled counterpart of a text db file.
+/// "path/name.cd.pdb.txt" -> "path/name.cd.pdb.bin"
+std::string GetDbBinaryPath(const std::string& text_path);
+
+/// Compiles text db into the binary form. Ill-formed lines, duplicate KEYs and duplicate IDs
+/// are skipped the same way the text db reader does. Returns number of records written.
+std::size_t CompileDb(std::istream& text, std::ostream& binary);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_BINARY_HPP_
@@ -0,0 +1,123 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_CACHE_HPP_
+#define GUARD_MIOPEN_DB_CACHE_HPP_
+
+#include <miopen/db_index.hpp>
+#include <miopen/db_key.hpp>
+#include <miopen/db_record.hpp>
+
+#include <boost/optional.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+
+/// Process-wide LRU cache of records found in dbs, keyed by (db, KEY).
+/// Lookups use the hash precomputed by DbKey.
+///
+/// Absence of a record is cached as well. An entry remembers stamps of the files it was
+/// read from and is ignored once any of them changes, so modifications made by other
+/// processes are noticed. Modifications made by this process shall be announced via
+/// Invalidate() as a file may be rewritten within the resolution of its timestamp.
+///
+/// All operations are MT-safe.
+class DbCache
+{
+    public:
+    using Stamps = std::array<FileStamp, 3>;
+
+    static constexpr std::size_t DefaultCapacity() { return 4096; }
+
+    DbCache(std::size_t capacity_ = DefaultCapacity()) : capacity(capacity_) {}
+    DbCache(const DbCache&) = delete;
+    DbCache& operator=(const DbCache&) = delete;
+
+    /// Capacity may be set via MIOPEN_DB_CACHE_SIZE, 0 is default.
+    static DbCache& Instance();
+
+    /// Returns true and sets the record (or none) if a valid entry was found.
+    bool Find(const std::string& db,
+              const DbKey& key,
+              const Stamps& stamps,
+              boost::optional<DbRecord>& record);
+    void Insert(const std::string& db,
+                const DbKey& key,
+                const Stamps& stamps,
+                const boost::optional<DbRecord>& record);
+    void Invalidate(const std::string& db, const DbKey& key);
+    void Invalidate(const std::string& db);
+
+    std::size_t Size() const;
+    std::size_t Hits() const;
+    std::size_t Misses() const;
+
+    private:
+    struct Id
+    {
+        std::string str;
+        std::uint64_t hash;
+
+        bool operator==(const Id& other) const { return hash == other.hash && str == other.str; }
+    };
+
+    struct IdHash
+    {
+        std::size_t operator()(const Id& id) const { return static_cast<std::size_t>(id.hash); }
+    };
+
+    struct Entry
+    {
+        Id id;
+        std::size_t db_size;
+        Stamps stamps;
+        boost::optional<DbRecord> record;
+    };
+
+    using Lru = std::list<Entry>;
+
+    const std::size_t capacity;
+    mutable std::mutex mutex;
+    Lru lru; // Most recently used first.
+    std::unordered_map<Id, Lru::iterator, IdHash> entries;
+    std::size_t hits   = 0;
+    std::size_t misses = 0;
+
+    static Id MakeId(const std::string& db, const DbKey& key)
+    {
+        return {db + '\0' + key.ToString(), key.GetHash()};
+    }
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_CACHE_HPP_
@@ -0,0 +1,166 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_INDEX_HPP_
+#define GUARD_MIOPEN_DB_INDEX_HPP_
+
+#include <miopen/db_binary.hpp>
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Identifies a particular state of a file. Is obtained by a single stat() call
+/// and used to find out if a file has been changed since it was read last time.
+struct FileStamp
+{
+    bool exists         = false;
+    std::uintmax_t size = 0;
+    std::int64_t mtime  = 0; // nanoseconds
+    std::uintmax_t node = 0;
+
+    static FileStamp Get(const std::string& filename);
+
+    bool operator==(const FileStamp& other) const
+    {
+        return exists == other.exists && size == other.size && mtime == other.mtime &&
+               node == other.node;
+    }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+};
+
+/// Read-only view of a db file.
+///
+/// The file is memory-mapped once, then a sorted index of its records is built.
+/// Lookup is O(log n) and does not allocate. Views are shared process-wide and
+/// are re-created only when the FileStamp of the file changes.
+class DbIndex
+{
+    public:
+    struct Entry
+    {
+        std::size_t begin;         // Offset of the first byte of the line.
+        std::size_t end;           // Offset of the first byte of the next line.
+        std::size_t key_size;      // KEY is at [begin, begin + key_size).
+        std::size_t contents_size; // Contents follow the '='.
+        int line;                  // For diagnostics.
+    };
+
+    DbIndex(const std::string& filename, const FileStamp& stamp_)
+        : DbIndex(filename, stamp_, false)
+    {
+    }
+    DbIndex(const DbIndex&) = delete;
+    DbIndex& operator=(const DbIndex&) = delete;
+
+    /// Returns view of the file, or nullptr if file is unreadable.
+    static std::shared_ptr<const DbIndex> Get(const std::string& filename);
+
+    /// Drops the view of the file shared by this process.
+    /// Shall be called prior to modification of the file.
+    static void Invalidate(const std::string& filename);
+
+    /// Returns the first (the last for a journal) record with the given KEY, or nullptr if
+    /// there is none.
+    const Entry* Find(const std::string& key) const;
+
+    std::string GetContents(const Entry& entry) const
+    {
+        return {Data() + entry.begin + entry.key_size + 1, entry.contents_size};
+    }
+
+    const char* Data() const { return static_cast<const char*>(region.get_address()); }
+    std::size_t Size() const { return stamp.size; }
+    const FileStamp& Stamp() const { return stamp; }
+    const std::vector<Entry>& Entries() const { return entries; }
+    bool IsJournal() const { return is_journal; }
+
+    protected:
+    DbIndex(const std::string& filename, const FileStamp& stamp_, bool is_journal_);
+
+    private:
+    FileStamp stamp;
+    boost::interprocess::mapped_region region;
+    std::vector<Entry> entries; // Sorted by KEY, stable.
+    bool is_journal;
+};
+
+/// View of a journal of a user db, see Db.
+///
+/// Records are appended to the journal instead of rewriting the db file, so it may contain
+/// several records with the same KEY, the last one being actual. A record with empty contents
+/// marks removal. A trailing line without a newline is an interrupted write and is ignored.
+class DbJournal : public DbIndex
+{
+    public:
+    DbJournal(const std::string& filename, const FileStamp& stamp_)
+        : DbIndex(filename, stamp_, true)
+    {
+    }
+
+    static std::string GetPath(const std::string& db_filename)
+    {
+        return db_filename + ".journal";
+    }
+
+    /// Returns view of the journal, or nullptr if there is none.
+    static std::shared_ptr<const DbJournal> Get(const std::string& filename);
+    static void Invalidate(const std::string& filename);
+
+    /// Returns size of the journal up to the end of its last complete line.
+    std::size_t CompleteSize() const;
+};
+
+/// Memory-mapped compiled db, see db_binary.hpp.
+/// Shared process-wide the same way as DbIndex.
+class DbBinary
+{
+    public:
+    DbBinary(const std::string& filename, const FileStamp& stamp_);
+    DbBinary(const DbBinary&) = delete;
+    DbBinary& operator=(const DbBinary&) = delete;
+
+    /// Returns view of the compiled counterpart of the text db, or nullptr if there is none,
+    /// it is invalid or older than the text db.
+    static std::shared_ptr<const DbBinary> Get(const std::string& text_filename);
+
+    const DbBinaryView& View() const { return view; }
+    const FileStamp& Stamp() const { return stamp; }
+
+    private:
+    FileStamp stamp;
+    boost::interprocess::mapped_region region;
+    DbBinaryView view;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_INDEX_HPP_
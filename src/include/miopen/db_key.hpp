@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_DB_KEY_HPP_
+#define GUARD_MIOPEN_DB_KEY_HPP_
+
+#include <miopen/fast_hash.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace miopen {
+
+/// KEY of a db record (see db_record.hpp) computed once from a problem config.
+///
+/// Formatting a problem config into KEY is not cheap, and the same problem is looked up
+/// by many solvers in a row. DbKey holds the formatted string and its 64-bit hash, and
+/// can be passed to any db API instead of the problem config itself.
+class DbKey
+{
+    public:
+    /// T shall have the "void Serialize(std::ostream&) const" member function available.
+    template <class T,
+              class = typename std::enable_if<!std::is_convertible<T, std::string>{}>::type>
+    explicit DbKey(const T& problem_config) : DbKey(Format(problem_config))
+    {
+    }
+
+    explicit DbKey(std::string str_) : str(std::move(str_)), hash(Hash(str)) {}
+
+    const std::string& ToString() const { return str; }
+    std::uint64_t GetHash() const { return hash; }
+
+    void Serialize(std::ostream& stream) const { stream << str; }
+
+    bool operator==(const DbKey& other) const { return hash == other.hash && str == other.str; }
+    bool operator!=(const DbKey& other) const { return !(*this == other); }
+
+    /// Stable across runs unlike std::hash.
+    static std::uint64_t Hash(const std::string& s) { return FastHash64(s); }
+
+    private:
+    std::string str;
+    std::uint64_t hash;
+
+    template <class T>
+    static std::string Format(const T& problem_config)
+    {
+        std::ostringstream ss;
+        problem_config.Serialize(ss);
+        return ss.str();
+    }
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_KEY_HPP_
@@ -28,12 +28,16 @@
 
 #include <miopen/config.h>
 
+#include <miopen/db_key.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/rank.hpp>
 
 #include <cassert>
 #include <sstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace miopen {
 
@@ -120,6 +124,9 @@ class DbRecord
     private:
     std::string key;
     std::unordered_map<std::string, std::string> map;
+    /// VALUES pre-parsed to integers, if available (see db_binary.hpp). Duplicates
+    /// the respective entries of map to avoid parsing of text on the hot path.
+    std::unordered_map<std::string, std::vector<int>> fields;
 
     template <class T>
     static // 'static' is for calling from ctor
@@ -131,10 +138,31 @@ class DbRecord
         return ss.str();
     }
 
+    /// KEY is already formatted, so it is not done again.
+    static const std::string& Serialize(const DbKey& key) { return key.ToString(); }
+
     bool ParseContents(const std::string& contents);
     void WriteContents(std::ostream& stream) const;
     bool SetValues(const std::string& id, const std::string& values);
     bool GetValues(const std::string& id, std::string& values) const;
+    void SetFields(const std::string& id, std::vector<int> values);
+
+    template <class T>
+    auto GetFields(rank<1>, const std::string& id, T& values) const
+        -> decltype(values.Deserialize(std::declval<const std::vector<int>&>()))
+    {
+        const auto it = fields.find(id);
+        if(it == fields.end() || !values.Deserialize(it->second))
+            return false;
+        MIOPEN_LOG_I(key << '=' << id << ':' << map.at(id) << " (pre-parsed)");
+        return true;
+    }
+
+    template <class T>
+    bool GetFields(rank<0>, const std::string&, T&) const
+    {
+        return false;
+    }
 
     DbRecord(const std::string& key_) : key(key_) {}
 
@@ -146,6 +174,8 @@ class DbRecord
     {
     }
 
+    const std::string& GetKey() const { return key; }
+
     /// Merges data from this record to data from that record if their keys are same.
     /// This record would contain all ID:VALUES pairs from that record that are not in this.
     /// E.g. this = {ID1:VALUE1}
@@ -173,6 +203,9 @@ class DbRecord
     template <class T>
     bool GetValues(const std::string& id, T& values) const
     {
+        if(GetFields(rank<1>{}, id, values))
+            return true;
+
         std::string s;
         if(!GetValues(id, s))
             return false;
@@ -197,6 +230,8 @@ class DbRecord
     }
 
     friend class Db;
+    friend class MultiFileDb;
+    friend class ReadonlyDb;
 };
 
 } // namespace miopen
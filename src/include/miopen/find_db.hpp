@@ -37,6 +37,7 @@
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/logger.hpp>
 #include <miopen/perf_field.hpp>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_ENABLE_FIND_DB)
@@ -46,17 +47,27 @@ namespace miopen {
 class FindDb
 {
     public:
+    /// Rebuilds the kernels of an algorithm the record was made with, without timing them.
+    /// Returns false if that is not possible, e.g. the solver found now is another one.
+    using Rebuilder = std::function<bool(const std::string& algorithm, const FindDbData& data)>;
+
+    /// Records made by another process refer to kernels the handle has not built yet.
+    /// Those are rebuilt, mostly from the binary cache, rather than timed anew.
     template <class TProblemDescription>
     static std::vector<PerfField> TryLoad(Handle& handle,
                                           const TProblemDescription& problem,
-                                          const std::function<void(DbRecord&)>& regenerator)
+                                          const std::function<void(DbRecord&)>& regenerator,
+                                          const Rebuilder& rebuilder)
     {
         std::vector<PerfField> ret;
         FindDb find_db{handle, problem};
 
-        if(find_db.loaded && !find_db.CopyValidating(handle, ret))
+        if(find_db.loaded && !find_db.CopyValidating(handle, ret, rebuilder))
             return ret;
 
+        // Loaded record is stale or its kernels cannot be built, so it gets replaced.
+        ret.clear();
+        find_db.loaded = false;
         find_db.record = DbRecord(problem);
         regenerator(*find_db.record);
 
@@ -80,15 +91,15 @@ class FindDb
     bool loaded = false;
 
     template <class TProblemDescription>
-    FindDb(Handle& handle, const TProblemDescription& /*problem*/)
+    FindDb(Handle& handle, const TProblemDescription& problem)
         : path(GetFindDbPath() + "/" + handle.GetDbPathFilename() + ".cd.fdb.txt"),
-          db(IsEnabled(MIOPEN_DEBUG_ENABLE_FIND_DB{}) ? boost::optional<Db>{Db{path, false}}
-                                                      : boost::none)
+          db(!IsDisabled(MIOPEN_DEBUG_ENABLE_FIND_DB{}) ? boost::optional<Db>{Db{path, false}}
+                                                        : boost::none)
     {
         if(!db.is_initialized())
             return;
 
-        record = boost::none; // db->FindRecord(problem);
+        record = db->FindRecord(problem);
         loaded = record.is_initialized();
     }
 
@@ -99,26 +110,33 @@ class FindDb
             MIOPEN_LOG_W("Failed to store record to find-db at <" << path << ">");
     }
 
-    // Returns true if rebuild is required
-    bool CopyValidating(Handle& handle, std::vector<PerfField>& to)
+    // Returns true if regeneration is required
+    bool CopyValidating(Handle& handle, std::vector<PerfField>& to, const Rebuilder& rebuilder)
     {
-        auto unbuilt = false;
-        auto any     = false;
+        auto any = false;
 
         for(const auto& pair : record->As<FindDbData>())
         {
+            // VALUES of an older format come out as the defaults.
+            if(pair.second.time < 0)
+                return true;
+
             any = true;
             to.push_back(
                 {pair.first, pair.second.solver_id, pair.second.time, pair.second.workspace});
 
-            if(loaded && (pair.second.kchache_key == FindDbData::GetUnusedKCacheKey() ||
-                          !handle.HasKernel(pair.first, pair.second.kchache_key)))
+            // Solvers which do not use kernel cache need nothing to be built.
+            if(loaded && pair.second.kchache_key != FindDbData::GetUnusedKCacheKey() &&
+               !handle.HasKernel(pair.first, pair.second.kchache_key) &&
+               !rebuilder(pair.first, pair.second))
             {
-                unbuilt = true;
+                MIOPEN_LOG_I2("Find-db: unable to rebuild " << pair.first << ", "
+                                                            << pair.second.solver_id);
+                return true;
             }
         }
 
-        return !any || unbuilt;
+        return !any;
     }
 };
 
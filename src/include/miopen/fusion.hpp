@@ -33,6 +33,7 @@
 #include <miopen/solver.hpp>
 #include <miopen/op_kernel_args.hpp>
 #include <miopen/fusion_ops.hpp>
+#include <miopen/kernel_build_params.hpp>
 
 #include <set>
 #include <vector>
@@ -68,7 +69,7 @@ struct FusionOpDescriptor : miopenFusionOpDescriptor
     int GetIdx() const { return plan_idx; };
     virtual miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) = 0;
     virtual miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle);
-    virtual miopenStatus_t GetCompileParms(std::string& compile_config,
+    virtual miopenStatus_t GetCompileParms(KernelBuildParameters& compile_config,
                                            Handle& handle,
                                            FusionKernelSourceType source,
                                            const std::vector<solver::AnySolver>& solvers);
@@ -93,7 +94,7 @@ struct BiasFusionOpDescriptor : FusionOpDescriptor
     BiasFusionOpDescriptor(TensorDescriptor& desc) : base_desc(desc){};
     miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
     miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle) override;
-    miopenStatus_t GetCompileParms(std::string& compile_config,
+    miopenStatus_t GetCompileParms(KernelBuildParameters& compile_config,
                                    Handle& handle,
                                    FusionKernelSourceType source,
                                    const std::vector<solver::AnySolver>& solvers) override;
@@ -113,7 +114,7 @@ struct ActivFwdFusionOpDescriptor : FusionOpDescriptor
     ActivFwdFusionOpDescriptor(miopenActivationMode_t mode) : activMode(mode){};
     miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
     miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle) override;
-    miopenStatus_t GetCompileParms(std::string& compile_config,
+    miopenStatus_t GetCompileParms(KernelBuildParameters& compile_config,
                                    Handle& handle,
                                    FusionKernelSourceType source,
                                    const std::vector<solver::AnySolver>& solvers) override;
@@ -138,7 +139,7 @@ struct ActivBwdFusionOpDescriptor : FusionOpDescriptor
     ActivBwdFusionOpDescriptor(miopenActivationMode_t mode) : activMode(mode){};
     miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
     miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle) override;
-    miopenStatus_t GetCompileParms(std::string& compile_config,
+    miopenStatus_t GetCompileParms(KernelBuildParameters& compile_config,
                                    Handle& handle,
                                    FusionKernelSourceType source,
                                    const std::vector<solver::AnySolver>& solvers) override;
@@ -165,7 +166,7 @@ struct BatchNormInferenceFusionOpDescriptor : FusionOpDescriptor
         : mode(bn_mode), base_desc(desc){};
     miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
     miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle) override;
-    miopenStatus_t GetCompileParms(std::string& compile_config,
+    miopenStatus_t GetCompileParms(KernelBuildParameters& compile_config,
                                    Handle& handle,
                                    FusionKernelSourceType source,
                                    const std::vector<solver::AnySolver>& solvers) override;
@@ -195,7 +196,7 @@ struct BatchNormFwdTrainFusionOpDescriptor : FusionOpDescriptor
         : mode(bn_mode), runningMeanVar(runningMeanVariance){};
     miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
     miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle) override;
-    miopenStatus_t GetCompileParms(std::string& compile_config,
+    miopenStatus_t GetCompileParms(KernelBuildParameters& compile_config,
                                    Handle& handle,
                                    FusionKernelSourceType source,
                                    const std::vector<solver::AnySolver>& solvers) override;
@@ -236,7 +237,7 @@ struct BatchNormBwdTrainFusionOpDescriptor : FusionOpDescriptor
         : mode(bn_mode), useBatchStats(true){};
     miopenStatus_t GetOutputDesc(TensorDescriptor& output_desc) override;
     miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle) override;
-    miopenStatus_t GetCompileParms(std::string& compile_config,
+    miopenStatus_t GetCompileParms(KernelBuildParameters& compile_config,
                                    Handle& handle,
                                    FusionKernelSourceType source,
                                    const std::vector<solver::AnySolver>& solvers) override;
@@ -285,7 +286,7 @@ struct ConvForwardOpDescriptor : FusionOpDescriptor
     OpKernelArg GetOpAttr(const std::string& k) const override;
     bool GetOpAttr(const std::string& sym, int& val) const override;
     miopenStatus_t GetNetworkConfig(std::string& network_config, Handle& handle) override;
-    miopenStatus_t GetCompileParms(std::string& compile_config,
+    miopenStatus_t GetCompileParms(KernelBuildParameters& compile_config,
                                    Handle& handle,
                                    FusionKernelSourceType source,
                                    const std::vector<solver::AnySolver>& solvers) override;
@@ -29,14 +29,25 @@
 
 #include <miopen/config.h>
 
+#include <algorithm>
 #include <vector>
 #include <cstdlib>
 #include <limits>
 #include <iterator>
 #include <chrono>
+#include <random>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
 
 #include <miopen/logger.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/search_checkpoint.hpp>
+#include <miopen/search_cost_model.hpp>
+#include <miopen/search_pipeline.hpp>
+#include <miopen/search_strategy.hpp>
+#include <miopen/stringutils.hpp>
 
 namespace miopen {
 namespace solver {
@@ -261,12 +272,325 @@ enum class SearchTweak
     OverrideWeightBufferSizeByWorkspaceSize,
 };
 
+/// The fastest config found by SearchBest() and its averaged time.
+template <class PerformanceConfig>
+struct SearchResult
+{
+    PerformanceConfig config;
+    float time;
+};
+
+/// The candidates of GenericSearch() for a SearchStrategy, apart from the device buffers.
+///
+/// prepare(config) returns a candidate ready to run, e.g. a solution whose programs are
+/// being built. It runs on the compile pool for the configs that follow the one being
+/// measured, see ForEachPrepared(). measure(candidate, elapsed_time) runs a candidate
+/// once on the calling thread and returns 0 on success.
+///
+/// With checkpoints, the progress is saved as the search goes, and a search which left
+/// a checkpoint of the same strategy and seed starts with its best config. Exhaustive
+/// and random searches also skip the candidates measured before, as their order only
+/// depends on the seed. The checkpoint is removed once the search completes, and kept
+/// if the budget runs out.
+template <class PerformanceConfig, class PrepareFn, class MeasureFn>
+class ConfigSearchSpace : public SearchSpace
+{
+    std::vector<PerformanceConfig> configs;
+    PrepareFn& prepare;
+    MeasureFn& measure;
+    SearchOptions options;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::unordered_map<std::string, std::size_t> index; // For Recombine().
+    SearchCheckpoints* checkpoints;
+    std::size_t skip     = 0; // Candidates measured before the search was resumed.
+    std::size_t position = 0;
+    bool is_cut          = false; // Measuring stopped as the budget ran out.
+
+    PerformanceConfig best_config;
+    bool is_passed    = false; // left false only if all iterations failed.
+    float best_time   = std::numeric_limits<float>::max();
+    size_t n_failed   = 0;
+    size_t n_current  = 0;
+    size_t n_best     = 0;
+    size_t n_runs_total;
+    HeartBeat<PerformanceConfig> heartbeat;
+
+    template <class Candidate>
+    float MeasureOne(const PerformanceConfig& current_config,
+                     const Candidate& candidate,
+                     const Averaging averaging)
+    {
+        float elapsed_time = 0.0f;
+        MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
+                          << current_config);
+
+        int ret = measure(candidate, elapsed_time);
+
+        // Smooth the jitter of measurements:
+        // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
+        // then re-run it 4 times more and compute average time,
+        // and decide using average of all 5 attempts vs. the best.
+        if(ret == 0 && (averaging == Averaging::Always ||
+                        (averaging == Averaging::IfPromising && elapsed_time / best_time < 1.05f)))
+        {
+            MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time << " = "
+                                                  << (elapsed_time / best_time));
+            float temp;
+            for(int i = 0; i < 4; ++i)
+            {
+                ret = measure(candidate, temp);
+                if(ret != 0)
+                {
+                    break;
+                }
+                elapsed_time += temp;
+            }
+            if(ret == 0)
+            {
+                is_passed = true;
+                elapsed_time /= 5;
+                if(elapsed_time < best_time)
+                {
+                    MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
+                                     << elapsed_time
+                                     << " < "
+                                     << best_time
+                                     << ' '
+                                     << current_config);
+                    best_config = current_config;
+                    best_time   = elapsed_time;
+                    n_best      = n_current;
+                }
+                else
+                {
+                    MIOPEN_LOG_I2("Average is not better: " << elapsed_time << " >= " << best_time);
+                }
+            }
+        }
+
+        if(ret != 0)
+        {
+            MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
+                             << " Failed rc="
+                             << ret);
+            ++n_failed;
+        }
+        heartbeat.Monitor(
+            ret != 0, elapsed_time, n_current, best_time, n_failed, n_runs_total, current_config);
+        ++n_current;
+        return ret == 0 ? elapsed_time : failed;
+    }
+
+    static std::string Serialize(const PerformanceConfig& config)
+    {
+        std::ostringstream ss;
+        config.Serialize(ss);
+        return ss.str();
+    }
+
+    void Resume()
+    {
+        SearchCheckpoint checkpoint;
+        if(checkpoints == nullptr || !checkpoints->Load(checkpoint))
+            return;
+        if(checkpoint.strategy != options.strategy || checkpoint.seed != options.seed ||
+           checkpoint.size != configs.size())
+        {
+            MIOPEN_LOG_W("Search checkpoint of " << checkpoint.strategy << ", seed "
+                                                 << checkpoint.seed
+                                                 << ", size "
+                                                 << checkpoint.size
+                                                 << " ignored");
+            return;
+        }
+        if(!checkpoint.best_config.empty())
+        {
+            const auto found =
+                std::find_if(configs.begin(), configs.end(), [&](const PerformanceConfig& c) {
+                    return Serialize(c) == checkpoint.best_config;
+                });
+            if(found == configs.end())
+            {
+                MIOPEN_LOG_W("Search checkpoint ignored, no such config: "
+                             << checkpoint.best_config);
+                return;
+            }
+            best_config = *found;
+            best_time   = checkpoint.best_time;
+            is_passed   = true;
+        }
+        // The order of the other strategies depends on the times measured, which are not kept.
+        if(options.strategy == SearchStrategyKind::Exhaustive ||
+           options.strategy == SearchStrategyKind::Random)
+            skip = std::min(checkpoint.position, configs.size());
+        MIOPEN_LOG_W("Resuming search at #" << skip << ", best " << best_time << ' '
+                                            << best_config);
+    }
+
+    void SaveCheckpoint(const bool force)
+    {
+        if(checkpoints == nullptr)
+            return;
+        SearchCheckpoint checkpoint;
+        checkpoint.strategy = options.strategy;
+        checkpoint.seed     = options.seed;
+        checkpoint.size     = configs.size();
+        checkpoint.position = position;
+        if(is_passed)
+        {
+            checkpoint.best_time   = best_time;
+            checkpoint.best_config = Serialize(best_config);
+        }
+        checkpoints->Save(checkpoint, force);
+    }
+
+    /// Serialized configs are comma-separated fields, see Serializable.
+    std::vector<std::string> Fields(std::size_t i) const
+    {
+        std::vector<std::string> result;
+        std::istringstream ss(Serialize(configs[i]));
+        std::string field;
+        while(std::getline(ss, field, ','))
+            result.push_back(field);
+        return result;
+    }
+
+    public:
+    template <class Container>
+    ConfigSearchSpace(const Container& all_configs,
+                      PrepareFn& prepare_,
+                      MeasureFn& measure_,
+                      const SearchOptions& options_,
+                      SearchCheckpoints* checkpoints_ = nullptr)
+        : configs(all_configs.begin(), all_configs.end()),
+          prepare(prepare_),
+          measure(measure_),
+          options(options_),
+          checkpoints(checkpoints_),
+          n_runs_total(configs.size())
+    {
+        Resume();
+        heartbeat.Start();
+    }
+
+    std::size_t Size() const override { return configs.size(); }
+
+    std::vector<float> Measure(const std::vector<std::size_t>& candidates,
+                               const Averaging averaging) override
+    {
+        std::vector<float> times(candidates.size(), failed);
+        const auto n_skipped = std::min(skip, candidates.size());
+        skip -= n_skipped;
+        position += n_skipped;
+        n_current += n_skipped;
+        std::size_t n = n_skipped;
+        ForEachPrepared(candidates.begin() + n_skipped,
+                        candidates.end(),
+                        [this](std::size_t i) { return prepare(configs[i]); },
+                        [&](std::size_t i, const auto& candidate) {
+                            if(is_passed && IsExpired())
+                            {
+                                is_cut = true;
+                                return false;
+                            }
+                            const auto was_best = best_time;
+                            times[n++]          = MeasureOne(configs[i], candidate, averaging);
+                            ++position;
+                            SaveCheckpoint(best_time < was_best);
+                            return true;
+                        });
+        return times;
+    }
+
+    std::size_t Recombine(std::size_t a, std::size_t b, std::mt19937& rng) override
+    {
+        if(index.empty())
+            for(std::size_t i = 0; i < configs.size(); ++i)
+                index.emplace(Serialize(configs[i]), i);
+
+        auto child       = Fields(a);
+        const auto other = Fields(b);
+        for(std::size_t i = 0; i < child.size() && i < other.size(); ++i)
+            if(RandomIndex(2, rng) == 0)
+                child[i] = other[i];
+
+        // Mutation: one in four children gets a field of any candidate.
+        if(!child.empty() && RandomIndex(4, rng) == 0)
+        {
+            const auto donor = Fields(RandomIndex(configs.size(), rng));
+            const auto field = RandomIndex(child.size(), rng);
+            if(field < donor.size())
+                child[field] = donor[field];
+        }
+
+        const auto it = index.find(JoinStrings(child, ","));
+        return it == index.end() ? npos : it->second;
+    }
+
+    void Plan(std::size_t measurements) override { n_runs_total = measurements; }
+
+    bool IsExpired() const override
+    {
+        return options.budget.count() != 0 &&
+               std::chrono::steady_clock::now() - start > options.budget;
+    }
+
+    SearchResult<PerformanceConfig> Finish()
+    {
+        MIOPEN_LOG_W("Done: " << n_current << '/' << n_failed << '/' << configs.size()
+                              << ", best #"
+                              << n_best
+                              << ' '
+                              << best_time
+                              << ' '
+                              << best_config);
+        if(checkpoints != nullptr)
+        {
+            if(is_cut)
+            {
+                MIOPEN_LOG_W("Search budget ran out at #" << position << ", to be resumed");
+                SaveCheckpoint(true);
+            }
+            else
+            {
+                checkpoints->Remove();
+            }
+        }
+        if(!is_passed)
+            MIOPEN_THROW("Search failed");
+        return {best_config, best_time};
+    }
+};
+
+/// The measuring part of GenericSearch(), see ConfigSearchSpace and SearchStrategy.
+template <class Container, class Prepare, class Measure>
+auto SearchBest(const Container& all_configs,
+                Prepare prepare,
+                Measure measure,
+                const SearchOptions& options     = SearchOptions::FromEnv(),
+                SearchCheckpoints* checkpoints = nullptr)
+    -> SearchResult<typename std::decay<decltype(*all_configs.begin())>::type>
+{
+    using PerformanceConfig = typename std::decay<decltype(*all_configs.begin())>::type;
+    ConfigSearchSpace<PerformanceConfig, Prepare, Measure> space(
+        all_configs, prepare, measure, options, checkpoints);
+    MakeSearchStrategy(options)->Run(space);
+    return space.Finish();
+}
+
 /// Solver member function requirements:
 /// * GetPerformanceConfig shall be implemented.
 ///   - Its return type shall be suitable for instantiation of the ComputedContainer.
 /// * GetSolution shall be implemented.
 /// * RunAndMeasureSolution shall be implemented.
 ///
+/// The programs of the next candidates are built in background while the current one
+/// is being measured. MIOPEN_COMPILE_PARALLEL_LEVEL sets the number of build threads.
+/// The candidates to measure are chosen by the strategy of the options, see SearchStrategy,
+/// among the top_k of the lowest estimated cost if set, see EstimateCost().
+/// The progress is checkpointed next to the user perf db, so a search which ran out of
+/// its budget or was killed is resumed by the next one, see ConfigSearchSpace.
+///
 /// clang-format-off
 /// -----------------------------------------------
 /// Dataflow:
@@ -289,11 +613,11 @@ enum class SearchTweak
 template <class Solver, class Context>
 auto GenericSearch(const Solver s,
                    const Context& context,
-                   const SearchTweak tweak = SearchTweak::None)
+                   const SearchTweak tweak       = SearchTweak::None,
+                   const SearchOptions& options = SearchOptions::FromEnv())
     -> decltype(s.GetPerformanceConfig(context))
 {
     using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
-    PerformanceConfig best_config;
     const auto default_solution = s.GetSolution(context, s.GetPerformanceConfig(context));
 
     // Allocate buffers, init input buffers.
@@ -328,7 +652,7 @@ auto GenericSearch(const Solver s,
     if(context.bias)
         InitRandomly(bias);
 
-    miopen::Handle profile_h;
+    auto profile_h    = context.GetStream().CreateSibling();
     auto bot_ocl_buf  = profile_h.Write(bot);
     auto top_ocl_buf  = profile_h.Write(top);
     auto wei_ocl_buf  = profile_h.Write(wei);
@@ -344,140 +668,65 @@ auto GenericSearch(const Solver s,
     const int n_runs_total = useSpare ? spare_size : main_size;
     MIOPEN_LOG_W(SolverDbId(s) << ": Searching the best solution among " << n_runs_total
                                << (useSpare ? " (spare)" : "")
+                               << ", "
+                               << options.strategy
                                << "...");
 
-    bool is_passed   = false; // left false only if all iterations failed.
-    float best_time  = std::numeric_limits<float>::max();
-    size_t n_failed  = 0;
-    size_t n_current = 0;
-    size_t n_best    = 0;
-    HeartBeat<PerformanceConfig> heartbeat;
-    heartbeat.Start();
-
-    profile_h.EnableProfiling(true);
-    for(const auto& current_config : all_configs)
-    {
-        float elapsed_time = 0.0f;
-        int ret            = 0;
-        MIOPEN_LOG_I2('#' << n_current << '/' << n_failed << '/' << n_runs_total << ' '
-                          << current_config);
-
-        const auto current_solution = s.GetSolution(context, current_config, true);
+    const auto compute_units = profile_h.GetMaxComputeUnits();
+    const auto candidates    = SelectTopCandidates<PerformanceConfig>(
+        all_configs, options.top_k, [&](const PerformanceConfig& config) {
+            return EstimateCost(s, context, config, compute_units);
+        });
+    if(candidates.size() < static_cast<std::size_t>(n_runs_total))
+        MIOPEN_LOG_W("Measuring " << candidates.size() << " of the lowest estimated cost");
+
+    const auto prepare = [&](const PerformanceConfig& config) {
+        auto solution = s.GetSolution(context, config, true);
+        for(const auto& k : solution.construction_params)
+            profile_h.BuildProgramAsync(k.kernel_file, k.comp_options);
+        return solution;
+    };
+
+    const auto measure = [&](const decltype(default_solution)& current_solution,
+                             float& elapsed_time) {
         if((tweak == SearchTweak::OverrideXBufferSizeByWorkspaceSize ||
             tweak == SearchTweak::OverrideWeightBufferSizeByWorkspaceSize) &&
            default_solution.workspce_sz != current_solution.workspce_sz)
         {
-            ret = -2;
-            MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                             << "Workspace size should not depend on PerformanceConfig: "
-                             << default_solution.workspce_sz
-                             << " != "
-                             << current_solution.workspce_sz);
-        }
-
-        if(ret == 0)
-        {
-            ret = s.RunAndMeasureSolution(profile_h,
-                                          bot_ocl_buf.get(),
-                                          top_ocl_buf.get(),
-                                          wei_ocl_buf.get(),
-                                          context.bias ? bias_ocl_buf.get() : nullptr,
-                                          context,
-                                          current_solution,
-                                          elapsed_time);
-        }
-
-        if(ret == 0)
-        {
-            // Smooth the jitter of measurements:
-            // If the 1st probe is NOT too bad (measured time <= 1.05 * best known time),
-            // then re-run it 4 times more and compute average time,
-            // and decide using average of all 5 attempts vs. the best.
-            if(elapsed_time / best_time < 1.05f)
-            {
-                MIOPEN_LOG_I2("Finding average for: " << elapsed_time << " / " << best_time << " = "
-                                                      << (elapsed_time / best_time));
-                float temp;
-                for(int i = 0; i < 4; ++i)
-                {
-                    ret = s.RunAndMeasureSolution(profile_h,
-                                                  bot_ocl_buf.get(),
-                                                  top_ocl_buf.get(),
-                                                  wei_ocl_buf.get(),
-                                                  context.bias ? bias_ocl_buf.get() : nullptr,
-                                                  context,
-                                                  current_solution,
-                                                  temp);
-                    if(ret != 0)
-                    {
-                        break;
-                    }
-                    elapsed_time += temp;
-                }
-                if(ret == 0)
-                {
-                    is_passed = true;
-                    elapsed_time /= 5;
-                    if(elapsed_time < best_time)
-                    {
-                        MIOPEN_LOG_I('#' << n_current << '/' << n_failed << '/' << n_runs_total
-                                         << ' '
-                                         << elapsed_time
-                                         << " < "
-                                         << best_time
-                                         << ' '
-                                         << current_config);
-                        best_config = current_config;
-                        best_time   = elapsed_time;
-                        n_best      = n_current;
-                    }
-                    else
-                    {
-                        MIOPEN_LOG_I2(
-                            "Average is not better: " << elapsed_time << " >= " << best_time);
-                    }
-                }
-            }
-        }
-
-        if(ret != 0)
-        {
-            MIOPEN_LOG_E('#' << n_current << " (" << n_runs_total << ") "
-                             << " Failed rc="
-                             << ret);
-            ++n_failed;
+            MIOPEN_LOG_E("Workspace size should not depend on PerformanceConfig: "
+                         << default_solution.workspce_sz
+                         << " != "
+                         << current_solution.workspce_sz);
+            return -2;
         }
-        heartbeat.Monitor(
-            ret != 0, elapsed_time, n_current, best_time, n_failed, n_runs_total, current_config);
-        ++n_current;
-    }
 
+        return s.RunAndMeasureSolution(profile_h,
+                                       bot_ocl_buf.get(),
+                                       top_ocl_buf.get(),
+                                       wei_ocl_buf.get(),
+                                       context.bias ? bias_ocl_buf.get() : nullptr,
+                                       context,
+                                       current_solution,
+                                       elapsed_time);
+    };
+
+    SearchCheckpoints checkpoints(context.GetSearchCheckpointPath(), DbKey(context), SolverDbId(s));
+    profile_h.EnableProfiling(true);
+    const auto best = SearchBest(candidates, prepare, measure, options, &checkpoints);
     profile_h.EnableProfiling(false);
-    MIOPEN_LOG_W("Done: " << n_runs_total << '/' << n_failed << '/' << n_runs_total << ", best #"
-                          << n_best
-                          << ' '
-                          << best_time
-                          << ' '
-                          << best_config);
-    if(!is_passed)
-        MIOPEN_THROW("Search failed");
+    // The candidates prepared ahead of a budget cut are still being built.
+    profile_h.FinishBuilds();
+
     // Run once with the default config and show score.
     float default_time = 0.0f;
     profile_h.EnableProfiling(true);
-    if(s.RunAndMeasureSolution(profile_h,
-                               bot_ocl_buf.get(),
-                               top_ocl_buf.get(),
-                               wei_ocl_buf.get(),
-                               context.bias ? bias_ocl_buf.get() : nullptr,
-                               context,
-                               default_solution,
-                               default_time) == 0)
+    if(measure(default_solution, default_time) == 0)
     {
-        const float score = (best_time > 0.0f) ? default_time / best_time : 0.0f;
+        const float score = (best.time > 0.0f) ? default_time / best.time : 0.0f;
         MIOPEN_LOG_W("...Score: " << score << " (default time " << default_time << ')');
     }
     profile_h.EnableProfiling(false);
-    return best_config;
+    return best.config;
 }
 
 } // namespace solver
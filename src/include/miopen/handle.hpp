@@ -36,7 +36,6 @@
 #include <miopen/object.hpp>
 #include <miopen/allocator.hpp>
 #include <miopen/simple_hash.hpp>
-#include <boost/range/adaptor/transformed.hpp>
 #include <vector>
 #include <unordered_map>
 
@@ -48,6 +47,7 @@
 namespace miopen {
 
 struct HandleImpl;
+struct BinaryCacheStats;
 #if MIOPEN_USE_MIOPENGEMM
 struct GemmGeometry;
 using GemmKey = std::pair<std::string, std::string>;
@@ -68,6 +68,10 @@ struct Handle : miopenHandle
     miopenAcceleratorQueue_t GetStream() const;
     void SetStream(miopenAcceleratorQueue_t streamID) const;
 
+    /// Creates a handle with a queue of its own on the context and device of this one, so that
+    /// it shares the programs of this handle. Searches measure kernels on such a handle.
+    Handle CreateSibling() const;
+
     void SetAllocator(miopenAllocatorFunction allocator,
                       miopenDeallocatorFunction deallocator,
                       void* allocatorContext) const;
@@ -89,32 +93,52 @@ struct Handle : miopenHandle
                            const std::string& params,
                            std::size_t cache_index = 0);
 
+    /// Starts building of the program in background, so a later AddKernel() with the same
+    /// program and params finds it built. See KernelCache::BuildProgramAsync().
+    void BuildProgramAsync(const std::string& program_name, const std::string& params);
+
+    /// Waits for the programs started by BuildProgramAsync(). Returns the number of failed builds.
+    std::size_t FinishBuilds();
+
     bool HasKernel(const std::string& algorithm, const std::string& network_config) const;
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
 
-    auto GetKernels(const std::string& algorithm, const std::string& network_config)
+    std::vector<KernelInvoke> GetKernels(const std::string& algorithm,
+                                         const std::string& network_config)
     {
-        return this->GetKernelsImpl(algorithm, network_config) |
-               boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
+        const auto kernels = this->GetKernelsImpl(algorithm, network_config);
+        std::vector<KernelInvoke> result;
+        result.reserve(kernels->size());
+        for(const auto& k : *kernels)
+            result.push_back(this->Run(k));
+        return result;
     }
     KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config)
     {
-        auto ks = this->GetKernelsImpl(algorithm, network_config);
-        if(ks.empty())
+        const auto ks = this->GetKernelsImpl(algorithm, network_config);
+        if(ks->empty())
         {
             MIOPEN_THROW("looking for default kernel (does not exist): " + algorithm + ", " +
                          network_config);
         }
-        return this->Run(ks.front());
+        return this->Run(ks->front());
     }
 
     KernelInvoke Run(Kernel k);
-    const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
-                                              const std::string& network_config);
+    /// Returned kernels stay valid while referenced, see KernelCache.
+    std::shared_ptr<const std::vector<Kernel>> GetKernelsImpl(const std::string& algorithm,
+                                                              const std::string& network_config);
 
     Program LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str);
 
+    /// Counts the programs this handle has loaded from the binary cache or compiled.
+    BinaryCacheStats GetBinaryCacheStats() const;
+
+    /// Identifies the context programs of the handle are built for. Handles with the same
+    /// scope share programs via ProgramRegistry.
+    const void* GetProgramScope() const;
+
     void Finish() const;
     void Flush() const;
 
@@ -39,10 +39,13 @@ struct HIPOCProgram
 {
     HIPOCProgram();
     HIPOCProgram(const std::string& program_name, std::string params, bool is_kernel_str);
-    HIPOCProgram(const std::string& program_name, const boost::filesystem::path& hsaco);
+    /// Loads the program from the contents of a code object file.
+    HIPOCProgram(const std::string& program_name, const std::string& hsaco_binary);
     std::shared_ptr<const HIPOCProgramImpl> impl;
     hipModule_t GetModule() const;
-    boost::filesystem::path GetBinary() const;
+    /// Returns the code object built, which is empty if the program has been loaded from one.
+    const std::string& GetBinary() const;
+    const std::string& GetName() const;
 };
 } // namespace miopen
 
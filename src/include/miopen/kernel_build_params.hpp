@@ -122,6 +122,11 @@ class KernelBuildParameters
         return TFor::Generate(options);
     }
 
+    /// Sorts defines by name and drops repeated identical ones, so that equal sets of
+    /// parameters generate equal strings. Options go first and keep their relative order,
+    /// which may matter to the compiler.
+    void Canonicalize();
+
     private:
     std::vector<KernelBuildParameter> options = {};
 
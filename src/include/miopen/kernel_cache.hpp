@@ -47,6 +47,10 @@
 #include <miopen/kernel.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -56,14 +60,20 @@ namespace miopen {
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * All operations are MT-safe. Lookups of kernels take no locks: they read a snapshot of the
+ * kernel map, which writers replace as a whole (copy on write). Sets of kernels returned are
+ * never modified, so they stay valid while referenced regardless of later writes.
  */
 class KernelCache
 {
 
     public:
     using Key        = std::pair<std::string, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
+    using Kernels    = std::vector<Kernel>;
+    using KernelsPtr = std::shared_ptr<const Kernels>;
+    using KernelMap  = std::unordered_map<Key, KernelsPtr, SimpleHash>;
     using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    using PendingMap = std::unordered_map<Key, std::shared_future<Program>, SimpleHash>;
 
     Kernel AddKernel(Handle& h,
                      const std::string& algorithm,
@@ -77,18 +87,51 @@ class KernelCache
 
     void AddKernel(Key key, Kernel k, std::size_t cache_index);
 
+    /// Starts building of the program on the CompilePool unless it is built or being built
+    /// already. AddKernel() picks the result up, waiting for the build to finish if needed.
+    /// Handle shall not be moved while builds are pending. It finishes them when destroyed.
+    ///
+    /// Programs are taken from the process-wide ProgramRegistry when other handles with the
+    /// same scope have built them already.
+    void BuildProgramAsync(Handle& h,
+                           const std::string& program_name,
+                           std::string params,
+                           bool is_kernel_str = false);
+
+    /// Waits for the BuildProgramAsync() builds and keeps the programs built.
+    /// Returns the number of builds which have failed.
+    std::size_t FinishBuilds();
+
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
 
-    const std::vector<Kernel>& GetKernels(const std::string& algorithm,
-                                          const std::string& network_config);
+    /// Returns an empty set if there are no kernels for the key.
+    KernelsPtr GetKernels(const std::string& algorithm, const std::string& network_config) const;
 
     bool HasKernels(const std::string& algorithm, const std::string& network_config) const;
 
     KernelCache();
+    KernelCache(const KernelCache&) = delete;
+    KernelCache& operator=(const KernelCache&) = delete;
+    /// Releases the programs in the ProgramRegistry. Pending builds refer to the Handle
+    /// owning the cache, which shall finish them before the cache is destroyed.
+    ~KernelCache();
 
     private:
-    KernelMap kernel_map;
+    std::shared_ptr<const KernelMap> kernel_map; // Accessed via std::atomic_load/store.
+    std::mutex kernel_mutex;                     // Serializes writers of kernel_map.
     ProgramMap program_map;
+    PendingMap pending_programs;
+    std::mutex program_mutex;    // Guards program_map, pending_programs and scope.
+    const void* scope = nullptr; // See Handle::GetProgramScope().
+
+    void ModifyKernels(const std::function<void(KernelMap&)>& modify);
+
+    /// Looks for a built program, waiting for the BuildProgramAsync() one if needed.
+    bool FindProgram(const Key& key, Program& program);
+    void StoreProgram(const Key& key, const Program& program);
+    std::shared_future<Program>
+    AcquireProgram(Handle& h, const Key& key, bool is_kernel_str, bool async);
+    Program GetProgram(const Key& key, const std::shared_future<Program>& program);
 };
 
 } // namespace miopen
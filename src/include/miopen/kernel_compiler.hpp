@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_KERNEL_COMPILER_HPP_
+#define GUARD_MIOPEN_KERNEL_COMPILER_HPP_
+
+#include <miopen/tmp_dir.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+/// Compiles kernel sources into code objects, in memory as far as the compiler allows.
+///
+/// An in-process compiler library shall implement this interface. Without one,
+/// ExternalCompiler runs the compiler executable.
+class KernelCompiler
+{
+    public:
+    virtual ~KernelCompiler() = default;
+
+    /// Returns the contents of the code object. The filename tells the source language
+    /// and is shown in diagnostics. Throws if the compilation fails.
+    virtual std::string
+    Compile(const std::string& filename, const std::string& src, const std::string& options) = 0;
+};
+
+/// Runs "<executable> <options> <source> -o <object>" with a scratch directory as the
+/// working directory, so that whatever else the compiler writes is cleaned up with it.
+///
+/// Scratch directories are pooled: one is taken per compilation running at the moment and
+/// cleaned up for reuse afterwards, instead of creating and removing a directory per kernel.
+/// The compiler is started with posix_spawn() directly. Only options with quotes or other
+/// shell syntax are passed through the shell.
+class ExternalCompiler : public KernelCompiler
+{
+    public:
+    explicit ExternalCompiler(std::string executable_);
+
+    std::string Compile(const std::string& filename,
+                        const std::string& src,
+                        const std::string& options) override;
+
+    /// Number of scratch directories created so far.
+    std::size_t ScratchDirs() const;
+
+    private:
+    std::string executable;
+    mutable std::mutex mutex;
+    std::vector<std::unique_ptr<TmpDir>> idle; // Guarded by mutex.
+    std::size_t created = 0;                   // Guarded by mutex.
+
+    std::unique_ptr<TmpDir> AcquireDir();
+    void ReleaseDir(std::unique_ptr<TmpDir> dir);
+};
+
+/// Runs the program with the arguments in the working directory, if one is given, and waits
+/// for it to exit. Returns its exit code, or -1 if it has not exited normally.
+int SpawnProcess(const std::vector<std::string>& args, const std::string& cwd = "");
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_KERNEL_COMPILER_HPP_
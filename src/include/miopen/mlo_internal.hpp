@@ -64,6 +64,7 @@ POSSIBILITY OF SUCH DAMAGE.
 #endif
 #include <miopen/db_path.hpp>
 #include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
 #include <miopen/problem_description.hpp>
 
 #if MIOPEN_BACKEND_OPENCL
@@ -179,7 +180,7 @@ size_t setBotDfDescFromMLDesc(TTo& to, const TensorDescriptor& tensor)
 struct ConvolutionContext : ProblemDescription
 {
     // Solution-specific
-    std::string general_compile_options;
+    KernelBuildParameters general_compile_options;
     // Operation modes & environment
     bool do_search                         = false;
     bool save_srch_req                     = false;
@@ -222,6 +223,17 @@ struct ConvolutionContext : ProblemDescription
         // clang-format on
     }
 
+    /// Progress of interrupted searches, see SearchCheckpoints.
+    std::string GetSearchCheckpointPath() const
+    {
+        // clang-format off
+        return GetUserDbPath()
+             + "/"
+             + GetStream().GetDbPathFilename()
+             + ".cd.ckpt.txt";
+        // clang-format on
+    }
+
     private:
     Handle* _stream = nullptr;
 };
@@ -377,9 +389,11 @@ struct mlo_construct_direct2D
     /*
      * get common compiler options
      */
-    inline const std::string& getGeneralCompOptions() const
+    inline std::string getGeneralCompOptions() const
     {
-        return (_search_params.general_compile_options);
+        const auto options =
+            _search_params.general_compile_options.GenerateFor(miopen::kbp::OpenCL{});
+        return options.empty() ? options : " " + options;
     }
 
     /*
@@ -556,9 +570,9 @@ struct mlo_construct_direct2D
     /*
      * set common compiler options
      */
-    inline void setGeneralCompOptions(const std::string& options)
+    inline void setGeneralCompOptions(const miopen::KernelBuildParameters& options)
     {
-        _search_params.general_compile_options += options;
+        _search_params.general_compile_options << options;
     }
 
     inline void setWorkaroundDisableSearchEnforce(bool v)
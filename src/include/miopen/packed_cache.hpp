@@ -0,0 +1,178 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_PACKED_CACHE_HPP_
+#define GUARD_MIOPEN_PACKED_CACHE_HPP_
+
+#include <miopen/db_index.hpp>
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+/// Single-file store of compiled programs, see binary_cache.hpp.
+///
+///   PackedCacheHeader
+///   { PackedCacheRecord, char key[key_size], char blob[blob_size] }*
+///
+/// All integers are in the byte order of the host which wrote the file. A file of another
+/// version is ignored by readers and discarded by the next append.
+/// Records are only ever appended, under an exclusive file lock. If a KEY occurs more
+/// than once, the last record wins. An incomplete trailing record is left by an interrupted
+/// append; it is ignored by readers and truncated by the next append.
+///
+/// The only in-place modification is the update of last_use of a record. When the file
+/// exceeds the size limit, the least recently used records are evicted: the rest is written
+/// to a new file which replaces the old one.
+struct PackedCacheHeader
+{
+    static constexpr const char* Magic() { return "MIOPKC\x1a"; } // 8 bytes with terminator.
+    static constexpr std::uint32_t CurrentVersion() { return 2; }
+
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t generation; // Random, changes when the file is replaced.
+};
+
+struct PackedCacheRecord
+{
+    std::uint32_t key_size;
+    std::uint32_t last_use; // Seconds since epoch.
+    std::uint64_t blob_size;
+    std::uint64_t checksum; // FastHash64 of the blob.
+};
+
+/// Read-only memory-mapped view of a packed cache file.
+class PackedCacheView
+{
+    public:
+    struct Entry
+    {
+        std::size_t record_offset;
+        std::size_t blob_offset;
+        std::size_t blob_size;
+        std::uint64_t checksum;
+    };
+
+    /// Maps the file and indexes its records. If the previous view of the same file is
+    /// given, and the file has only been appended to since, records it has indexed are
+    /// not scanned again.
+    PackedCacheView(const std::string& filename,
+                    const FileStamp& stamp_,
+                    const PackedCacheView* previous = nullptr);
+    PackedCacheView(const PackedCacheView&) = delete;
+    PackedCacheView& operator=(const PackedCacheView&) = delete;
+
+    /// Returns the actual record with the given KEY, or nullptr if there is none.
+    const Entry* Find(const std::string& key) const;
+
+    /// Returns false if the blob does not match its checksum.
+    bool IsIntact(const Entry& entry) const;
+
+    /// Reads last_use as it is in the file now, which other processes may update.
+    std::uint32_t GetLastUse(const Entry& entry) const;
+
+    const char* Data() const { return static_cast<const char*>(region.get_address()); }
+    const FileStamp& Stamp() const { return stamp; }
+    const std::unordered_map<std::string, Entry>& Entries() const { return entries; }
+
+    /// Size of the file up to the end of its last complete record.
+    /// Is 0 if the file is empty, has unknown format or unsupported version.
+    std::size_t CompleteSize() const { return complete_size; }
+
+    private:
+    FileStamp stamp;
+    boost::interprocess::mapped_region region;
+    std::unordered_map<std::string, Entry> entries;
+    std::size_t complete_size = 0;
+    std::uint32_t generation  = 0;
+};
+
+/// Process-wide accessor of a packed cache file.
+///
+/// Lookups which hit the current view do no system calls. On a miss, the file is
+/// checked for appends made by other handles or processes, and re-mapped if it has grown.
+class PackedCache
+{
+    public:
+    explicit PackedCache(std::string filename_);
+    PackedCache(const PackedCache&) = delete;
+    PackedCache& operator=(const PackedCache&) = delete;
+    ~PackedCache();
+
+    /// Returns the shared instance for the file.
+    static PackedCache& Get(const std::string& filename);
+
+    /// Returns the blob stored under the KEY, or an empty string if there is none.
+    /// Updates last use of the record, unless it has been used within the last hour.
+    std::string Load(const std::string& key);
+
+    /// Appends the record unless there is one with the same KEY already.
+    /// Returns false if the file is unwritable.
+    bool Store(const std::string& key, const std::string& blob);
+
+    /// Appends records in one go, skipping the ones with KEYs already present.
+    /// Returns the number of records appended, or -1 if the file is unwritable.
+    int Store(const std::vector<std::pair<std::string, std::string>>& records);
+
+    /// Calls f for each actual record, in no particular order.
+    void
+    Visit(const std::function<void(const std::string& key, const char* blob, std::size_t size)>& f);
+
+    const std::string& GetFilename() const { return filename; }
+
+    /// Once the file grows above the limit, the least recently used records are evicted
+    /// down to 3/4 of it, so that the file is not rewritten on each append.
+    /// 0 means no limit, which is the default.
+    void SetSizeLimit(std::uint64_t bytes) { size_limit = bytes; }
+
+    private:
+    std::string filename;
+    std::mutex mutex; // Guards view and the usage file.
+    std::shared_ptr<const PackedCacheView> view;
+    std::atomic<std::uint64_t> size_limit{0};
+    int usage_fd              = -1; // Is used to update last_use.
+    std::uintmax_t usage_node = 0;
+
+    std::shared_ptr<const PackedCacheView> GetView();
+    std::shared_ptr<const PackedCacheView> Refresh();
+    void Touch(const PackedCacheView& current, const PackedCacheView::Entry& entry);
+    void EvictUnsafe(const PackedCacheView& current, std::uint64_t limit);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_PACKED_CACHE_HPP_
@@ -52,14 +52,30 @@ struct FindDbData : solver::Serializable<FindDbData>
     /// kchache_key may have a special value <unused>. It means that the particular solver doesn't
     /// use kernel cache and doesn't require a validation of built kernel existance.
     std::string kchache_key;
+    /// Fingerprint of the kernels the record was made with, so that a solver which builds other
+    /// kernels now (e.g. with another tuned config) is caught. <unused> for the solvers which
+    /// have nothing to tune.
+    std::string kernels;
 
-    FindDbData() : solver_id("<unknown>"), time(-1), workspace(-1), kchache_key("<unknown>") {}
+    FindDbData()
+        : solver_id("<unknown>"),
+          time(-1),
+          workspace(-1),
+          kchache_key("<unknown>"),
+          kernels("<unknown>")
+    {
+    }
 
     FindDbData(const std::string& solver_id_,
                float time_,
                std::size_t workspace_,
-               const std::string& kchache_key_)
-        : solver_id(solver_id_), time(time_), workspace(workspace_), kchache_key(kchache_key_)
+               const std::string& kchache_key_,
+               const std::string& kernels_ = GetUnusedKCacheKey())
+        : solver_id(solver_id_),
+          time(time_),
+          workspace(workspace_),
+          kchache_key(kchache_key_),
+          kernels(kernels_)
     {
     }
 
@@ -70,6 +86,7 @@ struct FindDbData : solver::Serializable<FindDbData>
         f(self.time, "time");
         f(self.workspace, "workspace");
         f(self.kchache_key, "kchache_key");
+        f(self.kernels, "kernels");
     }
 };
 
@@ -0,0 +1,128 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#ifndef GUARD_MIOPEN_PROGRAM_REGISTRY_HPP_
+#define GUARD_MIOPEN_PROGRAM_REGISTRY_HPP_
+
+#include <miopen/fast_hash.hpp>
+#include <miopen/kernel.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace miopen {
+
+/// Process-wide registry of built programs, shared by all handles.
+///
+/// Programs are built for a context, so they are registered under a scope which identifies
+/// it (see Handle::GetProgramScope()) besides program name and build params. Handles ask the
+/// registry before building a program or reading it from the binary cache, and identical
+/// builds running at the same time are done once.
+///
+/// Each Acquire() adds a reference to the program, which shall be dropped by Release().
+/// Programs without references stay registered until more than IdleCapacity() of them
+/// collect, least recently released go first. Forget() drops idle programs of a scope,
+/// e.g. when its context is destroyed.
+///
+/// All operations are MT-safe.
+class ProgramRegistry
+{
+    public:
+    struct Key
+    {
+        const void* scope;
+        std::string program_name;
+        std::string params;
+
+        bool operator==(const Key& other) const
+        {
+            return scope == other.scope && program_name == other.program_name &&
+                   params == other.params;
+        }
+    };
+
+    using Build = std::function<Program()>;
+
+    static constexpr std::size_t DefaultIdleCapacity() { return 64; }
+
+    ProgramRegistry(std::size_t idle_capacity_ = DefaultIdleCapacity())
+        : idle_capacity(idle_capacity_)
+    {
+    }
+    ProgramRegistry(const ProgramRegistry&) = delete;
+    ProgramRegistry& operator=(const ProgramRegistry&) = delete;
+
+    /// Idle capacity may be set via MIOPEN_PROGRAM_REGISTRY_IDLE_SIZE, 0 is default.
+    static ProgramRegistry& Instance();
+
+    /// Returns the registered program or registers the one made by build. The build is run
+    /// in place, or on the CompilePool if async is set. Build errors are delivered through
+    /// the future, and the next Acquire() of the key tries to build it again.
+    std::shared_future<Program> Acquire(const Key& key, const Build& build, bool async);
+    void Release(const Key& key);
+    void Forget(const void* scope);
+
+    std::size_t Size() const;
+    std::size_t Hits() const;
+    std::size_t Misses() const;
+
+    private:
+    struct KeyHash
+    {
+        std::size_t operator()(const Key& key) const
+        {
+            const auto names = FastHash64(key.params, FastHash64(key.program_name));
+            return std::hash<const void*>{}(key.scope) ^ static_cast<std::size_t>(names);
+        }
+    };
+
+    using Idle = std::list<Key>; // Most recently released first.
+
+    struct Entry
+    {
+        std::shared_future<Program> program;
+        std::size_t references;
+        Idle::iterator idle_position;
+    };
+
+    const std::size_t idle_capacity;
+    mutable std::mutex mutex;
+    std::unordered_map<Key, Entry, KeyHash> entries;
+    Idle idle;
+    std::size_t hits   = 0;
+    std::size_t misses = 0;
+
+    void AddReference(Entry& entry);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_PROGRAM_REGISTRY_HPP_
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_CHECKPOINT_HPP_
+#define GUARD_MIOPEN_SEARCH_CHECKPOINT_HPP_
+
+#include <miopen/db_key.hpp>
+#include <miopen/search_strategy.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <ostream>
+#include <string>
+
+namespace miopen {
+namespace solver {
+
+/// Progress of a search, see SearchCheckpoints.
+struct SearchCheckpoint
+{
+    SearchStrategyKind strategy = SearchStrategyKind::Default_;
+    unsigned seed               = 0;
+    /// Number of candidates of the search, as a smaller or larger space has another order.
+    std::size_t size = 0;
+    /// Number of candidates measured so far, in the order chosen by the strategy.
+    std::size_t position = 0;
+    float best_time      = std::numeric_limits<float>::max();
+    /// Serialized best config, empty if none has passed yet.
+    std::string best_config;
+
+    /// STRATEGY,SEED,SIZE,POSITION,BEST_TIME,BEST_CONFIG where BEST_CONFIG takes the rest.
+    void Serialize(std::ostream& stream) const;
+    bool Deserialize(const std::string& str);
+};
+
+/// Keeps the progress of a search in a side db, under the same KEY and ID as the perf db
+/// record the search is going to produce. A search which ran out of its budget or was
+/// killed is then resumed by the next one instead of starting over.
+///
+/// Saves are throttled to one per interval unless forced.
+class SearchCheckpoints
+{
+    public:
+    SearchCheckpoints(std::string path_,
+                      DbKey key_,
+                      std::string id_,
+                      std::chrono::milliseconds interval_ = std::chrono::seconds{10});
+
+    bool Load(SearchCheckpoint& checkpoint) const;
+    bool Exists() const;
+    void Save(const SearchCheckpoint& checkpoint, bool force = false);
+    void Remove();
+
+    private:
+    std::string path;
+    DbKey key;
+    std::string id;
+    std::chrono::milliseconds interval;
+    std::chrono::steady_clock::time_point last_save;
+    bool saved = false;
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_CHECKPOINT_HPP_
@@ -0,0 +1,118 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_COST_MODEL_HPP_
+#define GUARD_MIOPEN_SEARCH_COST_MODEL_HPP_
+
+#include <miopen/rank.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+
+struct ConvolutionContext;
+
+namespace solver {
+
+struct ConvSolution;
+
+/// Rough cost of running a solution on a device of the given number of compute units,
+/// only meant to rank the candidates of one search against each other.
+///
+/// Every kernel of the solution runs its waves in rounds of one wave per SIMD, the last
+/// round possibly partly idle, and each wave does an equal share of the work of the
+/// problem. The waves come from the work sizes, which grp_tile0/1 set for OpenCL kernels.
+/// The outputs a work item computes from the same inputs (out_pix_tile0/1,
+/// n_out_pix_tiles, n_stacks) save memory traffic.
+float EstimateSolutionCost(const ConvolutionContext& context,
+                           const ConvSolution& solution,
+                           std::size_t compute_units);
+
+template <class Solver, class Context, class PerformanceConfig>
+auto EstimateCostImpl(rank<1>,
+                      const Solver& s,
+                      const Context& context,
+                      const PerformanceConfig& config,
+                      std::size_t compute_units)
+    -> decltype(s.EstimateCost(context, config, compute_units))
+{
+    return s.EstimateCost(context, config, compute_units);
+}
+
+template <class Solver, class Context, class PerformanceConfig>
+float EstimateCostImpl(rank<0>,
+                       const Solver& s,
+                       const Context& context,
+                       const PerformanceConfig& config,
+                       std::size_t compute_units)
+{
+    return EstimateSolutionCost(context, s.GetSolution(context, config, true), compute_units);
+}
+
+/// Solvers which know their kernels better may implement
+/// float EstimateCost(const Context&, const PerformanceConfig&, std::size_t compute_units),
+/// otherwise the cost is estimated from the solution, see EstimateSolutionCost().
+template <class Solver, class Context, class PerformanceConfig>
+float EstimateCost(const Solver& s,
+                   const Context& context,
+                   const PerformanceConfig& config,
+                   std::size_t compute_units)
+{
+    return EstimateCostImpl(rank<1>{}, s, context, config, compute_units);
+}
+
+/// Returns the k configs of the lowest cost in their original order, or all if k is 0.
+template <class PerformanceConfig, class Container, class Cost>
+std::vector<PerformanceConfig>
+SelectTopCandidates(const Container& all_configs, std::size_t k, Cost cost)
+{
+    std::vector<PerformanceConfig> configs(all_configs.begin(), all_configs.end());
+    if(k == 0 || configs.size() <= k)
+        return configs;
+
+    std::vector<std::pair<float, std::size_t>> ranked;
+    ranked.reserve(configs.size());
+    for(std::size_t i = 0; i < configs.size(); ++i)
+        ranked.emplace_back(cost(configs[i]), i);
+    // Ties go to the earlier config, so the selection does not depend on the sort.
+    std::nth_element(ranked.begin(), ranked.begin() + k, ranked.end());
+    std::sort(ranked.begin(), ranked.begin() + k, [](const auto& a, const auto& b) {
+        return a.second < b.second;
+    });
+
+    std::vector<PerformanceConfig> result;
+    result.reserve(k);
+    for(std::size_t i = 0; i < k; ++i)
+        result.push_back(configs[ranked[i].second]);
+    return result;
+}
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_COST_MODEL_HPP_
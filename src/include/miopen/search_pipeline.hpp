@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_PIPELINE_HPP_
+#define GUARD_MIOPEN_SEARCH_PIPELINE_HPP_
+
+#include <miopen/compile_pool.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <type_traits>
+#include <utility>
+
+namespace miopen {
+
+/// Calls consume(item, prepare(item)) for each item of [first, last), in order.
+///
+/// prepare() runs on the pool for up to `depth` items ahead of the one being consumed,
+/// so, for instance, the next candidates of a search compile while the current one is
+/// being timed. consume() runs on the calling thread and returns false to stop the walk.
+/// An exception thrown by either stops the walk and is rethrown once the preparations in
+/// flight are done.
+template <class Iterator, class Prepare, class Consume>
+void ForEachPrepared(Iterator first,
+                     Iterator last,
+                     std::size_t depth,
+                     CompilePool& pool,
+                     Prepare prepare,
+                     Consume consume)
+{
+    using Item     = typename std::decay<decltype(*first)>::type;
+    using Prepared = decltype(prepare(std::declval<const Item&>()));
+    std::deque<std::pair<Item, std::shared_future<Prepared>>> queue;
+    depth = std::max<std::size_t>(depth, 1);
+
+    const auto fill = [&]() {
+        while(queue.size() < depth && first != last)
+        {
+            Item item = *first;
+            ++first;
+            auto prepared = pool.Submit([&prepare, item]() { return prepare(item); });
+            queue.emplace_back(std::move(item), std::move(prepared));
+        }
+    };
+
+    // The tasks refer to prepare, which goes away on return.
+    const auto wait_all = [&]() {
+        for(const auto& pending : queue)
+            pending.second.wait();
+    };
+
+    try
+    {
+        fill();
+        while(!queue.empty())
+        {
+            auto current = std::move(queue.front());
+            queue.pop_front();
+            fill();
+            if(!consume(current.first, current.second.get()))
+                break;
+        }
+    }
+    catch(...)
+    {
+        wait_all();
+        throw;
+    }
+    wait_all();
+}
+
+/// Same as above, with the lookahead sized to keep every thread of the pool busy.
+template <class Iterator, class Prepare, class Consume>
+void ForEachPrepared(Iterator first, Iterator last, Prepare prepare, Consume consume)
+{
+    auto& pool = CompilePool::Instance();
+    ForEachPrepared(first, last, 2 * pool.Size(), pool, std::move(prepare), std::move(consume));
+}
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_PIPELINE_HPP_
@@ -0,0 +1,134 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
+#define GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <random>
+#include <vector>
+
+namespace miopen {
+namespace solver {
+
+/// How many times a candidate is run when measured.
+enum class Averaging
+{
+    Single,      // Once.
+    IfPromising, // Once, and 4 times more if within 5% of the best so far.
+    Always,      // 5 times.
+};
+
+/// The candidates of a search as seen by a SearchStrategy.
+///
+/// Candidates are referred to by index. The space keeps track of the best one: only
+/// the average of 5 runs may become the best, a single run is just a screening.
+class SearchSpace
+{
+    public:
+    static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+    static constexpr float failed     = std::numeric_limits<float>::max();
+
+    virtual ~SearchSpace() = default;
+
+    virtual std::size_t Size() const = 0;
+
+    /// Measures the candidates in the given order, building the next ones while one is
+    /// timed. Returns the time of each, `failed` for the ones which failed to run or
+    /// were not measured because the time budget ran out. Measuring goes on past the
+    /// budget until there is a best candidate, so a search always has a result.
+    virtual std::vector<float> Measure(const std::vector<std::size_t>& candidates,
+                                       Averaging averaging) = 0;
+
+    /// Returns a candidate made of the fields of a and b chosen at random, with one field
+    /// sometimes taken from any other candidate, or npos if there is no such candidate.
+    virtual std::size_t Recombine(std::size_t a, std::size_t b, std::mt19937& rng) = 0;
+
+    /// Number of measurements the strategy expects to make, for the ETA.
+    virtual void Plan(std::size_t measurements) = 0;
+
+    virtual bool IsExpired() const = 0;
+};
+
+enum class SearchStrategyKind
+{
+    First_ = 1, // 0 is returned for non-numeric env.vars.
+    Exhaustive = First_,
+    Random,
+    Halving,
+    Evolution,
+    Last_    = Evolution,
+    Default_ = Exhaustive,
+};
+
+std::ostream& operator<<(std::ostream& os, SearchStrategyKind kind);
+
+struct SearchOptions
+{
+    SearchStrategyKind strategy = SearchStrategyKind::Default_;
+    /// Seeds the random choices, so a search may be repeated, and resumed from a checkpoint
+    /// by a build with another compiler or standard library.
+    unsigned seed = 0;
+    /// Stops measuring once it runs out, 0 is unlimited.
+    std::chrono::milliseconds budget{0};
+    /// Candidates to be measured by the sampling strategies, 0 selects a tenth of the space.
+    std::size_t samples = 0;
+    /// Limits the space to the candidates of the lowest estimated cost, 0 keeps all.
+    std::size_t top_k = 0;
+
+    /// MIOPEN_SEARCH_STRATEGY (EXHAUSTIVE, RANDOM, HALVING or EVOLUTION),
+    /// MIOPEN_SEARCH_SEED, MIOPEN_SEARCH_BUDGET (seconds), MIOPEN_SEARCH_SAMPLES
+    /// and MIOPEN_SEARCH_TOP_K.
+    static SearchOptions FromEnv();
+};
+
+/// Random index in [0, size), size > 0. Searches use it instead of the standard
+/// distributions and std::shuffle, which are implemented differently by each standard
+/// library, so that a seed gives the same choices everywhere.
+std::size_t RandomIndex(std::size_t size, std::mt19937& rng);
+
+/// Decides which candidates to measure and how.
+class SearchStrategy
+{
+    public:
+    virtual ~SearchStrategy() = default;
+    virtual void Run(SearchSpace& space) = 0;
+};
+
+/// * Exhaustive measures every candidate in order.
+/// * Random measures samples picked at random, or as many as the budget allows.
+/// * Halving screens samples by single runs, keeps the faster half for another run until
+///   a few finalists are left, and only those get averaged.
+/// * Evolution breeds new candidates from the fastest ones measured so far.
+std::unique_ptr<SearchStrategy> MakeSearchStrategy(const SearchOptions& options);
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SEARCH_STRATEGY_HPP_
@@ -29,26 +29,168 @@
 
 #include <ciso646>
 #include <miopen/config.h>
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <sstream>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace miopen {
 namespace solver {
 
-// TODO: Provide specialization to use stro* functions
-template <class T>
+/// Parses one field of a serialized record. The [begin, end) range is not null-terminated.
+/// Specializations below handle integers and strings in place, without temporary objects.
+/// The generic version falls back to the stream extraction operator. Floating point values
+/// go there as well, because strtod() depends on the C locale while streams do not.
+template <class T, class Enable = void>
 struct Parse
 {
-    static bool apply(const std::string& s, T& result)
+    static bool apply(const char* begin, const char* end, T& result)
     {
         std::stringstream ss;
-        ss.str(s);
+        ss.str(std::string(begin, end));
         ss >> result;
         return true;
     }
 };
 
+namespace detail {
+
+/// Streams treat bool and character types specially, so those are left to them.
+template <class T>
+struct IsPlainInteger
+    : std::integral_constant<bool,
+                             std::is_integral<T>{} && !std::is_same<T, bool>{} && (sizeof(T) > 1)>
+{
+};
+
+template <class T>
+bool IsNegative(T value, std::true_type)
+{
+    return value < T{0};
+}
+
+template <class T>
+bool IsNegative(T, std::false_type)
+{
+    return false;
+}
+
+/// Parses an optionally signed decimal integer occupying the whole [begin, end) range.
+inline bool ParseInteger(const char* begin,
+                         const char* end,
+                         bool& negative,
+                         unsigned long long& magnitude)
+{
+    negative  = false;
+    magnitude = 0;
+    if(begin != end && (*begin == '-' || *begin == '+'))
+        negative = (*begin++ == '-');
+    if(begin == end)
+        return false;
+
+    constexpr auto max = std::numeric_limits<unsigned long long>::max();
+    for(; begin != end; ++begin)
+    {
+        if(*begin < '0' || *begin > '9')
+            return false;
+        const auto digit = static_cast<unsigned>(*begin - '0');
+        if(magnitude > (max - digit) / 10)
+            return false;
+        magnitude = magnitude * 10 + digit;
+    }
+    return true;
+}
+
+} // namespace detail
+
+template <class T>
+struct Parse<T, typename std::enable_if<detail::IsPlainInteger<T>{}>::type>
+{
+    static bool apply(const char* begin, const char* end, T& result)
+    {
+        bool negative;
+        unsigned long long magnitude;
+        if(!detail::ParseInteger(begin, end, negative, magnitude))
+            return false;
+
+        using Limits = std::numeric_limits<T>;
+        if(negative)
+        {
+            if(!Limits::is_signed ||
+               magnitude > static_cast<unsigned long long>(Limits::max()) + 1)
+                return false;
+            // Written this way to not overflow on the minimum value.
+            result = magnitude == 0 ? T{0} : static_cast<T>(-static_cast<T>(magnitude - 1) - 1);
+        }
+        else
+        {
+            if(magnitude > static_cast<unsigned long long>(Limits::max()))
+                return false;
+            result = static_cast<T>(magnitude);
+        }
+        return true;
+    }
+};
+
+template <>
+struct Parse<bool>
+{
+    static bool apply(const char* begin, const char* end, bool& result)
+    {
+        if(end - begin != 1 || (*begin != '0' && *begin != '1'))
+            return false;
+        result = (*begin == '1');
+        return true;
+    }
+};
+
+template <>
+struct Parse<std::string>
+{
+    static bool apply(const char* begin, const char* end, std::string& result)
+    {
+        result.assign(begin, end);
+        return true;
+    }
+};
+
+/// Writes one field of a serialized record. Integers are formatted on the stack
+/// instead of going through the locale machinery of the stream.
+template <class T, class Enable = void>
+struct Format
+{
+    static void apply(std::ostream& stream, const T& value) { stream << value; }
+};
+
+template <class T>
+struct Format<T, typename std::enable_if<detail::IsPlainInteger<T>{}>::type>
+{
+    static void apply(std::ostream& stream, T value)
+    {
+        char buffer[std::numeric_limits<T>::digits10 + 3];
+        auto pos = std::end(buffer);
+
+        const bool negative = detail::IsNegative(value, std::is_signed<T>{});
+        // Remainders of a negative value are negative, so the minimum value needs no special case.
+        auto rest = value;
+        do
+        {
+            const auto digit = static_cast<int>(rest % 10);
+            *--pos           = static_cast<char>('0' + (negative ? -digit : digit));
+            rest /= 10;
+        } while(rest != T{0});
+
+        if(negative)
+            *--pos = '-';
+        stream.write(pos, std::end(buffer) - pos);
+    }
+};
+
 template <class Derived, char Seperator = ','>
 struct Serializable
 {
@@ -58,8 +200,8 @@ struct Serializable
         void operator()(std::ostream& stream, char& sep, const T& x) const
         {
             if(sep != 0)
-                stream << sep;
-            stream << x;
+                stream.put(sep);
+            Format<T>::apply(stream, x);
             sep = Seperator;
         }
     };
@@ -67,21 +209,59 @@ struct Serializable
     struct DeserializeField
     {
         template <class T>
-        void operator()(bool& ok, std::istream& stream, char sep, T& x) const
+        void operator()(bool& ok, const char*& pos, const char* end, char sep, T& x) const
         {
             if(not ok)
                 return;
-            std::string part;
 
-            if(!std::getline(stream, part, sep))
+            // Running out of input is a failure, an empty field in the middle is not.
+            if(pos == end)
             {
                 ok = false;
                 return;
             }
 
-            ok = Parse<T>::apply(part, x);
+            const auto field_end = std::find(pos, end, sep);
+            ok                   = Parse<T>::apply(pos, field_end, x);
+            pos                  = field_end == end ? end : field_end + 1;
         }
     };
+    struct DeserializeIntField
+    {
+        template <class T>
+        void operator()(bool& ok, const std::vector<int>& from, std::size_t& i, T& x) const
+        {
+            if(not ok)
+                return;
+            if(i >= from.size())
+            {
+                ok = false;
+                return;
+            }
+            ok = Assign(std::is_integral<T>{}, from[i++], x);
+        }
+
+        /// Rejects the values Parse<T> rejects in the text, e.g. 2 for bool, so that both
+        /// forms of a db agree on which records are valid.
+        template <class T>
+        static bool Assign(std::true_type, int from, T& x)
+        {
+            using Limits = std::numeric_limits<T>;
+            if(from < 0 ? static_cast<long long>(from) < static_cast<long long>(Limits::min())
+                        : static_cast<unsigned long long>(from) >
+                              static_cast<unsigned long long>(Limits::max()))
+                return false;
+            x = static_cast<T>(from);
+            return true;
+        }
+
+        template <class T>
+        static bool Assign(std::false_type, int, T&)
+        {
+            return false;
+        }
+    };
+
     void Serialize(std::ostream& stream) const
     {
         char sep = 0;
@@ -90,15 +270,41 @@ struct Serializable
             std::bind(SerializeField{}, std::ref(stream), std::ref(sep), std::placeholders::_1));
     }
 
-    bool Deserialize(const std::string& s)
+    bool Deserialize(const std::string& s) { return Deserialize(s.data(), s.data() + s.size()); }
+
+    /// Deserializes from the [begin, end) range in place, without copying fields.
+    bool Deserialize(const char* begin, const char* end)
     {
         auto out = static_cast<const Derived&>(*this);
         bool ok  = true;
-        std::istringstream ss(s);
-        Derived::Visit(
-            out,
-            std::bind(
-                DeserializeField{}, std::ref(ok), std::ref(ss), Seperator, std::placeholders::_1));
+        Derived::Visit(out,
+                       std::bind(DeserializeField{},
+                                 std::ref(ok),
+                                 std::ref(begin),
+                                 end,
+                                 Seperator,
+                                 std::placeholders::_1));
+
+        if(!ok)
+            return false;
+
+        static_cast<Derived&>(*this) = out;
+        return true;
+    }
+
+    /// Deserializes from VALUES parsed to integers beforehand (e.g. by db compiler).
+    /// Fails if a field is not of integral type or there are too few fields.
+    bool Deserialize(const std::vector<int>& fields)
+    {
+        auto out      = static_cast<const Derived&>(*this);
+        bool ok       = true;
+        std::size_t i = 0;
+        Derived::Visit(out,
+                       std::bind(DeserializeIntField{},
+                                 std::ref(ok),
+                                 std::cref(fields),
+                                 std::ref(i),
+                                 std::placeholders::_1));
 
         if(!ok)
             return false;
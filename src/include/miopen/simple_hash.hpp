@@ -27,15 +27,17 @@
 #ifndef GUARD_MLOPEN_SIMPLE_HASH_HPP
 #define GUARD_MLOPEN_SIMPLE_HASH_HPP
 
+#include <miopen/fast_hash.hpp>
+
 #include <string>
+#include <utility>
 
 namespace miopen {
 struct SimpleHash
 {
     size_t operator()(const std::pair<std::string, std::string>& p) const
     {
-        using std::hash;
-        return (hash<std::string>()(p.first) ^ hash<std::string>()(p.second));
+        return static_cast<size_t>(FastHash64(p.second, FastHash64(p.first)));
     }
 };
 
@@ -29,15 +29,23 @@
 
 #include <miopen/config.h>
 
+#include <chrono>
+#include <exception>
+#include <future>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 #include <ostream>
 
 #include <miopen/logger.hpp>
+#include <miopen/compile_pool.hpp>
+#include <miopen/db_key.hpp>
+#include <miopen/each_args.hpp>
 #include <miopen/find_controls.hpp>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/legacy_exhaustive_search.hpp>
+#include <miopen/search_checkpoint.hpp>
 #include <miopen/env.hpp>
 #include <miopen/type_name.hpp>
 #include <miopen/miopen.h>
@@ -154,14 +162,14 @@ const std::string& SolverDbId(Solver solver)
 }
 
 template <class Solver, class Context, class Db>
-auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
+auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db, const DbKey& key)
     -> decltype(s.GetSolution(context, s.Search(context)))
 {
     const FindEnforce enforce;
     MIOPEN_LOG_I(SolverDbId(s));
     if(enforce.IsDbClean(context))
     {
-        if(db.Remove(context, SolverDbId(s)))
+        if(db.Remove(key, SolverDbId(s)))
             MIOPEN_LOG_W("Perf Db: record removed: " << SolverDbId(s) << ", enforce: " << enforce);
     }
     else
@@ -174,17 +182,26 @@ auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
         {
             using PerformanceConfig = decltype(s.GetPerformanceConfig(context));
             PerformanceConfig config{};
-            if(db.Load(context, SolverDbId(s), config))
+            if(db.Load(key, SolverDbId(s), config))
             {
                 MIOPEN_LOG_I2("Perf Db: record loaded: " << SolverDbId(s));
                 if(s.IsValidPerformanceConfig(context, config))
                 {
-                    return s.GetSolution(context, config);
+                    // The record may hold the best so far of a search which ran out of
+                    // its budget, see GenericSearch().
+                    if(!(context.do_search || enforce.IsSearch(context)) ||
+                       !SearchCheckpoints(context.GetSearchCheckpointPath(), key, SolverDbId(s))
+                            .Exists())
+                        return s.GetSolution(context, config);
+                    MIOPEN_LOG_W("Perf Db: resuming interrupted search: " << SolverDbId(s));
+                }
+                else
+                {
+                    MIOPEN_LOG(
+                        (MIOPEN_INSTALLABLE ? LoggingLevel::Warning : miopen::LoggingLevel::Error),
+                        "Invalid config loaded from Perf Db: " << SolverDbId(s) << ": " << config
+                                                               << ". Performance may degrade.");
                 }
-                MIOPEN_LOG(
-                    (MIOPEN_INSTALLABLE ? LoggingLevel::Warning : miopen::LoggingLevel::Error),
-                    "Invalid config loaded from Perf Db: " << SolverDbId(s) << ": " << config
-                                                           << ". Performance may degrade.");
             }
             else
             {
@@ -198,7 +215,7 @@ auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
             try
             {
                 auto c = s.Search(context);
-                db.Update(context, SolverDbId(s), c);
+                db.Update(key, SolverDbId(s), c);
                 return s.GetSolution(context, c);
             }
             catch(const miopen::Exception& ex)
@@ -212,7 +229,7 @@ auto FindSolutionImpl(rank<1>, Solver s, const Context& context, Db& db)
 }
 
 template <class Solver, class Context, class Db>
-auto FindSolutionImpl(rank<0>, Solver s, const Context& context, Db&)
+auto FindSolutionImpl(rank<0>, Solver s, const Context& context, Db&, const DbKey&)
     -> decltype(s.GetSolution(context))
 {
     MIOPEN_LOG_I(SolverDbId(s) << " (not searchable)");
@@ -225,17 +242,117 @@ auto FindSolutionImpl(rank<0>, Solver s, const Context& context, Db&)
 /// solution-specific parameters and returns the Solution object.
 /// Could take long if an exhaustive search is requested/performed.
 /// May read/write perfDb.
+/// The key shall be made of the context. It is taken as a parameter to make it once
+/// for all solvers tried on the same problem.
 template <class Solver, class Context, class Db>
-ConvSolution FindSolution(Solver s, const Context& context, Db& db)
+ConvSolution FindSolution(Solver s, const Context& context, Db& db, const DbKey& key)
 {
     static_assert(std::is_empty<Solver>{} && std::is_trivially_constructible<Solver>{},
                   "Solver must be stateless");
     // TODO: This assumes all solutions are ConvSolution
-    auto solution      = FindSolutionImpl(rank<1>{}, s, context, db);
+    auto solution      = FindSolutionImpl(rank<1>{}, s, context, db, key);
     solution.solver_id = SolverDbId(s);
     return solution;
 }
 
+template <class Solver, class Context, class Db>
+ConvSolution FindSolution(Solver s, const Context& context, Db& db)
+{
+    return FindSolution(s, context, db, DbKey(context));
+}
+
+/// Threads which evaluate the solvers of a problem at once, see ForEachSolver().
+/// MIOPEN_SOLVER_PARALLEL_LEVEL sets their number, 0 is the number of hardware threads
+/// up to 16, 1 evaluates the solvers one by one on the calling thread.
+CompilePool& GetSolverPool();
+
+/// Solvers are evaluated at once unless a search may run, as searches time kernels on
+/// the device, or the perf db may be modified.
+template <class Context>
+bool IsSolverEvaluationParallel(const Context& context)
+{
+    const FindEnforce enforce;
+    return GetSolverPool().Size() > 1 && !context.do_search && !enforce.IsSearch(context) &&
+           !enforce.IsDbClean(context);
+}
+
+/// Evaluated at once, the solvers which the serial search would skip are evaluated too.
+/// So errors are kept here and rethrown only if the evaluation gets used.
+template <class Solution>
+struct SolverEvaluation
+{
+    bool is_applicable = false; // Set once IsApplicable() and IsFast() have returned.
+    Solution solution{miopenStatusUnknownError};
+    std::exception_ptr error;
+
+    template <class F>
+    static SolverEvaluation Run(F evaluate)
+    {
+        SolverEvaluation evaluation;
+        try
+        {
+            evaluate(evaluation);
+        }
+        catch(...)
+        {
+            evaluation.error = std::current_exception();
+        }
+        return evaluation;
+    }
+
+    void Rethrow() const
+    {
+        if(error)
+            std::rethrow_exception(error);
+    }
+};
+
+/// Calls consume(solver, evaluate(solver)) for each of the solvers, in their order.
+///
+/// If parallel, all evaluations are queued to the solver pool first, so evaluate() shall
+/// be safe to call from several threads. Otherwise each one runs right before its
+/// consume(), and may depend on what was consumed so far.
+template <class... Solvers, class Evaluate, class Consume>
+void ForEachSolver(const bool parallel, Evaluate evaluate, Consume consume)
+{
+    const auto timed = [evaluate](auto solver) {
+        const auto start = std::chrono::steady_clock::now();
+        auto result      = evaluate(solver);
+        return std::make_pair(std::move(result),
+                              std::chrono::duration<float, std::milli>(
+                                  std::chrono::steady_clock::now() - start)
+                                  .count());
+    };
+    using Result = typename std::common_type<decltype(timed(Solvers{}))...>::type;
+
+    std::vector<std::shared_future<Result>> results;
+    if(parallel)
+    {
+        auto& pool = GetSolverPool();
+        each_args(
+            [&](auto solver) { results.push_back(pool.Submit([=]() { return timed(solver); })); },
+            Solvers{}...);
+    }
+
+    try
+    {
+        each_args_i(
+            [&](auto i, auto solver) {
+                const auto result = parallel ? results[i].get() : timed(solver);
+                MIOPEN_LOG_I2(SolverDbId(solver) << ": " << result.second << " ms");
+                consume(solver, result.first);
+            },
+            Solvers{}...);
+    }
+    catch(...)
+    {
+        // The evaluations refer to the caller's frame.
+        for(const auto& result : results)
+            result.wait();
+        throw;
+    }
+}
+
 // Search for the 1st applicable solution among many solvers
 template <class... Solvers, class Context, class Db>
 auto SearchForSolution(const Context& search_params, Db db) ->
@@ -250,32 +367,44 @@ auto SearchForSolution(const Context& search_params, Db db) ->
     const
 #endif
         auto no_perf_filtering = miopen::IsDisabled(MIOPEN_DEBUG_AMD_ASM_KERNELS_PERF_FILTERING{});
+    const DbKey key(search_params);
+    const auto parallel = IsSolverEvaluationParallel(search_params);
 
-    miopen::each_args(
+    ForEachSolver<Solvers...>(
+        parallel,
         [&](auto solver) {
-            if(solver.IsApplicable(search_params) &&
-               (no_perf_filtering || solver.IsFast(search_params)))
+            return SolverEvaluation<Solution>::Run([&](SolverEvaluation<Solution>& evaluation) {
+                evaluation.is_applicable = solver.IsApplicable(search_params) &&
+                                           (no_perf_filtering || solver.IsFast(search_params));
+                // Evaluated at once, a solver cannot know whether one before it succeeds.
+                if(evaluation.is_applicable && (parallel || !solution.Succeeded()))
+                    evaluation.solution = FindSolution(solver, search_params, db, key);
+            });
+        },
+        [&](auto solver, const SolverEvaluation<Solution>& evaluation) {
+            if(!evaluation.is_applicable)
+            {
+                // Applicability is checked for every solver, also after a success.
+                evaluation.Rethrow();
+                MIOPEN_LOG_I2(SolverDbId(solver) << ": Not applicable");
+            }
+            else if(!solution.Succeeded())
             {
-                if(!solution.Succeeded())
+                evaluation.Rethrow();
+                solution = evaluation.solution;
+                if(solution.Succeeded())
                 {
-                    solution = FindSolution(solver, search_params, db);
-                    if(solution.Succeeded())
+                    MIOPEN_LOG_I2(SolverDbId(solver) << ": Success.");
+                    if(solution.construction_params.empty())
                     {
-                        MIOPEN_LOG_I2(SolverDbId(solver) << ": Success.");
-                        if(solution.construction_params.empty())
-                        {
-                            MIOPEN_THROW(std::string("Internal error in solver: ") +
-                                         SolverDbId(solver));
-                        }
+                        MIOPEN_THROW(std::string("Internal error in solver: ") +
+                                     SolverDbId(solver));
                     }
                 }
-                else
-                    MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped");
             }
             else
-                MIOPEN_LOG_I2(SolverDbId(solver) << ": Not applicable");
-        },
-        Solvers{}...);
+                MIOPEN_LOG_I2(SolverDbId(solver) << ": Skipped");
+        });
 
     return solution;
 }
@@ -302,14 +431,29 @@ std::vector<Solution> SearchForAllSolutions(const Context& search_params, Db db)
             miopen::IsDisabled(MIOPEN_DEBUG_AMD_ASM_KERNELS_PERF_FILTERING{}) ||
             !miopen::IsEnabled(MIOPEN_DEBUG_FIND_FIRST_CONV{});
 
-    bool skip_the_rest = false;
-    miopen::each_args( // clang-format off
-        [&](auto solver) { // cppcheck-suppress knownConditionTrueFalse
-            if(!skip_the_rest
-               && solver.IsApplicable(search_params)
-               && (no_perf_filtering || solver.IsFast(search_params)))
-            { // clang-format on
-                const Solution s = FindSolution(solver, search_params, db);
+    const DbKey key(search_params);
+    const auto parallel = IsSolverEvaluationParallel(search_params);
+    bool skip_the_rest  = false;
+    ForEachSolver<Solvers...>(
+        parallel,
+        [&](auto solver) {
+            return SolverEvaluation<Solution>::Run([&](SolverEvaluation<Solution>& evaluation) {
+                // Evaluated at once, a solver cannot know whether the rest is to be skipped.
+                if(!parallel && skip_the_rest)
+                    return;
+                evaluation.is_applicable = solver.IsApplicable(search_params) &&
+                                           (no_perf_filtering || solver.IsFast(search_params));
+                if(evaluation.is_applicable)
+                    evaluation.solution = FindSolution(solver, search_params, db, key);
+            });
+        },
+        [&](auto solver, const SolverEvaluation<Solution>& evaluation) {
+            if(!skip_the_rest)
+                evaluation.Rethrow();
+
+            if(!skip_the_rest && evaluation.is_applicable)
+            {
+                const Solution& s = evaluation.solution;
                 if(s.Succeeded())
                 {
                     ss.push_back(s);
@@ -353,8 +497,7 @@ std::vector<Solution> SearchForAllSolutions(const Context& search_params, Db db)
                 MIOPEN_LOG_I2(SolverDbId(solver) << ": "
                                                  << (skip_the_rest ? "Skipped" : "Not applicable"));
             }
-        },
-        Solvers{}...);
+        });
     return ss;
 }
 
@@ -533,6 +676,10 @@ struct ConvAsm1x1U : SolverBase<ConvolutionContext>
     ConvSolution GetSolution(const ConvolutionContext& params,
                              const PerformanceConfigConvAsm1x1U& config,
                              bool disableConfigOverrideFromEnv = false) const;
+    /// See EstimateCost() in search_cost_model.hpp.
+    float EstimateCost(const ConvolutionContext& params,
+                       const PerformanceConfigConvAsm1x1U& config,
+                       std::size_t compute_units) const;
     int RunAndMeasureSolution(miopen::Handle& profile_h,
                               Data_t bot_ocl_buf,
                               Data_t top_ocl_buf,
@@ -989,9 +1136,14 @@ struct AnySolver
         return ptr_value->IsFast(ctx);
     };
     ConvSolution FindSolution(const ConvolutionContext& ctx, MultiFileDb& db) const
+    {
+        return FindSolution(ctx, db, DbKey(ctx));
+    };
+    ConvSolution
+    FindSolution(const ConvolutionContext& ctx, MultiFileDb& db, const DbKey& key) const
     {
         assert(ptr_value != nullptr);
-        return ptr_value->FindSolution(ctx, db);
+        return ptr_value->FindSolution(ctx, db, key);
     };
 
     // virtual base class
@@ -1003,7 +1155,8 @@ struct AnySolver
         virtual bool IsApplicable(const ConvolutionContext& ctx) const = 0;
         virtual bool IsFast(const ConvolutionContext& ctx) const       = 0;
         virtual const std::type_info& Type() const                     = 0;
-        virtual ConvSolution FindSolution(const ConvolutionContext& ctx, MultiFileDb& db) const = 0;
+        virtual ConvSolution
+        FindSolution(const ConvolutionContext& ctx, MultiFileDb& db, const DbKey& key) const = 0;
     };
 
     // templated derived class
@@ -1016,9 +1169,10 @@ struct AnySolver
             return value.IsApplicable(ctx);
         };
         bool IsFast(const ConvolutionContext& ctx) const override { return value.IsFast(ctx); };
-        ConvSolution FindSolution(const ConvolutionContext& ctx, MultiFileDb& db) const override
+        ConvSolution
+        FindSolution(const ConvolutionContext& ctx, MultiFileDb& db, const DbKey& key) const override
         {
-            return miopen::solver::FindSolution(value, ctx, db);
+            return miopen::solver::FindSolution(value, ctx, db, key);
         };
         const std::type_info& Type() const override { return typeid(T); };
 
@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 
+#include <algorithm>
 #include <sstream>
 
 #include <boost/range/adaptor/transformed.hpp>
@@ -63,6 +64,22 @@ static std::string GenerateDefines(const std::vector<KernelBuildParameter>& opti
     return JoinStrings(strs, " ");
 }
 
+void KernelBuildParameters::Canonicalize()
+{
+    const auto defines = std::stable_partition(options.begin(), options.end(), [](auto& item) {
+        return item.type == ParameterTypes::Option;
+    });
+    std::stable_sort(defines, options.end(), [](auto& left, auto& right) {
+        return left.name < right.name;
+    });
+
+    // Repeats with other values are kept in their order, so the last one still wins.
+    const auto last = std::unique(defines, options.end(), [](auto& left, auto& right) {
+        return left.name == right.name && left.value == right.value;
+    });
+    options.erase(last, options.end());
+}
+
 std::string kbp::OpenCL::Generate(const std::vector<KernelBuildParameter>& options)
 {
     // Ensure only one space after the -cl-std.
@@ -42,9 +42,13 @@
 #include <miopen/errors.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
+#include <miopen/program_registry.hpp>
 
+#include <atomic>
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <utility>
 
 namespace miopen {
 
@@ -108,21 +112,32 @@ static void AddKernelDumpKernelParams(const std::string& program_name,
                            << params);
 }
 
-const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
-                                                   const std::string& network_config)
+static std::string NormalizeParams(std::string params)
+{
+    // Ensure only one space after the -cl-std.
+    // >1 space can cause an Apple compiler bug. See clSPARSE issue #141.
+    if(!params.empty() && params.at(0) != ' ')
+        params = " " + params;
+    return params;
+}
+
+KernelCache::KernelsPtr KernelCache::GetKernels(const std::string& algorithm,
+                                                const std::string& network_config) const
 {
 
     std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
 
-    const auto it = kernel_map.find(key);
-    if(it != kernel_map.end())
+    const auto map = std::atomic_load(&kernel_map);
+    const auto it  = map->find(key);
+    if(it != map->end())
     {
-        MIOPEN_LOG_I2(it->second.size() << " kernels for key: " << key.first << " \"" << key.second
-                                        << '\"');
+        MIOPEN_LOG_I2(it->second->size() << " kernels for key: " << key.first << " \""
+                                         << key.second
+                                         << '\"');
         return it->second;
     }
 
-    static const std::vector<Kernel> empty{};
+    static const auto empty = std::make_shared<const Kernels>();
     MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
     return empty;
 }
@@ -133,11 +148,12 @@ bool KernelCache::HasKernels(const std::string& algorithm, const std::string& ne
 #ifndef NDEBUG
     MIOPEN_LOG_I("Key: " << key.first << " \"" << key.second << '\"');
 #endif
-    const auto it = kernel_map.find(key);
-    if(it == kernel_map.end())
+    const auto map = std::atomic_load(&kernel_map);
+    const auto it  = map->find(key);
+    if(it == map->end())
         return false;
 
-    assert(!it->second.empty() &&
+    assert(!it->second->empty() &&
            "There should be at least one kernel in kernel cache if an entry exists");
     return true;
 }
@@ -152,15 +168,7 @@ Kernel KernelCache::AddKernel(Handle& h,
                               std::string params,
                               std::size_t cache_index)
 {
-    if(params.length() > 0)
-    {
-        // Ensure only one space after the -cl-std.
-        // >1 space can cause an Apple compiler bug. See clSPARSE issue #141.
-        if(params.at(0) != ' ')
-        {
-            params = " " + params;
-        }
-    }
+    params = NormalizeParams(std::move(params));
 
     const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
     if(!network_config.empty() || !algorithm.empty()) // Don't log only _empty_ keys.
@@ -168,12 +176,8 @@ Kernel KernelCache::AddKernel(Handle& h,
 
     Program program;
 
-    auto program_it = program_map.find(std::make_pair(program_name, params));
-    if(program_it != program_map.end())
-    {
-        program = program_it->second;
-    }
-    else
+    const auto program_key = std::make_pair(program_name, params);
+    if(!FindProgram(program_key, program))
     {
         const bool is_kernel_str = algorithm.find("GEMM") != std::string::npos;
         if(miopen::IsLogging(miopen::LoggingLevel::Info2))
@@ -185,8 +189,8 @@ Kernel KernelCache::AddKernel(Handle& h,
                                       vgd,
                                       params);
         }
-        program = h.LoadProgram(program_name, params, is_kernel_str);
-        program_map[std::make_pair(program_name, params)] = program;
+        program = GetProgram(program_key, AcquireProgram(h, program_key, is_kernel_str, false));
+        StoreProgram(program_key, program);
     }
     Kernel kernel{program, kernel_name, vld, vgd};
     if(!network_config.empty() && !algorithm.empty())
@@ -198,26 +202,170 @@ Kernel KernelCache::AddKernel(Handle& h,
 
 void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
 {
-    auto&& v = kernel_map[key];
-    if(cache_index >= v.size())
-    {
-        v.resize(cache_index + 1);
-    }
-    v[cache_index] = k;
+    ModifyKernels([&](KernelMap& map) {
+        auto&& kernels = map[key];
+        auto v         = kernels ? *kernels : Kernels{};
+        if(cache_index >= v.size())
+        {
+            v.resize(cache_index + 1);
+        }
+        v[cache_index] = k;
+        kernels        = std::make_shared<const Kernels>(std::move(v));
+    });
 }
 
 void KernelCache::ClearKernels(const std::string& algorithm, const std::string& network_config)
 {
     assert(!network_config.empty() && !algorithm.empty());
     const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-    auto&& v = this->kernel_map[key];
-    if(!v.empty())
+    ModifyKernels([&](KernelMap& map) {
+        const auto it = map.find(key);
+        if(it == map.end())
+            return;
+        MIOPEN_LOG_I2(it->second->size() << " kernels for key: " << key.first << " \""
+                                         << key.second
+                                         << '\"');
+        map.erase(it);
+    });
+}
+
+void KernelCache::ModifyKernels(const std::function<void(KernelMap&)>& modify)
+{
+    std::lock_guard<std::mutex> lock(kernel_mutex);
+    auto map = std::make_shared<KernelMap>(*std::atomic_load(&kernel_map));
+    modify(*map);
+    std::atomic_store(&kernel_map, std::shared_ptr<const KernelMap>(std::move(map)));
+}
+
+void KernelCache::BuildProgramAsync(Handle& h,
+                                    const std::string& program_name,
+                                    std::string params,
+                                    bool is_kernel_str)
+{
+    auto key = std::make_pair(program_name, NormalizeParams(std::move(params)));
+    {
+        std::lock_guard<std::mutex> lock(program_mutex);
+        if(program_map.find(key) != program_map.end() ||
+           pending_programs.find(key) != pending_programs.end())
+            return;
+    }
+
+    MIOPEN_LOG_I2("Building in background: " << key.first << ',' << key.second);
+    auto program = AcquireProgram(h, key, is_kernel_str, true);
+
+    std::lock_guard<std::mutex> lock(program_mutex);
+    if(program_map.find(key) != program_map.end() ||
+       !pending_programs.emplace(key, std::move(program)).second)
+    {
+        // Another thread got there first, one reference is enough.
+        ProgramRegistry::Instance().Release({scope, key.first, key.second});
+    }
+}
+
+std::size_t KernelCache::FinishBuilds()
+{
+    PendingMap pending;
+    {
+        std::lock_guard<std::mutex> lock(program_mutex);
+        pending.swap(pending_programs);
+    }
+
+    std::size_t failed = 0;
+    for(const auto& program : pending)
+    {
+        try
+        {
+            StoreProgram(program.first, GetProgram(program.first, program.second));
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("Unable to build " << program.first.first << ": " << ex.what());
+            ++failed;
+        }
+    }
+    return failed;
+}
+
+std::shared_future<Program>
+KernelCache::AcquireProgram(Handle& h, const Key& key, bool is_kernel_str, bool async)
+{
+    const void* current_scope;
+    {
+        std::lock_guard<std::mutex> lock(program_mutex);
+        scope         = h.GetProgramScope();
+        current_scope = scope;
+    }
+
+    auto handle      = &h;
+    const auto build = [handle, key, is_kernel_str]() {
+        return handle->LoadProgram(key.first, key.second, is_kernel_str);
+    };
+    return ProgramRegistry::Instance().Acquire(
+        {current_scope, key.first, key.second}, build, async);
+}
+
+Program KernelCache::GetProgram(const Key& key, const std::shared_future<Program>& program)
+{
+    try
+    {
+        return program.get();
+    }
+    catch(...)
+    {
+        // The program is not kept, so it is not referenced either.
+        ProgramRegistry::Instance().Release({scope, key.first, key.second});
+        throw;
+    }
+}
+
+bool KernelCache::FindProgram(const Key& key, Program& program)
+{
+    std::shared_future<Program> pending;
     {
-        MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.first << " \"" << key.second << '\"');
+        std::lock_guard<std::mutex> lock(program_mutex);
+        const auto it = program_map.find(key);
+        if(it != program_map.end())
+        {
+            program = it->second;
+            return true;
+        }
+
+        const auto pending_it = pending_programs.find(key);
+        if(pending_it == pending_programs.end())
+            return false;
+        pending = pending_it->second;
+        pending_programs.erase(pending_it);
     }
-    v.clear();
+
+    // Rethrows build errors the same way as building in place would.
+    program = GetProgram(key, pending);
+    StoreProgram(key, program);
+    return true;
 }
 
-KernelCache::KernelCache() {}
+void KernelCache::StoreProgram(const Key& key, const Program& program)
+{
+    std::lock_guard<std::mutex> lock(program_mutex);
+    if(!program_map.emplace(key, program).second)
+    {
+        // Another thread got there first, one reference is enough.
+        ProgramRegistry::Instance().Release({scope, key.first, key.second});
+    }
+}
+
+KernelCache::KernelCache() : kernel_map(std::make_shared<const KernelMap>()) {}
+
+KernelCache::~KernelCache()
+{
+    auto& registry = ProgramRegistry::Instance();
+    std::lock_guard<std::mutex> lock(program_mutex);
+    for(const auto& pending : pending_programs)
+    {
+        pending.second.wait();
+        registry.Release({scope, pending.first.first, pending.first.second});
+    }
+    for(const auto& program : program_map)
+        registry.Release({scope, program.first.first, program.first.second});
+}
 
 } // namespace miopen
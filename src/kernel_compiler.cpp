@@ -0,0 +1,203 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/kernel_compiler.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/load_file.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/make_unique.hpp>
+#include <miopen/write_file.hpp>
+
+#include <boost/filesystem.hpp>
+
+#include <cerrno>
+#include <cstdlib>
+#include <sstream>
+#include <utility>
+
+#ifdef __linux__
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ; // NOLINT
+#endif
+
+namespace miopen {
+
+int SpawnProcess(const std::vector<std::string>& args, const std::string& cwd)
+{
+#ifdef __linux__
+    std::vector<char*> argv;
+    for(const auto& arg : args)
+        argv.push_back(const_cast<char*>(arg.c_str())); // NOLINT
+    argv.push_back(nullptr);
+
+    pid_t pid;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+    posix_spawn_file_actions_t actions;
+    if(posix_spawn_file_actions_init(&actions) != 0)
+        return -1;
+    auto rc = 0;
+    if(!cwd.empty())
+        rc = posix_spawn_file_actions_addchdir_np(&actions, cwd.c_str());
+    if(rc == 0)
+        rc = posix_spawnp(&pid, argv[0], &actions, nullptr, argv.data(), environ);
+    posix_spawn_file_actions_destroy(&actions);
+    if(rc != 0)
+        return -1;
+#else
+    // Only async-signal-safe calls are allowed in the child of a multithreaded process.
+    pid = fork();
+    if(pid == -1)
+        return -1;
+    if(pid == 0)
+    {
+        if(cwd.empty() || chdir(cwd.c_str()) == 0)
+            execvp(argv[0], argv.data());
+        _exit(127);
+    }
+#endif
+
+    int status;
+    while(waitpid(pid, &status, 0) == -1)
+    {
+        if(errno != EINTR)
+            return -1;
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+#else
+    std::string cmd = cwd.empty() ? "" : "cd \"" + cwd + "\" &&";
+    for(const auto& arg : args)
+        cmd += (cmd.empty() ? "" : " ") + arg;
+    return std::system(cmd.c_str());
+#endif
+}
+
+/// Splits the options into arguments the way the shell would, as long as they contain
+/// nothing but words separated by whitespace. Returns false otherwise.
+static bool SplitOptions(const std::string& options, std::vector<std::string>& args)
+{
+    if(options.find_first_of("\"'\\$`|&;<>()*?[]{}~#") != std::string::npos)
+        return false;
+
+    std::istringstream ss(options);
+    for(std::string arg; ss >> arg;)
+        args.push_back(arg);
+    return true;
+}
+
+ExternalCompiler::ExternalCompiler(std::string executable_) : executable(std::move(executable_))
+{
+}
+
+std::string ExternalCompiler::Compile(const std::string& filename,
+                                      const std::string& src,
+                                      const std::string& options)
+{
+    struct DirLease
+    {
+        ExternalCompiler& owner;
+        std::unique_ptr<TmpDir> dir;
+        ~DirLease() { owner.ReleaseDir(std::move(dir)); }
+    } lease{*this, AcquireDir()};
+
+    const auto src_file = lease.dir->path / filename;
+    const auto obj_file = lease.dir->path / (filename + ".o");
+    WriteFile(src, src_file);
+
+    std::vector<std::string> args{executable};
+    if(!SplitOptions(options, args))
+    {
+        args = {"/bin/sh",
+                "-c",
+                executable + " " + options + " " + src_file.string() + " -o " +
+                    obj_file.string()};
+    }
+    else
+    {
+        args.push_back(src_file.string());
+        args.push_back("-o");
+        args.push_back(obj_file.string());
+    }
+
+    MIOPEN_LOG_I2("Compiling " << filename << ": " << executable << " " << options);
+    const auto rc = SpawnProcess(args, lease.dir->path.string());
+    if(rc != 0)
+        MIOPEN_THROW("Compiler exited with code " + std::to_string(rc) + ": " + executable + " " +
+                     options + " " + filename);
+
+    if(!boost::filesystem::exists(obj_file))
+        MIOPEN_THROW("Compiler produced no code object: " + executable + " " + options + " " +
+                     filename);
+    return LoadFile(obj_file.string());
+}
+
+std::size_t ExternalCompiler::ScratchDirs() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return created;
+}
+
+std::unique_ptr<TmpDir> ExternalCompiler::AcquireDir()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if(!idle.empty())
+        {
+            auto dir = std::move(idle.back());
+            idle.pop_back();
+            return dir;
+        }
+        ++created;
+    }
+    return miopen::make_unique<TmpDir>("compile");
+}
+
+void ExternalCompiler::ReleaseDir(std::unique_ptr<TmpDir> dir)
+{
+    // Whatever the compiler has left would be mistaken for the results of the next run.
+    boost::system::error_code ec;
+    std::vector<boost::filesystem::path> leftovers;
+    for(boost::filesystem::directory_iterator it(dir->path, ec), end; !ec && it != end;
+        it.increment(ec))
+        leftovers.push_back(it->path());
+    for(const auto& path : leftovers)
+    {
+        if(!ec)
+            boost::filesystem::remove_all(path, ec);
+    }
+
+    if(ec)
+    {
+        MIOPEN_LOG_W("Unable to clean up " << dir->path << ": " << ec.message());
+        return; // The directory is removed along with the TmpDir.
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    idle.push_back(std::move(dir));
+}
+
+} // namespace miopen
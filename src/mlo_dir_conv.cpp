@@ -62,9 +62,10 @@ mlo_construct_direct2D_fusion::FindSolution(std::vector<miopen::solver::AnySolve
     miopen::solver::ConvSolution solution{miopenStatusUnknownError};
     std::string solver_id;
     auto db = this->GetDb();
+    const miopen::DbKey key(_search_params);
     for(auto& solver : solvers)
     {
-        solution = solver.FindSolution(_search_params, db);
+        solution = solver.FindSolution(_search_params, db, key);
         if(solution.Succeeded() && solver.IsApplicable(_search_params) &&
            solver.IsFast(_search_params))
         {
@@ -247,11 +248,13 @@ void mlo_construct_direct2D::setupFloats()
 {
     if(_search_params.IsFp32())
     {
-        _search_params.general_compile_options += " -DMIOPEN_USE_FP32=1 -DMIOPEN_USE_FP16=0";
+        _search_params.general_compile_options
+            << miopen::KernelBuildParameters{{"MIOPEN_USE_FP32", 1}, {"MIOPEN_USE_FP16", 0}};
     }
     else if(_search_params.IsFp16())
     {
-        _search_params.general_compile_options += " -DMIOPEN_USE_FP32=0 -DMIOPEN_USE_FP16=1";
+        _search_params.general_compile_options
+            << miopen::KernelBuildParameters{{"MIOPEN_USE_FP32", 0}, {"MIOPEN_USE_FP16", 1}};
     }
     else
     {
@@ -268,11 +271,13 @@ void mlo_construct_activ_lrn_pooling_common::setupFloats()
 {
     if(_search_params.in_data_type == miopenFloat && _search_params.out_data_type == miopenFloat)
     {
-        _search_params.general_compile_options += " -DMIOPEN_USE_FP32=1 -DMIOPEN_USE_FP16=0";
+        _search_params.general_compile_options
+            << miopen::KernelBuildParameters{{"MIOPEN_USE_FP32", 1}, {"MIOPEN_USE_FP16", 0}};
     }
     else if(_search_params.in_data_type == miopenHalf && _search_params.out_data_type == miopenHalf)
     {
-        _search_params.general_compile_options += " -DMIOPEN_USE_FP32=0 -DMIOPEN_USE_FP16=1";
+        _search_params.general_compile_options
+            << miopen::KernelBuildParameters{{"MIOPEN_USE_FP32", 0}, {"MIOPEN_USE_FP16", 1}};
     }
     else
     {
@@ -169,13 +169,19 @@ ClProgramPtr LoadProgram(cl_context ctx,
     }
 }
 
-void SaveProgramBinary(const ClProgramPtr& program, const std::string& name)
+std::string GetProgramBinary(const ClProgramPtr& program)
 {
     size_t binary_size;
     clGetProgramInfo(program.get(), CL_PROGRAM_BINARY_SIZES, sizeof(size_t), &binary_size, nullptr);
-    std::vector<char> binary(binary_size);
-    char* src[1] = {binary.data()};
+    std::string binary(binary_size, '\0');
+    char* src[1] = {&binary[0]};
     clGetProgramInfo(program.get(), CL_PROGRAM_BINARIES, sizeof(src), &src, nullptr);
+    return binary;
+}
+
+void SaveProgramBinary(const ClProgramPtr& program, const std::string& name)
+{
+    const auto binary = GetProgramBinary(program);
     std::ofstream fout(name.c_str(), std::ios::out | std::ios::binary);
     fout.write(binary.data(), binary.size());
 }
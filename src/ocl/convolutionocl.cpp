@@ -28,6 +28,7 @@
 #include <miopen/conv_algo_name.hpp>
 #include <miopen/db.hpp>
 #include <miopen/env.hpp>
+#include <miopen/fast_hash.hpp>
 #include <miopen/find_db.hpp>
 #include <miopen/float_equal.hpp>
 #include <miopen/solver.hpp>
@@ -42,7 +43,9 @@
 #include <miopen/gemm_v2.hpp>
 #endif
 
+#include <algorithm>
 #include <cassert>
+#include <sstream>
 #include <type_traits>
 
 #include <boost/range/adaptors.hpp>
@@ -106,6 +109,25 @@ static inline void AddKernels(Handle& handle,
     }
 }
 
+/// Starts building of kernels of all the solutions in background, so evaluation of a solution
+/// overlaps with builds of the rest ones. AddKernels() picks built programs up.
+static inline void BuildKernelsAsync(Handle& handle,
+                                     const std::vector<miopen::solver::ConvSolution>& solutions)
+{
+    for(const auto& s : solutions)
+        for(const auto& k : s.construction_params)
+            handle.BuildProgramAsync(k.kernel_file, k.comp_options);
+}
+
+/// Tells the kernels (and so the tuned config) of a solution apart, for the find-db.
+static std::string KernelsFingerprint(const miopen::solver::ConvSolution& solution)
+{
+    std::ostringstream ss;
+    for(const auto& k : solution.construction_params)
+        ss << k << '\n';
+    return FastHashHex(ss.str());
+}
+
 static inline void ValidateGroupCount(const TensorDescriptor& xDesc,
                                       const TensorDescriptor& wDesc,
                                       const ConvolutionDescriptor& conv)
@@ -304,7 +326,7 @@ ConvolutionDescriptor::FindDataDirectSolutions(Handle& handle,
     mlo_construct_direct2D construct_params(xDesc, wDesc, yDesc, *this, isForward ? 1 : 0);
     construct_params.setDoSearch(exhaustiveSearch);
     construct_params.saveSearchRequest(true);
-    construct_params.setGeneralCompOptions("");
+    construct_params.setGeneralCompOptions({});
     construct_params.setStream(&handle);
     construct_params.detectRocm();
 
@@ -742,6 +764,7 @@ static void DirConvFindCore(Handle& handle,
             ExtraKernelArgs eka;
             const auto all = conv.FindDataDirectSolutions(
                 handle, xDesc, wDesc, yDesc, exhaustiveSearch, true, network_config, eka);
+            BuildKernelsAsync(handle, all);
             miopen::solver::ConvSolution selected{miopenStatusUnknownError};
             float best = std::numeric_limits<float>::max();
             visit_float(xDesc.GetType(), [&](auto as_float) {
@@ -781,9 +804,12 @@ static void DirConvFindCore(Handle& handle,
                 AddKernels(handle, algorithm_name, network_config, selected, nullptr);
                 MIOPEN_LOG_I("Selected: " << selected << ": " << best << ", workspce_sz = "
                                           << selected.workspce_sz);
-                record.SetValues(
-                    algorithm_name,
-                    FindDbData{selected.solver_id, best, selected.workspce_sz, network_config});
+                record.SetValues(algorithm_name,
+                                 FindDbData{selected.solver_id,
+                                            best,
+                                            selected.workspce_sz,
+                                            network_config,
+                                            KernelsFingerprint(selected)});
             }
         }
 
@@ -823,6 +849,69 @@ static void DirConvFindCore(Handle& handle,
     }
 }
 
+/// Builds the kernels of a find-db record made by DirConvFindCore(), without running them.
+static bool DirConvRebuildKernels(Handle& handle,
+                                  const TensorDescriptor& xDesc,
+                                  const TensorDescriptor& wDesc,
+                                  const TensorDescriptor& yDesc,
+                                  const ConvolutionDescriptor& conv,
+                                  const std::string& algorithm,
+                                  const FindDbData& data)
+{
+    try
+    {
+        if(algorithm == "miopenConvolutionFwdAlgoGEMM")
+            return true; // CallGemm() builds the kernels on demand.
+
+        std::string network_config;
+        if(algorithm == "miopenConvolutionFwdAlgoWinograd")
+        {
+            WinogradKernelParams k_p;
+            KernelInvoke kernel;
+            std::string solver_id;
+            return conv.FindWinogradKernel<mlo_construct_winograd>(handle,
+                                                                   xDesc,
+                                                                   wDesc,
+                                                                   yDesc,
+                                                                   k_p,
+                                                                   kernel,
+                                                                   solver_id,
+                                                                   1,
+                                                                   &network_config) == 0 &&
+                   solver_id == data.solver_id && network_config == data.kchache_key;
+        }
+        if(algorithm == "miopenConvolutionFwdAlgoDirect")
+        {
+            // The searched configs are in the perf db already. If the one found there is not the
+            // recorded one anymore (e.g. the perf db was updated since), the timings are stale.
+            ExtraKernelArgs eka;
+            const auto all = conv.FindDataDirectSolutions(
+                handle, xDesc, wDesc, yDesc, false, true, network_config, eka);
+            const auto solution =
+                std::find_if(all.begin(), all.end(), [&](const auto& s) {
+                    return s.solver_id == data.solver_id && KernelsFingerprint(s) == data.kernels;
+                });
+            if(solution == all.end() || network_config != data.kchache_key)
+                return false;
+            AddKernels(handle, algorithm, network_config, *solution, nullptr);
+            return true;
+        }
+        if(algorithm == "miopenConvolutionFwdAlgoFFT")
+        {
+            std::vector<KernelInvoke> kernels;
+            const auto workspace = conv.ForwardGetWorkSpaceSizeFFT(wDesc, xDesc, yDesc);
+            return conv.FindFwdFFTKernel(
+                       handle, xDesc, wDesc, yDesc, workspace, kernels, network_config) == 0 &&
+                   network_config == data.kchache_key;
+        }
+    }
+    catch(const miopen::Exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to rebuild " << algorithm << ": " << ex.what());
+    }
+    return false;
+}
+
 void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
                                                  const TensorDescriptor& xDesc,
                                                  ConstData_t x,
@@ -851,19 +940,25 @@ void ConvolutionDescriptor::FindConvFwdAlgorithm(Handle& handle,
 
     ProblemDescription problem(xDesc, wDesc, yDesc, *this, 1);
 
-    std::vector<PerfField> perf_db = FindDb::TryLoad(handle, problem, [&](DbRecord& record) {
-        DirConvFindCore(handle,
-                        xDesc,
-                        x,
-                        wDesc,
-                        w,
-                        yDesc,
-                        workSpace,
-                        workSpaceSize,
-                        *this,
-                        exhaustiveSearch,
-                        record);
-    });
+    std::vector<PerfField> perf_db = FindDb::TryLoad(
+        handle,
+        problem,
+        [&](DbRecord& record) {
+            DirConvFindCore(handle,
+                            xDesc,
+                            x,
+                            wDesc,
+                            w,
+                            yDesc,
+                            workSpace,
+                            workSpaceSize,
+                            *this,
+                            exhaustiveSearch,
+                            record);
+        },
+        [&](const std::string& algorithm, const FindDbData& data) {
+            return DirConvRebuildKernels(handle, xDesc, wDesc, yDesc, *this, algorithm, data);
+        });
 
     if(perf_db.empty())
         MIOPEN_THROW("Fwd Convolution cannot be executed due to incorrect params");
@@ -1640,6 +1735,7 @@ void ConvolutionDescriptor::FindConvBwdDataAlgorithm(Handle& handle,
             ExtraKernelArgs eka;
             const auto all = FindDataDirectSolutions(
                 handle, dxDesc, wDesc, dyDesc, exhaustiveSearch, false, network_config, eka);
+            BuildKernelsAsync(handle, all);
             miopen::solver::ConvSolution selected{miopenStatusUnknownError};
             float best = std::numeric_limits<float>::max();
             visit_float(dyDesc.GetType(), [&](auto as_float) {
@@ -2676,6 +2772,7 @@ void ConvolutionDescriptor::FindConvBwdWeightsAlgorithm(Handle& handle,
                 miopen::solver::ConvSolution selected{miopenStatusUnknownError};
                 float best     = std::numeric_limits<float>::max();
                 const auto all = FindAllSolutions(construct_params);
+                BuildKernelsAsync(handle, all);
 
                 visit_float(dyDesc.GetType(), [&](auto as_float) {
                     for(const auto& sol : all)
@@ -8,7 +8,7 @@ miopenStatus_t FusionOpDescriptor::GetNetworkConfig(std::string& /*network_confi
 }
 
 miopenStatus_t
-FusionOpDescriptor::GetCompileParms(std::string& /*compile_config*/,
+FusionOpDescriptor::GetCompileParms(KernelBuildParameters& /*compile_config*/,
                                     Handle& /*handle*/,
                                     const FusionKernelSourceType /*source*/,
                                     const std::vector<solver::AnySolver>& /*solvers*/)
@@ -37,20 +37,17 @@ miopenStatus_t BiasFusionOpDescriptor::GetNetworkConfig(std::string& network_con
 }
 
 miopenStatus_t
-BiasFusionOpDescriptor::GetCompileParms(std::string& compile_config,
+BiasFusionOpDescriptor::GetCompileParms(KernelBuildParameters& compile_config,
                                         Handle& /*handle*/,
                                         FusionKernelSourceType source,
                                         const std::vector<solver::AnySolver>& /*solvers*/)
 {
-    std::string add;
     switch(source)
     {
-    case AsmText: add    = " -Wa,-defsym,bias_mode=" + std::to_string(1); break;
-    case OpenclText: add = " -DMLO_CONV_BIAS=" + std::to_string(1); break;
+    case AsmText: compile_config.Define("bias_mode", 1); break;
+    case OpenclText: compile_config.Define("MLO_CONV_BIAS", 1); break;
     case Binary: break;
     }
-    MIOPEN_LOG_I2(add);
-    compile_config += add;
     return miopenStatusSuccess;
 }
 
@@ -74,24 +71,22 @@ miopenStatus_t ActivFwdFusionOpDescriptor::GetNetworkConfig(std::string& network
 }
 
 miopenStatus_t
-ActivFwdFusionOpDescriptor::GetCompileParms(std::string& compile_config,
+ActivFwdFusionOpDescriptor::GetCompileParms(KernelBuildParameters& compile_config,
                                             Handle& /*handle*/,
                                             const FusionKernelSourceType source,
                                             const std::vector<solver::AnySolver>& /*solvers*/)
 {
-    std::string add;
     switch(source)
     {
     case AsmText:
-        add = " -Wa,-defsym,enable_activ=1 -Wa,-defsym,activ_mode=" + std::to_string(activMode);
+        compile_config << KernelBuildParameters{{"enable_activ", 1}, {"activ_mode", activMode}};
         break;
     case OpenclText:
-        add = " -DMIOPEN_YES_ACTIV=1 -DMIOPEN_NRN_OP_ID=" + std::to_string(activMode);
+        compile_config << KernelBuildParameters{{"MIOPEN_YES_ACTIV", 1},
+                                                {"MIOPEN_NRN_OP_ID", activMode}};
         break;
     case Binary: break;
     }
-    compile_config += add;
-    MIOPEN_LOG_I2(add);
     return miopenStatusSuccess;
 }
 
@@ -116,24 +111,22 @@ miopenStatus_t ActivBwdFusionOpDescriptor::GetNetworkConfig(std::string& network
 }
 
 miopenStatus_t
-ActivBwdFusionOpDescriptor::GetCompileParms(std::string& compile_config,
+ActivBwdFusionOpDescriptor::GetCompileParms(KernelBuildParameters& compile_config,
                                             Handle& /*handle*/,
                                             const FusionKernelSourceType source,
                                             const std::vector<solver::AnySolver>& /*solvers*/)
 {
-    std::string add;
     switch(source)
     {
     case AsmText:
-        add = " -Wa,-defsym,enable_activ=1 -Wa,-defsym,activ_mode=" + std::to_string(activMode);
+        compile_config << KernelBuildParameters{{"enable_activ", 1}, {"activ_mode", activMode}};
         break;
     case OpenclText:
-        add = " -DMIOPEN_YES_ACTIV=1 -DMIOPEN_NRN_OP_ID=" + std::to_string(activMode);
+        compile_config << KernelBuildParameters{{"MIOPEN_YES_ACTIV", 1},
+                                                {"MIOPEN_NRN_OP_ID", activMode}};
         break;
     case Binary: break;
     }
-    compile_config += add;
-    MIOPEN_LOG_I2(add);
     return miopenStatusSuccess;
 }
 
@@ -161,7 +154,7 @@ miopenStatus_t BatchNormInferenceFusionOpDescriptor::GetNetworkConfig(std::strin
 }
 
 miopenStatus_t BatchNormInferenceFusionOpDescriptor::GetCompileParms(
-    std::string& compile_config,
+    KernelBuildParameters& compile_config,
     Handle& /*handle*/,
     FusionKernelSourceType source,
     const std::vector<solver::AnySolver>& /*solvers*/)
@@ -171,11 +164,10 @@ miopenStatus_t BatchNormInferenceFusionOpDescriptor::GetCompileParms(
         MIOPEN_THROW("Invalid source file type");
     }
     std::vector<size_t> vld{256, 1, 1};
-    std::string add;
     if(mode == miopenBNSpatial)
-        add += " -DSPATIAL_BN";
+        compile_config.Define("SPATIAL_BN");
     else if(mode == miopenBNPerActivation)
-        add += " -DPERACT_BN";
+        compile_config.Define("PERACT_BN");
 
     if(input_desc.GetLengths().empty())
         MIOPEN_THROW("The input descriptor is not set");
@@ -194,18 +186,20 @@ miopenStatus_t BatchNormInferenceFusionOpDescriptor::GetCompileParms(
 
     if(input_desc.GetType() == miopenHalf)
     {
-        add += " -DMIOPEN_USE_FPMIX=1";
+        compile_config.Define("MIOPEN_USE_FPMIX", 1);
     }
 
-    add += " -DMIO_BN_CHW=" + std::to_string(c * h * w) + " -DMIO_BN_HW=" + std::to_string(h * w) +
-           " -DMIO_BN_N=" + std::to_string(n) + " -DMIO_BN_GRP0=" + std::to_string(vld.at(0)) +
-           " -DMIO_BN_GRP1=" + std::to_string(1) + " -DMIO_BN_GRP2=" + std::to_string(1);
-
     std::string READ_TYPE = (read_unit == 1) ? "_FLOAT" : "_FLOAT" + std::to_string(read_unit);
-    add += " -DMIOPEN_READ_UNIT=" + std::to_string(read_unit);
-    add += " -DMIOPEN_READ_TYPE=" + READ_TYPE;
-    compile_config += add;
-    MIOPEN_LOG_I2(add);
+    compile_config << KernelBuildParameters{
+        {"MIO_BN_CHW", c * h * w},
+        {"MIO_BN_HW", h * w},
+        {"MIO_BN_N", n},
+        {"MIO_BN_GRP0", vld.at(0)},
+        {"MIO_BN_GRP1", 1},
+        {"MIO_BN_GRP2", 1},
+        {"MIOPEN_READ_UNIT", read_unit},
+        {"MIOPEN_READ_TYPE", READ_TYPE},
+    };
     return miopenStatusSuccess;
 }
 
@@ -327,12 +321,11 @@ miopenStatus_t BatchNormBwdTrainFusionOpDescriptor::GetNetworkConfig(std::string
 }
 
 miopenStatus_t BatchNormBwdTrainFusionOpDescriptor::GetCompileParms(
-    std::string& compile_config,
+    KernelBuildParameters& compile_config,
     Handle& handle,
     FusionKernelSourceType /*source*/,
     const std::vector<solver::AnySolver>& /*solvers*/)
 {
-    std::string add;
     int n, c, h, w;
     int variant = 0;
     std::tie(n, c, h, w) = tien<4>(input_desc.GetLengths());
@@ -357,21 +350,25 @@ miopenStatus_t BatchNormBwdTrainFusionOpDescriptor::GetCompileParms(
 
     if(input_desc.GetType() == miopenHalf)
     {
-        add += " -DMIOPEN_USE_FPMIX=1";
+        compile_config.Define("MIOPEN_USE_FPMIX", 1);
     }
 
-    add += " -DMIO_BN_N=" + std::to_string(n) + " -DMIO_BN_C=" + std::to_string(c) +
-           " -DMIO_BN_HW=" + std::to_string(in_cstride) + " -DMIO_BN_NHW=" +
-           std::to_string(n * h * w) + " -DMIO_BN_CHW=" + std::to_string(in_nstride) +
-           " -DMIO_BN_NCHW=" + std::to_string(in_nchw) + " -DMIO_BN_GRP0=" +
-           std::to_string(xlocalsize) + " -DMIO_BN_GRP1=" + std::to_string(ylocalsize) +
-           " -DMIO_BN_GRP2=" + std::to_string(zlocalsize) + " -DMIO_BN_LDS_SIZE=" +
-           std::to_string(ldsnogcn) + " -DMIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) +
-           " -DMIO_BN_USESAVED=" + std::to_string(static_cast<int>(true)) + " -DMIO_BN_VARIANT=" +
-           std::to_string(variant) + " -DMIO_BN_CBA_WRITE_INTERMEDIATE=" + std::to_string(0);
-
-    compile_config += add;
-    MIOPEN_LOG_I2(add);
+    compile_config << KernelBuildParameters{
+        {"MIO_BN_N", n},
+        {"MIO_BN_C", c},
+        {"MIO_BN_HW", in_cstride},
+        {"MIO_BN_NHW", n * h * w},
+        {"MIO_BN_CHW", in_nstride},
+        {"MIO_BN_NCHW", in_nchw},
+        {"MIO_BN_GRP0", xlocalsize},
+        {"MIO_BN_GRP1", ylocalsize},
+        {"MIO_BN_GRP2", zlocalsize},
+        {"MIO_BN_LDS_SIZE", ldsnogcn},
+        {"MIO_BN_LDSGCN_SIZE", ldsgcn},
+        {"MIO_BN_USESAVED", static_cast<int>(true)},
+        {"MIO_BN_VARIANT", variant},
+        {"MIO_BN_CBA_WRITE_INTERMEDIATE", 0},
+    };
     return miopenStatusSuccess;
 }
 
@@ -524,12 +521,11 @@ miopenStatus_t BatchNormFwdTrainFusionOpDescriptor::GetNetworkConfig(std::string
 }
 
 miopenStatus_t BatchNormFwdTrainFusionOpDescriptor::GetCompileParms(
-    std::string& compile_config,
+    KernelBuildParameters& compile_config,
     Handle& handle,
     FusionKernelSourceType /*source*/,
     const std::vector<solver::AnySolver>& /*solvers*/)
 {
-    std::string add;
     int n, c, h, w;
     int variant         = 0;
     bool saveBatchStats = true;
@@ -557,35 +553,39 @@ miopenStatus_t BatchNormFwdTrainFusionOpDescriptor::GetCompileParms(
     size_t read_len  = (mode == miopenBNSpatial) ? in_cstride : in_nstride;
     if(mode == miopenBNSpatial)
     {
-        add += " -DSPATIAL_BN";
+        compile_config.Define("SPATIAL_BN");
         read_unit = (read_len % 4 == 0) ? 4 : (read_len % 2 == 0) ? 2 : 1;
     }
     else
     {
-        add += " -DPERACT_BN";
+        compile_config.Define("PERACT_BN");
         read_unit = 1;
     }
     std::string READ_TYPE = (read_unit == 1) ? "_FLOAT" : "_FLOAT" + std::to_string(read_unit);
 
     if(input_desc.GetType() == miopenHalf)
     {
-        add += " -DMIOPEN_USE_FPMIX=1";
+        compile_config.Define("MIOPEN_USE_FPMIX", 1);
     }
 
-    add += " -DMIO_BN_N=" + std::to_string(n) + " -DMIO_BN_C=" + std::to_string(c) +
-           " -DMIO_BN_HW=" + std::to_string(in_cstride) + " -DMIO_BN_NHW=" +
-           std::to_string(n * h * w) + " -DMIO_BN_CHW=" + std::to_string(in_nstride) +
-           " -DMIO_BN_NCHW=" + std::to_string(in_nchw) + " -DMIO_BN_GRP0=" +
-           std::to_string(xlocalsize) + " -DMIO_BN_GRP1=" + std::to_string(ylocalsize) +
-           " -DMIO_BN_GRP2=" + std::to_string(zlocalsize) + " -DMIO_BN_LDS_SIZE=" +
-           std::to_string(ldsnogcn) + " -DMIO_BN_LDSGCN_SIZE=" + std::to_string(ldsgcn) +
-           " -DMIOPEN_READ_UNIT=" + std::to_string(read_unit) + " -DMIOPEN_READ_TYPE=" + READ_TYPE +
-           " -DMIO_SAVE_MEAN_VARIANCE=" + ((saveBatchStats) ? "1" : "0") +
-           " -DMIO_RUNNING_RESULT=" + ((savePopStats) ? "1" : "0") + " -DMIO_BN_VARIANT=" +
-           std::to_string(variant);
-
-    compile_config += add;
-    MIOPEN_LOG_I2(add);
+    compile_config << KernelBuildParameters{
+        {"MIO_BN_N", n},
+        {"MIO_BN_C", c},
+        {"MIO_BN_HW", in_cstride},
+        {"MIO_BN_NHW", n * h * w},
+        {"MIO_BN_CHW", in_nstride},
+        {"MIO_BN_NCHW", in_nchw},
+        {"MIO_BN_GRP0", xlocalsize},
+        {"MIO_BN_GRP1", ylocalsize},
+        {"MIO_BN_GRP2", zlocalsize},
+        {"MIO_BN_LDS_SIZE", ldsnogcn},
+        {"MIO_BN_LDSGCN_SIZE", ldsgcn},
+        {"MIOPEN_READ_UNIT", read_unit},
+        {"MIOPEN_READ_TYPE", READ_TYPE},
+        {"MIO_SAVE_MEAN_VARIANCE", saveBatchStats ? 1 : 0},
+        {"MIO_RUNNING_RESULT", savePopStats ? 1 : 0},
+        {"MIO_BN_VARIANT", variant},
+    };
     return miopenStatusSuccess;
 }
 
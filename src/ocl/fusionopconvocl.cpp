@@ -1,6 +1,5 @@
 #include <miopen/fusion.hpp>
 #include <miopen/solver.hpp>
-#include <miopen/gcn_asm_utils.hpp>
 
 namespace miopen {
 
@@ -26,7 +25,7 @@ miopenStatus_t ConvForwardOpDescriptor::GetNetworkConfig(std::string& network_co
 }
 
 miopenStatus_t
-ConvForwardOpDescriptor::GetCompileParms(std::string& compile_config,
+ConvForwardOpDescriptor::GetCompileParms(KernelBuildParameters& compile_config,
                                          Handle& handle,
                                          FusionKernelSourceType source,
                                          const std::vector<solver::AnySolver>& solvers)
@@ -39,14 +38,10 @@ ConvForwardOpDescriptor::GetCompileParms(std::string& compile_config,
     }
     kernel_info           = solution.construction_params[0];
     kernel_info_valid     = true;
+    // Already canonical, so it goes to the compiler ahead of the fusion defines as is.
     conv_compiler_options = solution.construction_params[0].comp_options;
-    compile_config += conv_compiler_options;
     if(source == AsmText)
-    {
-        std::ostringstream options;
-        GenerateClangDefsym(options, "fusion_mode", 1);
-        compile_config += options.str();
-    }
+        compile_config.Define("fusion_mode", 1);
     return miopenStatusSuccess;
 }
 std::vector<size_t> ConvForwardOpDescriptor::GetLocalWGSz(Handle& /*handle*/,
@@ -30,6 +30,7 @@
 #include <miopen/kernel_cache.hpp>
 #include <miopen/manage_ptr.hpp>
 #include <miopen/ocldeviceinfo.hpp>
+#include <miopen/program_registry.hpp>
 #include <miopen/binary_cache.hpp>
 #include <miopen/load_file.hpp>
 #include <boost/filesystem.hpp>
@@ -263,9 +264,11 @@ struct HandleImpl
     ContextPtr context;
     AqPtr queue;
     Allocator allocator{};
+    BinaryCacheCounters binary_cache_counters;
     KernelCache cache;
     bool enable_profiling  = false;
     float profiling_result = 0.0;
+    bool own_context       = false; // The context is created by and private to the handle.
 
     ContextPtr create_context()
     {
@@ -362,7 +365,8 @@ Handle::Handle() : impl(new HandleImpl())
     // Create an OpenCL context
     /////////////////////////////////////////////////////////////////
 
-    impl->context = impl->create_context();
+    impl->context     = impl->create_context();
+    impl->own_context = true;
     /* First, get the size of device list data */
     cl_uint deviceListSize;
     if(clGetContextInfo(impl->context.get(),
@@ -433,7 +437,24 @@ Handle::Handle() : impl(new HandleImpl())
 }
 
 Handle::Handle(Handle&&) noexcept = default;
-Handle::~Handle()                 = default;
+
+Handle::~Handle()
+{
+    if(impl == nullptr)
+        return;
+
+    // The builds run on behalf of the handle, so they shall end before it does.
+    FinishBuilds();
+    LogBinaryCacheStats(impl->binary_cache_counters.Get());
+
+    if(!impl->own_context)
+        return;
+
+    // Programs of a private context are of no use to anyone else.
+    const auto scope = GetProgramScope();
+    impl.reset();
+    ProgramRegistry::Instance().Forget(scope);
+}
 
 void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 {
@@ -448,6 +469,34 @@ void Handle::SetStream(miopenAcceleratorQueue_t streamID) const
 
 miopenAcceleratorQueue_t Handle::GetStream() const { return impl->queue.get(); }
 
+Handle Handle::CreateSibling() const
+{
+    cl_device_id device;
+    if(clGetCommandQueueInfo(
+           impl->queue.get(), CL_QUEUE_DEVICE, sizeof(cl_device_id), &device, nullptr) !=
+       CL_SUCCESS)
+    {
+        MIOPEN_THROW("Error: Getting Handle Info (device, clGetCommandQueueInfo)");
+    }
+
+    cl_int status = 0;
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+#endif
+    const HandleImpl::AqPtr queue{
+        clCreateCommandQueue(impl->context.get(), device, CL_QUEUE_PROFILING_ENABLE, &status)};
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+    if(status != CL_SUCCESS)
+    {
+        MIOPEN_THROW_CL_STATUS(status, "Creating Command Queue. (clCreateCommandQueue)");
+    }
+    // The new handle retains the queue and takes the context from it.
+    return Handle{queue.get()};
+}
+
 void Handle::SetAllocator(miopenAllocatorFunction allocator,
                           miopenDeallocatorFunction deallocator,
                           void* allocatorContext) const
@@ -485,6 +534,13 @@ KernelInvoke Handle::AddKernel(const std::string& algorithm,
     return this->Run(obj);
 }
 
+void Handle::BuildProgramAsync(const std::string& program_name, const std::string& params)
+{
+    this->impl->cache.BuildProgramAsync(*this, program_name, params);
+}
+
+std::size_t Handle::FinishBuilds() { return this->impl->cache.FinishBuilds(); }
+
 bool Handle::HasKernel(const std::string& algorithm, const std::string& network_config) const
 {
     return this->impl->cache.HasKernels(algorithm, network_config);
@@ -496,8 +552,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config)
+std::shared_ptr<const std::vector<Kernel>>
+Handle::GetKernelsImpl(const std::string& algorithm, const std::string& network_config)
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -520,36 +576,48 @@ KernelInvoke Handle::Run(Kernel k)
 
 Program Handle::LoadProgram(const std::string& program_name, std::string params, bool is_kernel_str)
 {
-    auto cache_file =
+    const auto start  = BinaryCacheCounters::Clock::now();
+    const auto binary =
         miopen::LoadBinary(this->GetDeviceName(), program_name, params, is_kernel_str);
-    if(cache_file.empty())
+    if(binary.empty())
     {
         auto p = miopen::LoadProgram(miopen::GetContext(this->GetStream()),
                                      miopen::GetDevice(this->GetStream()),
                                      program_name,
                                      params,
                                      is_kernel_str);
+        this->impl->binary_cache_counters.AddMiss(start);
 
         // Save to cache
-        auto path = miopen::GetCachePath() / boost::filesystem::unique_path();
-        miopen::SaveProgramBinary(p, path.string());
-        miopen::SaveBinary(
-            path.string(), this->GetDeviceName(), program_name, params, is_kernel_str);
+        miopen::SaveBinary(miopen::GetProgramBinary(p),
+                           this->GetDeviceName(),
+                           program_name,
+                           params,
+                           is_kernel_str);
 
-        return std::move(p);
+        return p;
     }
     else
     {
-        return LoadBinaryProgram(miopen::GetContext(this->GetStream()),
-                                 miopen::GetDevice(this->GetStream()),
-                                 miopen::LoadFile(cache_file));
+        auto p = LoadBinaryProgram(miopen::GetContext(this->GetStream()),
+                                   miopen::GetDevice(this->GetStream()),
+                                   binary);
+        this->impl->binary_cache_counters.AddHit(start);
+        return p;
     }
 }
 
+BinaryCacheStats Handle::GetBinaryCacheStats() const
+{
+    return this->impl->binary_cache_counters.Get();
+}
+
 void Handle::Finish() const { clFinish(this->GetStream()); }
 
 void Handle::Flush() const { clFlush(this->GetStream()); }
 
+const void* Handle::GetProgramScope() const { return this->impl->context.get(); }
+
 bool Handle::IsProfilingEnabled() const { return this->impl->enable_profiling; }
 
 std::size_t Handle::GetLocalMemorySize()
@@ -0,0 +1,436 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/packed_cache.hpp>
+#include <miopen/db.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/fast_hash.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <random>
+#include <unordered_set>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace miopen {
+
+static std::uint64_t Checksum(const char* data, std::size_t size)
+{
+    return FastHash64(data, size);
+}
+
+static std::uint32_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+static void WriteHeader(std::ostream& file)
+{
+    PackedCacheHeader header{};
+    std::memcpy(header.magic, PackedCacheHeader::Magic(), sizeof(header.magic));
+    header.version    = PackedCacheHeader::CurrentVersion();
+    header.generation = std::random_device{}();
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+static void WriteRecord(std::ostream& file,
+                        const std::string& key,
+                        const char* blob,
+                        std::size_t blob_size,
+                        std::uint32_t last_use)
+{
+    PackedCacheRecord header{};
+    header.key_size  = key.size();
+    header.last_use  = last_use;
+    header.blob_size = blob_size;
+    header.checksum  = Checksum(blob, blob_size);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(key.data(), key.size());
+    file.write(blob, blob_size);
+}
+
+PackedCacheView::PackedCacheView(const std::string& filename,
+                                 const FileStamp& stamp_,
+                                 const PackedCacheView* previous)
+    : stamp(stamp_)
+{
+    if(stamp.size < sizeof(PackedCacheHeader))
+        return;
+
+    const boost::interprocess::file_mapping mapping(filename.c_str(),
+                                                    boost::interprocess::read_only);
+    boost::interprocess::mapped_region(mapping, boost::interprocess::read_only, 0, stamp.size)
+        .swap(region);
+
+    const auto data = Data();
+    const auto size = stamp.size;
+
+    PackedCacheHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if(std::memcmp(header.magic, PackedCacheHeader::Magic(), sizeof(header.magic)) != 0 ||
+       header.version != PackedCacheHeader::CurrentVersion())
+    {
+        MIOPEN_LOG_W("Packed cache is invalid or has unsupported version: " << filename);
+        return;
+    }
+
+    generation         = header.generation;
+    std::size_t offset = sizeof(header);
+
+    // Records are only appended, so the ones seen before are still in place.
+    if(previous != nullptr && previous->complete_size != 0 &&
+       previous->generation == generation && previous->stamp.node == stamp.node &&
+       previous->stamp.size <= size)
+    {
+        entries = previous->entries;
+        offset  = previous->complete_size;
+    }
+
+    while(size - offset >= sizeof(PackedCacheRecord))
+    {
+        PackedCacheRecord record;
+        std::memcpy(&record, data + offset, sizeof(record));
+        const auto key_offset = offset + sizeof(record);
+
+        if(record.key_size > size - key_offset ||
+           record.blob_size > size - key_offset - record.key_size)
+            break;
+
+        const auto blob_offset = key_offset + record.key_size;
+        entries[std::string(data + key_offset, record.key_size)] = Entry{
+            offset, blob_offset, static_cast<std::size_t>(record.blob_size), record.checksum};
+        offset = blob_offset + record.blob_size;
+    }
+
+    complete_size = offset;
+
+    if(complete_size != size)
+        MIOPEN_LOG_W("Incomplete packed cache record ignored: " << filename);
+
+    MIOPEN_LOG_I2("Indexed " << entries.size() << " programs from " << filename);
+}
+
+const PackedCacheView::Entry* PackedCacheView::Find(const std::string& key) const
+{
+    const auto found = entries.find(key);
+    return found != entries.end() ? &found->second : nullptr;
+}
+
+bool PackedCacheView::IsIntact(const Entry& entry) const
+{
+    return Checksum(Data() + entry.blob_offset, entry.blob_size) == entry.checksum;
+}
+
+std::uint32_t PackedCacheView::GetLastUse(const Entry& entry) const
+{
+    std::uint32_t last_use;
+    std::memcpy(&last_use,
+                Data() + entry.record_offset + offsetof(PackedCacheRecord, last_use),
+                sizeof(last_use));
+    return last_use;
+}
+
+PackedCache::PackedCache(std::string filename_) : filename(std::move(filename_)) {}
+
+PackedCache::~PackedCache()
+{
+#ifndef _WIN32
+    if(usage_fd >= 0)
+        close(usage_fd);
+#endif
+}
+
+PackedCache& PackedCache::Get(const std::string& filename)
+{
+    static std::mutex mutex;
+    static std::map<std::string, std::unique_ptr<PackedCache>> instances;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto& instance = instances[filename];
+    if(instance == nullptr)
+        instance.reset(new PackedCache(filename));
+    return *instance;
+}
+
+std::shared_ptr<const PackedCacheView> PackedCache::GetView()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return view;
+}
+
+std::shared_ptr<const PackedCacheView> PackedCache::Refresh()
+{
+    const auto stamp = FileStamp::Get(filename);
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if(!stamp.exists)
+        view = nullptr;
+    else if(view == nullptr || view->Stamp() != stamp)
+    {
+        try
+        {
+            view = std::make_shared<const PackedCacheView>(filename, stamp, view.get());
+        }
+        catch(const boost::interprocess::interprocess_exception& ex)
+        {
+            MIOPEN_LOG_I2("Unable to map " << filename << ": " << ex.what());
+            view = nullptr;
+        }
+    }
+    return view;
+}
+
+std::string PackedCache::Load(const std::string& key)
+{
+    auto current = GetView();
+    auto entry   = current != nullptr ? current->Find(key) : nullptr;
+
+    if(entry == nullptr)
+    {
+        current = Refresh();
+        entry   = current != nullptr ? current->Find(key) : nullptr;
+    }
+
+    if(entry == nullptr)
+        return {};
+
+    if(!current->IsIntact(*entry))
+    {
+        MIOPEN_LOG_W("Corrupted program ignored: " << key << " from " << filename);
+        return {};
+    }
+
+    Touch(*current, *entry);
+    return {current->Data() + entry->blob_offset, entry->blob_size};
+}
+
+void PackedCache::Touch(const PackedCacheView& current, const PackedCacheView::Entry& entry)
+{
+    // Programs loaded often are not written each time.
+    const auto now = Now();
+    if(current.GetLastUse(entry) + 3600 > now)
+        return;
+
+#ifndef _WIN32
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if(usage_fd < 0 || usage_node != current.Stamp().node)
+    {
+        if(usage_fd >= 0)
+            close(usage_fd);
+
+        // The file may have been replaced since the view was made.
+        struct stat st;
+        usage_fd = open(filename.c_str(), O_WRONLY);
+        if(usage_fd >= 0 && (fstat(usage_fd, &st) != 0 || st.st_ino != current.Stamp().node))
+        {
+            close(usage_fd);
+            usage_fd = -1;
+        }
+        if(usage_fd < 0)
+            return;
+        usage_node = current.Stamp().node;
+    }
+
+    const auto offset = entry.record_offset + offsetof(PackedCacheRecord, last_use);
+    if(pwrite(usage_fd, &now, sizeof(now), offset) != sizeof(now))
+        MIOPEN_LOG_I2("Unable to update last use of a program in " << filename);
+#endif
+}
+
+bool PackedCache::Store(const std::string& key, const std::string& blob)
+{
+    return Store({std::make_pair(key, blob)}) >= 0;
+}
+
+int PackedCache::Store(const std::vector<std::pair<std::string, std::string>>& records)
+{
+    auto& lock_file = LockFile::Get(LockFilePath(filename).c_str());
+    const auto lock = std::unique_lock<LockFile>(lock_file, std::chrono::seconds{60});
+    if(!lock)
+        MIOPEN_THROW("Packed cache lock has failed to lock.");
+
+    // Other processes may have appended something since the last look.
+    const auto current       = Refresh();
+    const auto size          = current != nullptr ? current->Stamp().size : 0;
+    const auto complete_size = current != nullptr ? current->CompleteSize() : 0;
+
+    std::unordered_set<std::string> appended;
+    std::vector<const std::pair<std::string, std::string>*> to_append;
+
+    for(const auto& record : records)
+    {
+        if(current != nullptr && current->Find(record.first) != nullptr)
+            continue;
+        if(appended.insert(record.first).second)
+            to_append.push_back(&record);
+    }
+
+    if(to_append.empty())
+        return 0;
+
+    // Drop the tail left by an interrupted write, or the whole file of unknown format.
+    if(size != complete_size)
+    {
+        MIOPEN_LOG_W("Truncating packed cache: " << filename);
+        boost::filesystem::resize_file(filename, complete_size);
+    }
+
+    {
+        std::ofstream file(filename, std::ios::binary | std::ios::app);
+
+        if(!file)
+        {
+            MIOPEN_LOG_E("File is unwritable: " << filename);
+            return -1;
+        }
+
+        if(complete_size == 0)
+            WriteHeader(file);
+
+        const auto now = Now();
+        for(const auto record : to_append)
+            WriteRecord(file, record->first, record->second.data(), record->second.size(), now);
+
+        if(!file.flush())
+        {
+            MIOPEN_LOG_E("Unable to write: " << filename);
+            return -1;
+        }
+    }
+
+    boost::filesystem::permissions(filename, boost::filesystem::all_all);
+
+    const auto limit = size_limit.load();
+    if(limit != 0 && FileStamp::Get(filename).size > limit)
+    {
+        const auto updated = Refresh();
+        if(updated != nullptr)
+        {
+            EvictUnsafe(*updated, limit);
+            Refresh();
+        }
+    }
+
+    return static_cast<int>(to_append.size());
+}
+
+void PackedCache::EvictUnsafe(const PackedCacheView& current, std::uint64_t limit)
+{
+    using Item = std::pair<std::uint32_t, decltype(&*current.Entries().begin())>;
+    std::vector<Item> items;
+    for(const auto& entry : current.Entries())
+        items.emplace_back(current.GetLastUse(entry.second), &entry);
+
+    std::sort(items.begin(), items.end(), [](const Item& lhs, const Item& rhs) {
+        return lhs.first > rhs.first;
+    });
+
+    const auto temp_filename = filename + ".evict.tmp";
+    const auto target        = limit / 4 * 3;
+    std::uint64_t size       = sizeof(PackedCacheHeader);
+    std::size_t kept         = 0;
+
+    {
+        std::ofstream file(temp_filename, std::ios::binary | std::ios::trunc);
+        WriteHeader(file);
+
+        for(const auto& item : items)
+        {
+            const auto& key   = item.second->first;
+            const auto& entry = item.second->second;
+            if(!current.IsIntact(entry))
+                continue;
+
+            size += sizeof(PackedCacheRecord) + key.size() + entry.blob_size;
+            if(size > target)
+                break;
+
+            WriteRecord(file, key, current.Data() + entry.blob_offset, entry.blob_size, item.first);
+            ++kept;
+        }
+
+        if(!file.flush())
+        {
+            MIOPEN_LOG_E("Unable to write: " << temp_filename);
+            boost::system::error_code ec;
+            boost::filesystem::remove(temp_filename, ec);
+            return;
+        }
+    }
+
+    boost::system::error_code ec;
+    boost::filesystem::permissions(temp_filename, boost::filesystem::all_all, ec);
+    boost::filesystem::rename(temp_filename, filename, ec);
+
+    if(ec)
+    {
+        MIOPEN_LOG_E("Unable to replace " << filename << ": " << ec.message());
+        boost::filesystem::remove(temp_filename, ec);
+        return;
+    }
+
+    MIOPEN_LOG_I("Evicted " << items.size() - kept << " least recently used programs from "
+                            << filename);
+}
+
+void PackedCache::Visit(
+    const std::function<void(const std::string& key, const char* blob, std::size_t size)>& f)
+{
+    const auto current = Refresh();
+    if(current == nullptr)
+        return;
+
+    for(const auto& entry : current->Entries())
+    {
+        if(!current->IsIntact(entry.second))
+        {
+            MIOPEN_LOG_W("Corrupted program ignored: " << entry.first << " from " << filename);
+            continue;
+        }
+        f(entry.first, current->Data() + entry.second.blob_offset, entry.second.blob_size);
+    }
+}
+
+} // namespace miopen
@@ -0,0 +1,169 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/compile_pool.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/program_registry.hpp>
+
+#include <chrono>
+#include <exception>
+#include <memory>
+
+namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_PROGRAM_REGISTRY_IDLE_SIZE)
+
+ProgramRegistry& ProgramRegistry::Instance()
+{
+    static const auto size = Value(MIOPEN_PROGRAM_REGISTRY_IDLE_SIZE{});
+    static ProgramRegistry instance(size != 0 ? size : DefaultIdleCapacity());
+    return instance;
+}
+
+static bool IsFailed(const std::shared_future<Program>& program)
+{
+    if(program.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        return false;
+    try
+    {
+        program.get();
+        return false;
+    }
+    catch(...)
+    {
+        return true;
+    }
+}
+
+void ProgramRegistry::AddReference(Entry& entry)
+{
+    if(entry.references++ == 0)
+    {
+        idle.erase(entry.idle_position);
+        entry.idle_position = idle.end();
+    }
+}
+
+std::shared_future<Program>
+ProgramRegistry::Acquire(const Key& key, const Build& build, bool async)
+{
+    auto promise = std::make_shared<std::promise<Program>>();
+    std::shared_future<Program> program;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        const auto it = entries.find(key);
+        if(it != entries.end() && !IsFailed(it->second.program))
+        {
+            ++hits;
+            AddReference(it->second);
+            MIOPEN_LOG_I2("Program registry hit: " << key.program_name << ',' << key.params);
+            return it->second.program;
+        }
+
+        ++misses;
+        program = promise->get_future().share();
+        if(it == entries.end())
+        {
+            entries.emplace(key, Entry{program, 1, idle.end()});
+        }
+        else
+        {
+            AddReference(it->second);
+            it->second.program = program;
+        }
+    }
+
+    const auto task = [promise, build]() {
+        try
+        {
+            promise->set_value(build());
+        }
+        catch(...)
+        {
+            promise->set_exception(std::current_exception());
+        }
+    };
+
+    if(async)
+        CompilePool::Instance().Submit(task);
+    else
+        task();
+    return program;
+}
+
+void ProgramRegistry::Release(const Key& key)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto it = entries.find(key);
+    if(it == entries.end() || it->second.references == 0 || --it->second.references != 0)
+        return;
+
+    idle.push_front(key);
+    it->second.idle_position = idle.begin();
+    if(idle.size() > idle_capacity)
+    {
+        entries.erase(idle.back());
+        idle.pop_back();
+    }
+}
+
+void ProgramRegistry::Forget(const void* scope)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for(auto it = idle.begin(); it != idle.end();)
+    {
+        if(it->scope == scope)
+        {
+            entries.erase(*it);
+            it = idle.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+std::size_t ProgramRegistry::Size() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+std::size_t ProgramRegistry::Hits() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+std::size_t ProgramRegistry::Misses() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+} // namespace miopen
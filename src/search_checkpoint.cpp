@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/search_checkpoint.hpp>
+#include <miopen/db.hpp>
+#include <miopen/logger.hpp>
+
+#include <iomanip>
+#include <sstream>
+#include <utility>
+
+namespace miopen {
+namespace solver {
+
+void SearchCheckpoint::Serialize(std::ostream& stream) const
+{
+    const auto precision = stream.precision(std::numeric_limits<float>::max_digits10);
+    stream << static_cast<int>(strategy) << ',' << seed << ',' << size << ',' << position << ','
+           << best_time << ',' << best_config;
+    stream.precision(precision);
+}
+
+bool SearchCheckpoint::Deserialize(const std::string& str)
+{
+    std::istringstream ss(str);
+    int strategy_;
+    unsigned seed_;
+    std::size_t size_;
+    std::size_t position_;
+    float best_time_;
+    char c0 = 0, c1 = 0, c2 = 0, c3 = 0, c4 = 0;
+    if(!(ss >> strategy_ >> c0 >> seed_ >> c1 >> size_ >> c2 >> position_ >> c3 >> best_time_ >>
+         c4) ||
+       c0 != ',' || c1 != ',' || c2 != ',' || c3 != ',' || c4 != ',')
+        return false;
+    const auto kind = static_cast<SearchStrategyKind>(strategy_);
+    if(kind < SearchStrategyKind::First_ || SearchStrategyKind::Last_ < kind)
+        return false;
+
+    std::string config;
+    std::getline(ss, config);
+    strategy    = kind;
+    seed        = seed_;
+    size        = size_;
+    position    = position_;
+    best_time   = best_time_;
+    best_config = std::move(config);
+    return true;
+}
+
+SearchCheckpoints::SearchCheckpoints(std::string path_,
+                                     DbKey key_,
+                                     std::string id_,
+                                     std::chrono::milliseconds interval_)
+    : path(std::move(path_)), key(std::move(key_)), id(std::move(id_)), interval(interval_)
+{
+}
+
+bool SearchCheckpoints::Load(SearchCheckpoint& checkpoint) const
+{
+    Db db{path, false};
+    return db.Load(key, id, checkpoint);
+}
+
+bool SearchCheckpoints::Exists() const
+{
+    SearchCheckpoint checkpoint;
+    return Load(checkpoint);
+}
+
+void SearchCheckpoints::Save(const SearchCheckpoint& checkpoint, const bool force)
+{
+    const auto now = std::chrono::steady_clock::now();
+    if(!force && saved && now - last_save < interval)
+        return;
+    Db db{path, false};
+    if(!db.Update(key, id, checkpoint))
+        MIOPEN_LOG_W("Search checkpoint not saved: " << id << " to " << path);
+    last_save = now;
+    saved     = true;
+}
+
+void SearchCheckpoints::Remove()
+{
+    Db db{path, false};
+    db.Remove(key, id);
+    saved = false;
+}
+
+} // namespace solver
+} // namespace miopen
@@ -0,0 +1,74 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/search_cost_model.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace miopen {
+namespace solver {
+
+static float DivideRoundUp(float x, float y) { return std::ceil(x / y); }
+
+float EstimateSolutionCost(const ConvolutionContext& context,
+                           const ConvSolution& solution,
+                           const std::size_t compute_units)
+{
+    const float work = static_cast<float>(context.batch_sz) * context.n_inputs *
+                       context.n_outputs * context.out_height * context.out_width *
+                       context.kernel_size_h * context.kernel_size_w;
+
+    float reuse = 1.0f;
+    if(solution.out_pix_tile0 > 0 && solution.out_pix_tile1 > 0)
+        reuse *= static_cast<float>(solution.out_pix_tile0) * solution.out_pix_tile1;
+    if(solution.n_out_pix_tiles > 0)
+        reuse *= solution.n_out_pix_tiles;
+    if(solution.n_stacks > 0)
+        reuse *= solution.n_stacks;
+    const float traffic = 1.0f + 1.0f / reuse;
+
+    const float simds = 4.0f * std::max<std::size_t>(compute_units, 1);
+    float cost        = 0.0f;
+    for(const auto& kernel : solution.construction_params)
+    {
+        float groups     = 1.0f;
+        float group_size = 1.0f;
+        for(std::size_t i = 0; i < kernel.g_wk.size() && i < kernel.l_wk.size(); ++i)
+        {
+            groups *= DivideRoundUp(kernel.g_wk[i], std::max<std::size_t>(kernel.l_wk[i], 1));
+            group_size *= std::max<std::size_t>(kernel.l_wk[i], 1);
+        }
+
+        const float waves = groups * DivideRoundUp(group_size, wave_size);
+        cost += DivideRoundUp(waves, simds) * (work / waves) * traffic;
+    }
+    return cost;
+}
+
+} // namespace solver
+} // namespace miopen
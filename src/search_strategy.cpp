@@ -0,0 +1,297 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/search_strategy.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/make_unique.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <string>
+#include <unordered_set>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_STRATEGY)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_SEED)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_BUDGET)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_SAMPLES)
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SEARCH_TOP_K)
+
+namespace miopen {
+namespace solver {
+
+constexpr std::size_t SearchSpace::npos;
+constexpr float SearchSpace::failed;
+
+std::ostream& operator<<(std::ostream& os, SearchStrategyKind kind)
+{
+    switch(kind)
+    {
+    case SearchStrategyKind::Exhaustive: return os << "EXHAUSTIVE";
+    case SearchStrategyKind::Random: return os << "RANDOM";
+    case SearchStrategyKind::Halving: return os << "HALVING";
+    case SearchStrategyKind::Evolution: return os << "EVOLUTION";
+    }
+    return os << "<Unknown>";
+}
+
+std::size_t RandomIndex(std::size_t size, std::mt19937& rng)
+{
+    // std::mt19937 itself is specified exactly. Its 32-bit outputs are combined as needed
+    // and the ones past the last multiple of size are rejected, which avoids a bias.
+    const auto wide         = static_cast<std::uint64_t>(size) > 0xFFFFFFFFull;
+    const std::uint64_t max = wide ? std::numeric_limits<std::uint64_t>::max() : 0xFFFFFFFFull;
+    const auto limit        = max - max % size;
+    for(;;)
+    {
+        std::uint64_t x = rng();
+        if(wide)
+            x = (x << 32) | rng();
+        if(x < limit)
+            return static_cast<std::size_t>(x % size);
+    }
+}
+
+namespace {
+
+SearchStrategyKind GetSearchStrategyKindImpl()
+{
+    const char* const p_asciz = miopen::GetStringEnv(MIOPEN_SEARCH_STRATEGY{});
+    if(p_asciz == nullptr)
+        return SearchStrategyKind::Default_;
+    std::string str = p_asciz;
+    for(auto& c : str)
+        c = toupper(static_cast<unsigned char>(c));
+    if(str == "EXHAUSTIVE")
+        return SearchStrategyKind::Exhaustive;
+    else if(str == "RANDOM")
+        return SearchStrategyKind::Random;
+    else if(str == "HALVING")
+        return SearchStrategyKind::Halving;
+    else if(str == "EVOLUTION")
+        return SearchStrategyKind::Evolution;
+    else
+    { // Nop. Fall down & try numerics.
+    }
+    const auto val = static_cast<SearchStrategyKind>(miopen::Value(MIOPEN_SEARCH_STRATEGY{}));
+    if(SearchStrategyKind::First_ <= val && val <= SearchStrategyKind::Last_)
+        return val;
+    MIOPEN_LOG_E("Wrong MIOPEN_SEARCH_STRATEGY, using default.");
+    return SearchStrategyKind::Default_;
+}
+
+std::size_t SampleCount(const SearchSpace& space, const SearchOptions& options)
+{
+    if(options.samples != 0)
+        return std::min(options.samples, space.Size());
+    return std::max(space.Size() / 10, std::min<std::size_t>(space.Size(), 16));
+}
+
+std::vector<std::size_t> Shuffled(std::size_t size, std::mt19937& rng)
+{
+    std::vector<std::size_t> indices(size);
+    std::iota(indices.begin(), indices.end(), 0);
+    for(auto i = size; i > 1; --i) // Fisher-Yates.
+        std::swap(indices[i - 1], indices[RandomIndex(i, rng)]);
+    return indices;
+}
+
+class ExhaustiveSearch : public SearchStrategy
+{
+    public:
+    void Run(SearchSpace& space) override
+    {
+        std::vector<std::size_t> all(space.Size());
+        std::iota(all.begin(), all.end(), 0);
+        space.Plan(all.size());
+        space.Measure(all, Averaging::IfPromising);
+    }
+};
+
+class RandomSearch : public SearchStrategy
+{
+    SearchOptions options;
+
+    public:
+    RandomSearch(const SearchOptions& options_) : options(options_) {}
+
+    void Run(SearchSpace& space) override
+    {
+        std::mt19937 rng(options.seed);
+        auto candidates = Shuffled(space.Size(), rng);
+        // With a budget and no explicit count, the budget alone limits the search.
+        if(options.samples != 0 || options.budget.count() == 0)
+            candidates.resize(SampleCount(space, options));
+        space.Plan(candidates.size());
+        space.Measure(candidates, Averaging::IfPromising);
+    }
+};
+
+class HalvingSearch : public SearchStrategy
+{
+    SearchOptions options;
+    const std::size_t finalists = 4;
+
+    public:
+    HalvingSearch(const SearchOptions& options_) : options(options_) {}
+
+    void Run(SearchSpace& space) override
+    {
+        std::mt19937 rng(options.seed);
+        auto alive = Shuffled(space.Size(), rng);
+        alive.resize(SampleCount(space, options));
+        space.Plan(2 * alive.size() + finalists);
+
+        std::vector<float> total(space.Size(), 0.0f);
+        std::vector<int> runs(space.Size(), 0);
+        const auto mean = [&](std::size_t i) { return total[i] / runs[i]; };
+
+        while(alive.size() > finalists && !space.IsExpired())
+        {
+            const auto times = space.Measure(alive, Averaging::Single);
+            std::vector<std::size_t> passed;
+            for(std::size_t i = 0; i < alive.size(); ++i)
+            {
+                if(times[i] == SearchSpace::failed)
+                    continue;
+                total[alive[i]] += times[i];
+                ++runs[alive[i]];
+                passed.push_back(alive[i]);
+            }
+
+            std::stable_sort(passed.begin(), passed.end(), [&](auto lhs, auto rhs) {
+                return mean(lhs) < mean(rhs);
+            });
+            passed.resize(std::min(passed.size(), std::max(finalists, (passed.size() + 1) / 2)));
+            alive.swap(passed);
+            MIOPEN_LOG_I2("Successive halving: " << alive.size() << " left");
+        }
+
+        alive.resize(std::min(alive.size(), finalists));
+        space.Measure(alive, Averaging::Always);
+    }
+};
+
+class EvolutionSearch : public SearchStrategy
+{
+    SearchOptions options;
+    const std::size_t population_size = 16;
+    const int patience                = 3; // Generations without an improvement.
+
+    public:
+    EvolutionSearch(const SearchOptions& options_) : options(options_) {}
+
+    void Run(SearchSpace& space) override
+    {
+        std::mt19937 rng(options.seed);
+        const auto limit = SampleCount(space, options);
+        space.Plan(limit);
+
+        std::vector<std::pair<float, std::size_t>> population;
+        std::unordered_set<std::size_t> measured;
+        const auto add = [&](const std::vector<std::size_t>& candidates) {
+            const auto times = space.Measure(candidates, Averaging::IfPromising);
+            for(std::size_t i = 0; i < candidates.size(); ++i)
+            {
+                measured.insert(candidates[i]);
+                if(times[i] != SearchSpace::failed)
+                    population.emplace_back(times[i], candidates[i]);
+            }
+            std::sort(population.begin(), population.end());
+            if(population.size() > population_size)
+                population.resize(population_size);
+        };
+
+        auto initial = Shuffled(space.Size(), rng);
+        initial.resize(std::min(limit, population_size));
+        add(initial);
+
+        auto stale = 0;
+        while(measured.size() < limit && stale < patience && !space.IsExpired() &&
+              population.size() >= 2)
+        {
+            const auto best = population.front().first;
+            // Tournaments of two: the faster of two random members becomes a parent.
+            const auto parent = [&]() {
+                const auto first = RandomIndex(population.size(), rng);
+                return population[std::min(first, RandomIndex(population.size(), rng))].second;
+            };
+
+            std::vector<std::size_t> children;
+            const auto wanted = std::min(population_size, limit - measured.size());
+            for(std::size_t attempt = 0; children.size() < wanted && attempt < 8 * wanted;
+                ++attempt)
+            {
+                // Drawn in turn: the order arguments are evaluated in is unspecified.
+                const auto a     = parent();
+                const auto b     = parent();
+                const auto child = space.Recombine(a, b, rng);
+                if(child != SearchSpace::npos && measured.count(child) == 0 &&
+                   std::find(children.begin(), children.end(), child) == children.end())
+                    children.push_back(child);
+            }
+            if(children.empty())
+                break;
+
+            add(children);
+            stale = population.front().first < best ? 0 : stale + 1;
+            MIOPEN_LOG_I2("Evolution: " << measured.size() << " measured, best "
+                                        << population.front().first);
+        }
+    }
+};
+
+} // namespace
+
+SearchOptions SearchOptions::FromEnv()
+{
+    static const SearchOptions options = [] {
+        SearchOptions result;
+        result.strategy = GetSearchStrategyKindImpl();
+        result.seed     = static_cast<unsigned>(miopen::Value(MIOPEN_SEARCH_SEED{}));
+        result.budget   = std::chrono::seconds(miopen::Value(MIOPEN_SEARCH_BUDGET{}));
+        result.samples  = miopen::Value(MIOPEN_SEARCH_SAMPLES{});
+        result.top_k    = miopen::Value(MIOPEN_SEARCH_TOP_K{});
+        return result;
+    }();
+    return options;
+}
+
+std::unique_ptr<SearchStrategy> MakeSearchStrategy(const SearchOptions& options)
+{
+    switch(options.strategy)
+    {
+    case SearchStrategyKind::Exhaustive: return miopen::make_unique<ExhaustiveSearch>();
+    case SearchStrategyKind::Random: return miopen::make_unique<RandomSearch>(options);
+    case SearchStrategyKind::Halving: return miopen::make_unique<HalvingSearch>(options);
+    case SearchStrategyKind::Evolution: return miopen::make_unique<EvolutionSearch>(options);
+    }
+    MIOPEN_THROW(miopenStatusBadParm, "Unknown search strategy");
+}
+
+} // namespace solver
+} // namespace miopen
@@ -25,13 +25,28 @@
  *******************************************************************************/
 
 #include <miopen/solver.hpp>
+#include <miopen/env.hpp>
 #include <miopen/stringutils.hpp>
 #include <boost/range/adaptor/transformed.hpp>
+#include <algorithm>
 #include <ostream>
+#include <thread>
 
 namespace miopen {
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_SOLVER_PARALLEL_LEVEL)
+
 namespace solver {
 
+CompilePool& GetSolverPool()
+{
+    // Evaluation of solvers is mostly reading of the dbs, so more threads do not help much.
+    static const auto level = Value(MIOPEN_SOLVER_PARALLEL_LEVEL{});
+    static CompilePool instance(
+        level != 0 ? level : std::min(std::max(std::thread::hardware_concurrency(), 1u), 16u));
+    return instance;
+}
+
 std::ostream& operator<<(std::ostream& os, const KernelInfo& k)
 {
     os << k.kernel_file << ", " << k.kernel_name << " g_wk={ ";
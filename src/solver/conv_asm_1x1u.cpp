@@ -27,6 +27,8 @@
 #include <sstream>
 #include <limits>
 #include <cassert>
+#include <algorithm>
+#include <cmath>
 
 #include <miopen/gcn_asm_utils.hpp>
 #include <miopen/env.hpp>
@@ -34,6 +36,7 @@
 #include <miopen/handle.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/generic_search.hpp>
+#include <miopen/kernel_build_params.hpp>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GCN_ASM_DIRECT_1X1U_PERF_VALS)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GCN_ASM_DIRECT_1X1U_SEARCH_OPTIMIZED)
@@ -248,6 +251,21 @@ bool PerformanceConfigConvAsm1x1U::IsValidValue() const
         && IsTwoPower<1,8>(waves_k_in_group); // clang-format on
 }
 
+static int GetVgprs(const PerformanceConfigConvAsm1x1U& c, const ConvolutionContext& config)
+{
+    const auto elements_in_dword = 4 / GetTypeSize(config.in_data_type);
+    const auto in_gprs =
+        (c.GetChunksPerWave() * c.GetNMult() * c.GetCMult() + elements_in_dword - 1) /
+        elements_in_dword;
+    const auto acc_gprs = c.GetChunksPerWave() * c.GetNMult() * c.GetKMult();
+    const auto img_hw   = config.out_height * config.out_width;
+    // TODO last vgpr only for old card.
+    // ADD if(option.machine_version_major == 9)
+    // vgprs  = 4 + 2 * in_gprs + acc_gprs + (img_hw % elements_in_dword != 0 ? 1: 0);
+    // else
+    return 4 + 2 * in_gprs + acc_gprs + (img_hw % elements_in_dword != 0 ? 1 : 0) + 1;
+}
+
 bool PerformanceConfigConvAsm1x1U::IsValid(const ConvolutionContext& config) const
 {
     const auto elements_in_dword = 4 / GetTypeSize(config.in_data_type);
@@ -268,15 +286,8 @@ bool PerformanceConfigConvAsm1x1U::IsValid(const ConvolutionContext& config) con
         return false;
     if(chunks_per_wave % elements_in_dword != 0)
         return false;
-    const auto in_gprs =
-        (chunks_per_wave * n_mult * c_mult + elements_in_dword - 1) / elements_in_dword;
-    const auto acc_gprs = chunks_per_wave * n_mult * k_mult;
-    const auto img_hw   = config.out_height * config.out_width;
-    // TODO last vgpr only for old card.
-    // ADD if(option.machine_version_major == 9)
-    // vgprs  = 4 + 2 * in_gprs + acc_gprs + (img_hw % elements_in_dword != 0 ? 1: 0);
-    // else
-    const auto vgprs = 4 + 2 * in_gprs + acc_gprs + (img_hw % elements_in_dword != 0 ? 1 : 0) + 1;
+    const auto img_hw = config.out_height * config.out_width;
+    const auto vgprs  = GetVgprs(*this, config);
     if(!(vgprs < 256))
         return false;
     const auto max_waves_per_CU = (256 / vgprs) * 4;
@@ -469,7 +480,7 @@ ConvSolution ConvAsm1x1U::GetSolution(const ConvolutionContext& params,
 {
     ConvSolution result;
 
-    std::ostringstream options;
+    KernelBuildParameters options;
 
     result.workspce_sz = 0;
 
@@ -487,23 +498,24 @@ ConvSolution ConvAsm1x1U::GetSolution(const ConvolutionContext& params,
 
         int n_grp0_size0 = 256;
 
-        const auto subsample_kernel_compilation_options =
-            std::string(" -DDATA_TYPE=") +
-            (params.in_data_type == miopenHalf ? "ushort" : "float") +
-            std::string(" -DMLO_GRP0_SZ0=") + std::to_string(n_grp0_size0) +
-            std::string(" -DMLO_GRP0_SZ1=1 ") + std::string(" -DMLO_GRP0_SZ2=1 ") +
-            std::string(" -DMLO_FILTER0_STRIDE0=") + std::to_string(params.kernel_stride_w) +
-            std::string(" -DMLO_FILTER0_STRIDE1=") + std::to_string(params.kernel_stride_h) +
-            std::string(" -DMLO_WRITE_UNIT=") + std::to_string(write_unit) +
-            std::string(" -DMLO_OUT_CHANNEL_STRIDE=") + std::to_string(params.out_channel_stride) +
-            std::string(" -DMLO_OUT_STRIDE=") + std::to_string(params.out_stride) +
-            std::string(" -DMLO_IN_BATCH_STRIDE=") + std::to_string(in_batch_stride) +
-            std::string(" -DMLO_IN0_BATCH_STRIDE=") +
-            std::to_string(params.direction.IsForward() ? params.in_batch_stride
-                                                        : params.out_batch_stride) +
-            std::string(" -DMLO_IN0_CHANNEL_STRIDE=") + std::to_string(params.in_channel_stride) +
-            std::string(" -DMLO_IN0_STRIDE=") + std::to_string(params.in_stride) +
-            params.general_compile_options;
+        KernelBuildParameters subsample_options{
+            {"DATA_TYPE", params.in_data_type == miopenHalf ? "ushort" : "float"},
+            {"MLO_GRP0_SZ0", n_grp0_size0},
+            {"MLO_GRP0_SZ1", 1},
+            {"MLO_GRP0_SZ2", 1},
+            {"MLO_FILTER0_STRIDE0", params.kernel_stride_w},
+            {"MLO_FILTER0_STRIDE1", params.kernel_stride_h},
+            {"MLO_WRITE_UNIT", write_unit},
+            {"MLO_OUT_CHANNEL_STRIDE", params.out_channel_stride},
+            {"MLO_OUT_STRIDE", params.out_stride},
+            {"MLO_IN_BATCH_STRIDE", in_batch_stride},
+            {"MLO_IN0_BATCH_STRIDE",
+             params.direction.IsForward() ? params.in_batch_stride : params.out_batch_stride},
+            {"MLO_IN0_CHANNEL_STRIDE", params.in_channel_stride},
+            {"MLO_IN0_STRIDE", params.in_stride},
+        };
+        subsample_options << params.general_compile_options;
+        subsample_options.Canonicalize();
 
         kernel.l_wk.push_back(n_grp0_size0);
         kernel.l_wk.push_back(1);
@@ -524,32 +536,32 @@ ConvSolution ConvAsm1x1U::GetSolution(const ConvolutionContext& params,
         else
             kernel.kernel_name = "UpSample";
 
-        kernel.comp_options = subsample_kernel_compilation_options;
+        kernel.comp_options = subsample_options.GenerateFor(kbp::OpenCL{});
 
         result.workspce_sz = in_batch_stride * params.batch_sz * data_len;
     }
 
-    GenerateClangDefsym(options, "stride_h", 1);
-    GenerateClangDefsym(options, "stride_w", 1);
-    GenerateClangDefsym(options, "img_h", AsmImgHeight(params)); // H
-    GenerateClangDefsym(options, "img_w", AsmImgWidth(params));  // W
+    options.Define("stride_h", 1);
+    options.Define("stride_w", 1);
+    options.Define("img_h", AsmImgHeight(params)); // H
+    options.Define("img_w", AsmImgWidth(params));  // W
 
     // Note that params.n_outputs and params.n_inputs are swapped for backward convolutions.
-    GenerateClangDefsym(options, "batch_size", params.batch_sz);       // N
-    GenerateClangDefsym(options, "input_channels", params.n_inputs);   // C
-    GenerateClangDefsym(options, "output_channels", params.n_outputs); // K
-    GenerateClangDefsym(options, "wei_h", params.kernel_size_h);       // R
-    GenerateClangDefsym(options, "wei_w", params.kernel_size_w);       // S
-    GenerateClangDefsym(options, "pad_h", params.pad_h);
-    GenerateClangDefsym(options, "pad_w", params.pad_w);
-    GenerateClangDefsym(options, "weights_layout", params.direction.IsForward() ? 0 : 1);
-
-    GenerateClangDefsym(options, "vec_c_in", 1);
-    GenerateClangDefsym(options, "vec_k_out", 1);
-    GenerateClangDefsym(options, "vec_c_filter", 1);
-
-    GenerateClangDefsym(options, "acc_type", 1);
-    GenerateClangDefsym(options, "buf_type", (data_len == 2 ? 2 : 1));
+    options.Define("batch_size", params.batch_sz);       // N
+    options.Define("input_channels", params.n_inputs);   // C
+    options.Define("output_channels", params.n_outputs); // K
+    options.Define("wei_h", params.kernel_size_h);       // R
+    options.Define("wei_w", params.kernel_size_w);       // S
+    options.Define("pad_h", params.pad_h);
+    options.Define("pad_w", params.pad_w);
+    options.Define("weights_layout", params.direction.IsForward() ? 0 : 1);
+
+    options.Define("vec_c_in", 1);
+    options.Define("vec_k_out", 1);
+    options.Define("vec_c_filter", 1);
+
+    options.Define("acc_type", 1);
+    options.Define("buf_type", data_len == 2 ? 2 : 1);
     enum class MemLayout : int
     {
         NCHW = 0,
@@ -622,26 +634,25 @@ ConvSolution ConvAsm1x1U::GetSolution(const ConvolutionContext& params,
                    1,
                    data_len);
 
-    GenerateClangDefsym(options, "input_n_stride", ibuf.byte_stride.nk);
-    GenerateClangDefsym(options, "input_c_stride", ibuf.byte_stride.c);
-    GenerateClangDefsym(options, "input_h_stride", ibuf.byte_stride.h);
-    GenerateClangDefsym(options, "input_w_stride", ibuf.byte_stride.w);
+    options.Define("input_n_stride", ibuf.byte_stride.nk);
+    options.Define("input_c_stride", ibuf.byte_stride.c);
+    options.Define("input_h_stride", ibuf.byte_stride.h);
+    options.Define("input_w_stride", ibuf.byte_stride.w);
 
-    GenerateClangDefsym(options, "output_n_stride", obuf.byte_stride.nk);
-    GenerateClangDefsym(options, "output_k_stride", obuf.byte_stride.c);
-    GenerateClangDefsym(options, "output_h_stride", obuf.byte_stride.h);
-    GenerateClangDefsym(options, "output_w_stride", obuf.byte_stride.w);
+    options.Define("output_n_stride", obuf.byte_stride.nk);
+    options.Define("output_k_stride", obuf.byte_stride.c);
+    options.Define("output_h_stride", obuf.byte_stride.h);
+    options.Define("output_w_stride", obuf.byte_stride.w);
 
-    GenerateClangDefsym(options, "filter_k_stride", fbuf.byte_stride.nk);
-    GenerateClangDefsym(options, "filter_c_stride", fbuf.byte_stride.c);
-    GenerateClangDefsym(options, "filter_h_stride", fbuf.byte_stride.h);
-    GenerateClangDefsym(options, "filter_w_stride", fbuf.byte_stride.w);
-    GenerateClangDefsym(options, "input_buffer_size", ibuf.total_byte_size);
-    GenerateClangDefsym(options, "filter_buffer_size", fbuf.total_byte_size);
-    GenerateClangDefsym(options, "output_buffer_size", obuf.total_byte_size);
+    options.Define("filter_k_stride", fbuf.byte_stride.nk);
+    options.Define("filter_c_stride", fbuf.byte_stride.c);
+    options.Define("filter_h_stride", fbuf.byte_stride.h);
+    options.Define("filter_w_stride", fbuf.byte_stride.w);
+    options.Define("input_buffer_size", ibuf.total_byte_size);
+    options.Define("filter_buffer_size", fbuf.total_byte_size);
+    options.Define("output_buffer_size", obuf.total_byte_size);
 
-    GenerateClangDefsym(
-        options, "ROCM_METADATA_VERSION", (params.rmv == rocm_meta_version::V3) ? 3 : 4);
+    options.Define("ROCM_METADATA_VERSION", (params.rmv == rocm_meta_version::V3) ? 3 : 4);
 
     const PerformanceConfigConvAsm1x1U* pcfg = &config;
     PerformanceConfigConvAsm1x1U fromEnv;
@@ -669,17 +680,19 @@ ConvSolution ConvAsm1x1U::GetSolution(const ConvolutionContext& params,
         }
     }
 
-    GenerateClangDefsym(options, "read_size", pcfg->GetReadSize());
-    GenerateClangDefsym(options, "k_mult", pcfg->GetKMult());
-    GenerateClangDefsym(options, "chunks_per_wave", pcfg->GetChunksPerWave());
-    GenerateClangDefsym(options, "chunk_size", pcfg->GetChunkSize());
-    GenerateClangDefsym(options, "n_mult", pcfg->GetNMult());
-    GenerateClangDefsym(options, "c_mult", pcfg->GetCMult());
-    GenerateClangDefsym(options, "waves_c_in_group", pcfg->GetWavesCInGroup());
-    GenerateClangDefsym(options, "waves_k_in_group", pcfg->GetWavesKInGroup());
+    options.Define("read_size", pcfg->GetReadSize());
+    options.Define("k_mult", pcfg->GetKMult());
+    options.Define("chunks_per_wave", pcfg->GetChunksPerWave());
+    options.Define("chunk_size", pcfg->GetChunkSize());
+    options.Define("n_mult", pcfg->GetNMult());
+    options.Define("c_mult", pcfg->GetCMult());
+    options.Define("waves_c_in_group", pcfg->GetWavesCInGroup());
+    options.Define("waves_k_in_group", pcfg->GetWavesKInGroup());
+
+    options.Canonicalize();
 
     KernelInfo kinfo;
-    kinfo.comp_options = options.str();
+    kinfo.comp_options = options.GenerateFor(kbp::GcnAsm{});
 
     const int waves_in_group = pcfg->GetWavesCInGroup() * pcfg->GetWavesKInGroup();
     kinfo.l_wk.clear(); // workgroupsize
@@ -712,6 +725,37 @@ ConvSolution ConvAsm1x1U::GetSolution(const ConvolutionContext& params,
     return result;
 }
 
+float ConvAsm1x1U::EstimateCost(const ConvolutionContext& params,
+                                 const PerformanceConfigConvAsm1x1U& config,
+                                 const std::size_t compute_units) const
+{
+    // Each lane of a wave computes k_mult outputs of chunks_per_wave * n_mult pixels,
+    // accumulating its share of the input channels, see GetSolution() for the grid.
+    const int waves_in_group = config.GetWavesCInGroup() * config.GetWavesKInGroup();
+    const auto hw_per_wave   = config.GetChunksPerWave() * config.GetChunkSize();
+    const float groups =
+        static_cast<float>(
+            divide_round_plus_inf(AsmImgHeight(params) * AsmImgWidth(params), hw_per_wave)) *
+        divide_round_plus_inf(params.n_outputs, config.GetKMult() * config.GetWavesKInGroup()) *
+        divide_round_plus_inf(params.batch_sz, config.GetNMult() * config.GetNPerGpr());
+    const float waves = groups * waves_in_group;
+
+    // Up to 4 waves per SIMD are worth having resident, fewer if they need many VGPRs.
+    const int waves_per_cu = std::min(16, std::min(10, 256 / GetVgprs(config, params)) * 4);
+    const float rounds =
+        std::ceil(waves / (waves_per_cu * std::max<std::size_t>(compute_units, 1)));
+
+    const float c_per_wave = divide_round_plus_inf(params.n_inputs, config.GetWavesCInGroup());
+    const float pixels     = static_cast<float>(config.GetChunksPerWave()) * config.GetNMult();
+    const float macs       = pixels * config.GetKMult() * c_per_wave;
+    // Inputs are read read_size dwords at once, weights are cheaper scalar loads.
+    const float loads = c_per_wave * (pixels / config.GetReadSize() + 0.1f * config.GetKMult());
+    // Splitting the channels among waves adds a reduction of the accumulators through LDS.
+    const float reduction =
+        config.GetWavesCInGroup() > 1 ? 8.0f * pixels * config.GetKMult() : 0.0f;
+    return rounds * (macs + 2.0f * loads + reduction);
+}
+
 int ConvAsm1x1U::RunAndMeasureSolution(miopen::Handle& profile_h,
                                        Data_t bot_ocl_buf,
                                        Data_t top_ocl_buf,
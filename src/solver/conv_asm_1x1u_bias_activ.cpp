@@ -34,6 +34,7 @@
 #include <miopen/handle.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/generic_search.hpp>
+#include <miopen/kernel_build_params.hpp>
 
 #include "half.hpp"
 
@@ -89,11 +90,10 @@ int ConvBiasActivAsm1x1U::RunAndMeasureSolution(miopen::Handle& profile_h,
     KernelInfo k_info;
     k_info = solution.construction_params[0];
 
-    std::ostringstream cba_options;
-    GenerateClangDefsym(cba_options, "activ_mode", 3);
-    GenerateClangDefsym(cba_options, "bias_mode", 1);
-    GenerateClangDefsym(cba_options, "fusion_mode", 1);
-    GenerateClangDefsym(cba_options, "enable_activ", 1);
+    KernelBuildParameters cba_options{
+        {"activ_mode", 3}, {"bias_mode", 1}, {"fusion_mode", 1}, {"enable_activ", 1},
+    };
+    cba_options.Canonicalize();
 
 #ifdef NDEBUG
     try
@@ -108,7 +108,8 @@ int ConvBiasActivAsm1x1U::RunAndMeasureSolution(miopen::Handle& profile_h,
                                           k_info.kernel_name,
                                           k_info.l_wk,
                                           k_info.g_wk,
-                                          k_info.comp_options + cba_options.str());
+                                          k_info.comp_options + " " +
+                                              cba_options.GenerateFor(kbp::GcnAsm{}));
 
         if(params.out_data_type == miopenHalf)
         {
@@ -27,6 +27,7 @@
 #include <unordered_map>
 #include "miopen/solver.hpp"
 #include "miopen/gcn_asm_utils.hpp"
+#include "miopen/kernel_build_params.hpp"
 
 namespace miopen {
 namespace solver {
@@ -89,18 +90,19 @@ bool ConvAsm5x10u2v2b1::IsApplicable(const ConvolutionContext& params) const
 ConvSolution ConvAsm5x10u2v2b1::GetSolution(const ConvolutionContext& params) const
 {
     ConvSolution result;
-    std::ostringstream options;
-    GenerateClangDefsym(options, "inp_h", params.out_height);
-    GenerateClangDefsym(options, "inp_w", params.out_width);
-    GenerateClangDefsym(options, "wei_c", params.n_outputs);
-    GenerateClangDefsym(options, "wei_k", params.n_inputs);
-    GenerateClangDefsym(
-        options,
+    KernelBuildParameters options;
+    options.Define("inp_h", params.out_height);
+    options.Define("inp_w", params.out_width);
+    options.Define("wei_c", params.n_outputs);
+    options.Define("wei_k", params.n_inputs);
+    options.Define(
         "ROCM_METADATA_VERSION",
         (params.rmv == rocm_meta_version::V1) ? 1 : (params.rmv == rocm_meta_version::V3) ? 3 : 4);
 
+    options.Canonicalize();
+
     KernelInfo constr_params;
-    constr_params.comp_options = options.str();
+    constr_params.comp_options = options.GenerateFor(kbp::GcnAsm{});
 
     constr_params.l_wk.push_back(64);
     constr_params.l_wk.push_back(8);
@@ -26,6 +26,7 @@
 
 #include "miopen/solver.hpp"
 #include "miopen/gcn_asm_utils.hpp"
+#include "miopen/kernel_build_params.hpp"
 #include "miopen/handle.hpp"
 
 namespace miopen {
@@ -102,24 +103,25 @@ ConvSolution ConvAsm5x10u2v2f1::GetSolution(const ConvolutionContext& params) co
         (params.in_height + params.pad_h * 2 + params.kernel_stride_h - params.kernel_size_h) /
         params.kernel_stride_h; // (inp_h + 2*pad_h + inp_u - wei_h) / inp_u
 
-    std::ostringstream options;
-    GenerateClangDefsym(options, "inp_h", params.in_height);
-    GenerateClangDefsym(options, "inp_w", params.in_width);
-    GenerateClangDefsym(options, "wei_c", params.n_inputs);
-    GenerateClangDefsym(options, "wei_k", params.n_outputs);
-    GenerateClangDefsym(options, "wei_layout", 0); // 0: KCHW, 1: CKHW
-    GenerateClangDefsym(options, "pad_w", params.pad_w);
-    GenerateClangDefsym(options, "pad_h", params.pad_h);
-    GenerateClangDefsym(options,
-                        "ROCM_METADATA_VERSION",
-                        (params.rmv == rocm_meta_version::V1)
-                            ? 1
-                            : (params.rmv == rocm_meta_version::V2)
-                                  ? 2
-                                  : (params.rmv == rocm_meta_version::V3) ? 3 : 4);
+    KernelBuildParameters options;
+    options.Define("inp_h", params.in_height);
+    options.Define("inp_w", params.in_width);
+    options.Define("wei_c", params.n_inputs);
+    options.Define("wei_k", params.n_outputs);
+    options.Define("wei_layout", 0); // 0: KCHW, 1: CKHW
+    options.Define("pad_w", params.pad_w);
+    options.Define("pad_h", params.pad_h);
+    options.Define("ROCM_METADATA_VERSION",
+                   (params.rmv == rocm_meta_version::V1)
+                       ? 1
+                       : (params.rmv == rocm_meta_version::V2)
+                             ? 2
+                             : (params.rmv == rocm_meta_version::V3) ? 3 : 4);
+
+    options.Canonicalize();
 
     KernelInfo construction_params;
-    construction_params.comp_options = options.str();
+    construction_params.comp_options = options.GenerateFor(kbp::GcnAsm{});
 
     construction_params.l_wk.push_back(64);
     construction_params.l_wk.push_back(8);
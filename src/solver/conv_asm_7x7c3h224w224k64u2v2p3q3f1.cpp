@@ -28,6 +28,7 @@
 #include <sstream>
 #include "miopen/solver.hpp"
 #include "miopen/gcn_asm_utils.hpp"
+#include "miopen/kernel_build_params.hpp"
 
 namespace miopen {
 namespace solver {
@@ -85,11 +86,12 @@ ConvSolution ConvAsm7x7c3h224w224k64u2v2p3q3f1::GetSolution(const ConvolutionCon
         (params.in_height + params.pad_h * 2 + params.kernel_stride_h - params.kernel_size_h) /
         params.kernel_stride_h; // (inp_h + 2*pad_h + inp_u - wei_h) / inp_u
 
-    std::ostringstream options;
-    GenerateClangDefsym(
-        options, "ROCM_METADATA_VERSION", (params.rmv == rocm_meta_version::V3) ? 3 : 4);
+    KernelBuildParameters options;
+    options.Define("ROCM_METADATA_VERSION", (params.rmv == rocm_meta_version::V3) ? 3 : 4);
+    options.Canonicalize();
+
     KernelInfo constr_params;
-    constr_params.comp_options = options.str();
+    constr_params.comp_options = options.GenerateFor(kbp::GcnAsm{});
 
     constr_params.l_wk.push_back(64);
     constr_params.l_wk.push_back(8);
@@ -34,6 +34,7 @@
 #include <miopen/handle.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/generic_search.hpp>
+#include <miopen/kernel_build_params.hpp>
 
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GCN_ASM_DIRECT_1X1WRW_PERF_VALS)
 MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_GCN_ASM_DIRECT_1X1WRW_SEARCH_OPTIMIZED)
@@ -517,7 +518,7 @@ ConvSolution ConvAsmBwdWrW1x1::GetSolution(const ConvolutionContext& params,
 {
 
     ConvSolution result;
-    std::ostringstream options;
+    KernelBuildParameters options;
 
     assert(params.pad_h == 0 && params.pad_w == 0);
     result.workspce_sz = 0;
@@ -531,19 +532,22 @@ ConvSolution ConvAsmBwdWrW1x1::GetSolution(const ConvolutionContext& params,
                                                               : (params.in_width % 2 == 0) ? 2 : 1;
         int n_grp0_size0 = 256;
 
-        const auto subsample_kernel_compilation_options =
-            std::string(" -DMLO_GRP0_SZ0=") + std::to_string(n_grp0_size0) +
-            std::string(" -DMLO_GRP0_SZ1=1 ") + std::string(" -DMLO_GRP0_SZ2=1 ") +
-            std::string(" -DMLO_FILTER0_STRIDE0=") + std::to_string(params.kernel_stride_w) +
-            std::string(" -DMLO_FILTER0_STRIDE1=") + std::to_string(params.kernel_stride_h) +
-            std::string(" -DMLO_WRITE_UNIT=") + std::to_string(write_unit) +
-            std::string(" -DMLO_OUT_CHANNEL_STRIDE=") + std::to_string(params.in_channel_stride) +
-            std::string(" -DMLO_OUT_STRIDE=") + std::to_string(params.in_stride) +
-            std::string(" -DMLO_IN_BATCH_STRIDE=") + std::to_string(in_batch_stride) +
-            std::string(" -DMLO_IN0_BATCH_STRIDE=") + std::to_string(params.out_batch_stride) +
-            std::string(" -DMLO_IN0_CHANNEL_STRIDE=") + std::to_string(params.out_channel_stride) +
-            std::string(" -DMLO_IN0_STRIDE=") + std::to_string(params.out_stride) +
-            params.general_compile_options;
+        KernelBuildParameters subsample_options{
+            {"MLO_GRP0_SZ0", n_grp0_size0},
+            {"MLO_GRP0_SZ1", 1},
+            {"MLO_GRP0_SZ2", 1},
+            {"MLO_FILTER0_STRIDE0", params.kernel_stride_w},
+            {"MLO_FILTER0_STRIDE1", params.kernel_stride_h},
+            {"MLO_WRITE_UNIT", write_unit},
+            {"MLO_OUT_CHANNEL_STRIDE", params.in_channel_stride},
+            {"MLO_OUT_STRIDE", params.in_stride},
+            {"MLO_IN_BATCH_STRIDE", in_batch_stride},
+            {"MLO_IN0_BATCH_STRIDE", params.out_batch_stride},
+            {"MLO_IN0_CHANNEL_STRIDE", params.out_channel_stride},
+            {"MLO_IN0_STRIDE", params.out_stride},
+        };
+        subsample_options << params.general_compile_options;
+        subsample_options.Canonicalize();
 
         KernelInfo kernel;
 
@@ -563,36 +567,35 @@ ConvSolution ConvAsmBwdWrW1x1::GetSolution(const ConvolutionContext& params,
 
         kernel.kernel_name = "SubSample";
 
-        kernel.comp_options = subsample_kernel_compilation_options;
+        kernel.comp_options = subsample_options.GenerateFor(kbp::OpenCL{});
 
         result.construction_params.push_back(kernel);
 
         result.workspce_sz = in_batch_stride * params.batch_sz * data_len;
     }
-    GenerateClangDefsym(options, "stride_h", 1);
-    GenerateClangDefsym(options, "stride_w", 1);
-    GenerateClangDefsym(options, "img_h", AsmImgHeight(params)); // H
-    GenerateClangDefsym(options, "img_w", AsmImgWidth(params));  // W
-    GenerateClangDefsym(options, "out_h", AsmImgHeight(params)); // output H
-    GenerateClangDefsym(options, "out_w", AsmImgWidth(params));  // output W
-
-    GenerateClangDefsym(options, "batch_size", params.batch_sz); // N
+    options.Define("stride_h", 1);
+    options.Define("stride_w", 1);
+    options.Define("img_h", AsmImgHeight(params)); // H
+    options.Define("img_w", AsmImgWidth(params));  // W
+    options.Define("out_h", AsmImgHeight(params)); // output H
+    options.Define("out_w", AsmImgWidth(params));  // output W
+
+    options.Define("batch_size", params.batch_sz); // N
     // Note that params.n_outputs and params.n_inputs are swapped for backward convolutions.
-    GenerateClangDefsym(options, "input_channels", params.n_outputs); // C
-    GenerateClangDefsym(options, "output_channels", params.n_inputs); // K
-    GenerateClangDefsym(options, "wei_h", params.kernel_size_h);      // R
-    GenerateClangDefsym(options, "wei_w", params.kernel_size_w);      // S
-    GenerateClangDefsym(options, "pad_h", params.pad_h);
-    GenerateClangDefsym(options, "pad_w", params.pad_w);
-    GenerateClangDefsym(options, "weights_layout", 0);
-    GenerateClangDefsym(options, "reverse_weights", 0);
-    GenerateClangDefsym(
-        options, "ROCM_METADATA_VERSION", (params.rmv == rocm_meta_version::V3) ? 3 : 4);
+    options.Define("input_channels", params.n_outputs); // C
+    options.Define("output_channels", params.n_inputs); // K
+    options.Define("wei_h", params.kernel_size_h);      // R
+    options.Define("wei_w", params.kernel_size_w);      // S
+    options.Define("pad_h", params.pad_h);
+    options.Define("pad_w", params.pad_w);
+    options.Define("weights_layout", 0);
+    options.Define("reverse_weights", 0);
+    options.Define("ROCM_METADATA_VERSION", (params.rmv == rocm_meta_version::V3) ? 3 : 4);
     // Perf tune:
-    GenerateClangDefsym(options, "do_not_use_default_perf_params", 1);
+    options.Define("do_not_use_default_perf_params", 1);
 
-    GenerateClangDefsym(options, "acc_type", 1);
-    GenerateClangDefsym(options, "buf_type", (data_len == 2 ? 2 : 1));
+    options.Define("acc_type", 1);
+    options.Define("buf_type", data_len == 2 ? 2 : 1);
 
     enum class MemLayout : int
     {
@@ -659,23 +662,23 @@ ConvSolution ConvAsmBwdWrW1x1::GetSolution(const ConvolutionContext& params,
                    1,
                    data_len);
     buff_info fbuf(MemLayout::NCHW, params.n_inputs, params.n_outputs, 1, 1, 1, data_len);
-    GenerateClangDefsym(options, "input_n_stride", ibuf.byte_stride.nk);
-    GenerateClangDefsym(options, "input_c_stride", ibuf.byte_stride.c);
-    GenerateClangDefsym(options, "input_h_stride", ibuf.byte_stride.h);
-    GenerateClangDefsym(options, "input_w_stride", ibuf.byte_stride.w);
-
-    GenerateClangDefsym(options, "output_n_stride", obuf.byte_stride.nk);
-    GenerateClangDefsym(options, "output_k_stride", obuf.byte_stride.c);
-    GenerateClangDefsym(options, "output_h_stride", obuf.byte_stride.h);
-    GenerateClangDefsym(options, "output_w_stride", obuf.byte_stride.w);
-
-    GenerateClangDefsym(options, "filter_k_stride", fbuf.byte_stride.nk);
-    GenerateClangDefsym(options, "filter_c_stride", fbuf.byte_stride.c);
-    GenerateClangDefsym(options, "filter_h_stride", fbuf.byte_stride.h);
-    GenerateClangDefsym(options, "filter_w_stride", fbuf.byte_stride.w);
-    GenerateClangDefsym(options, "input_buffer_size", ibuf.total_byte_size);
-    GenerateClangDefsym(options, "filter_buffer_size", fbuf.total_byte_size);
-    GenerateClangDefsym(options, "output_buffer_size", obuf.total_byte_size);
+    options.Define("input_n_stride", ibuf.byte_stride.nk);
+    options.Define("input_c_stride", ibuf.byte_stride.c);
+    options.Define("input_h_stride", ibuf.byte_stride.h);
+    options.Define("input_w_stride", ibuf.byte_stride.w);
+
+    options.Define("output_n_stride", obuf.byte_stride.nk);
+    options.Define("output_k_stride", obuf.byte_stride.c);
+    options.Define("output_h_stride", obuf.byte_stride.h);
+    options.Define("output_w_stride", obuf.byte_stride.w);
+
+    options.Define("filter_k_stride", fbuf.byte_stride.nk);
+    options.Define("filter_c_stride", fbuf.byte_stride.c);
+    options.Define("filter_h_stride", fbuf.byte_stride.h);
+    options.Define("filter_w_stride", fbuf.byte_stride.w);
+    options.Define("input_buffer_size", ibuf.total_byte_size);
+    options.Define("filter_buffer_size", fbuf.total_byte_size);
+    options.Define("output_buffer_size", obuf.total_byte_size);
 
     const PerformanceConfigConvAsmBwdWrW1x1* pcfg = &config;
     PerformanceConfigConvAsmBwdWrW1x1 fromEnv;
@@ -704,21 +707,23 @@ ConvSolution ConvAsmBwdWrW1x1::GetSolution(const ConvolutionContext& params,
         }
     }
 
-    GenerateClangDefsym(options, "short_store", pcfg->GetShortStore());
-    GenerateClangDefsym(options, "chunk_size", pcfg->GetChunkSize());
-    GenerateClangDefsym(options, "c_per_gpr", pcfg->GetCPerGpr());
-    GenerateClangDefsym(options, "c_mult", pcfg->GetCMult());
-    GenerateClangDefsym(options, "k_per_gpr", pcfg->GetKPerGpr());
-    GenerateClangDefsym(options, "k_mult", pcfg->GetKMult());
-    GenerateClangDefsym(options, "n_per_gpr", pcfg->GetNPerGpr());
-    GenerateClangDefsym(options, "n_part_cnt", pcfg->GetNPartCnt());
-    GenerateClangDefsym(options, "hw_per_gpr", pcfg->GetHWPerGpr());
-    GenerateClangDefsym(options, "read_size", pcfg->GetReadSize());
-    GenerateClangDefsym(options, "data_prefetch", pcfg->GetDataPrefetch());
+    options.Define("short_store", pcfg->GetShortStore());
+    options.Define("chunk_size", pcfg->GetChunkSize());
+    options.Define("c_per_gpr", pcfg->GetCPerGpr());
+    options.Define("c_mult", pcfg->GetCMult());
+    options.Define("k_per_gpr", pcfg->GetKPerGpr());
+    options.Define("k_mult", pcfg->GetKMult());
+    options.Define("n_per_gpr", pcfg->GetNPerGpr());
+    options.Define("n_part_cnt", pcfg->GetNPartCnt());
+    options.Define("hw_per_gpr", pcfg->GetHWPerGpr());
+    options.Define("read_size", pcfg->GetReadSize());
+    options.Define("data_prefetch", pcfg->GetDataPrefetch());
+
+    options.Canonicalize();
 
     KernelInfo kernel;
 
-    kernel.comp_options = options.str();
+    kernel.comp_options = options.GenerateFor(kbp::GcnAsm{});
 
     kernel.l_wk.clear(); // workgroupsize
     kernel.l_wk.push_back(solver::wave_size * pcfg->GetNPartCnt());
@@ -34,6 +34,7 @@
 #include <miopen/handle.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/generic_search.hpp>
+#include <miopen/kernel_build_params.hpp>
 
 #define MIOPEN_GCN_ASM_DIRECT_3X3WRW_SEARCH_LWC_FIXED 0
 
@@ -411,24 +412,23 @@ ConvSolution ConvAsmBwdWrW3x3::GetSolution(const ConvolutionContext& params,
                                            const bool disableConfigOverrideFromEnv) const
 {
     ConvSolution result;
-    std::ostringstream options;
-    GenerateClangDefsym(options, "elements_in_dword", (params.IsFp16()) ? 2 : 1);
-    GenerateClangDefsym(options, "batch_size", params.batch_sz); // N
-    GenerateClangDefsym(options, "img_h", params.out_height);    // H
-    GenerateClangDefsym(options, "img_w", params.out_width);     // W
+    KernelBuildParameters options;
+    options.Define("elements_in_dword", (params.IsFp16()) ? 2 : 1);
+    options.Define("batch_size", params.batch_sz); // N
+    options.Define("img_h", params.out_height);    // H
+    options.Define("img_w", params.out_width);     // W
     // Note that params.n_outputs and params.n_inputs are swapped for backward convolutions.
-    GenerateClangDefsym(options, "input_channels", params.n_outputs); // C
-    GenerateClangDefsym(options, "output_channels", params.n_inputs); // K
-    GenerateClangDefsym(options, "wei_h", params.kernel_size_h);      // R
-    GenerateClangDefsym(options, "wei_w", params.kernel_size_w);      // S
-    GenerateClangDefsym(options, "pad_h", params.pad_h);
-    GenerateClangDefsym(options, "pad_w", params.pad_w);
-    GenerateClangDefsym(options, "stride_h", params.kernel_stride_h);
-    GenerateClangDefsym(options, "stride_w", params.kernel_stride_w);
-    GenerateClangDefsym(options, "weights_layout", 0);
-    GenerateClangDefsym(options, "reverse_weights", 0);
-    GenerateClangDefsym(
-        options, "ROCM_METADATA_VERSION", (params.rmv == rocm_meta_version::V3) ? 3 : 4);
+    options.Define("input_channels", params.n_outputs); // C
+    options.Define("output_channels", params.n_inputs); // K
+    options.Define("wei_h", params.kernel_size_h);      // R
+    options.Define("wei_w", params.kernel_size_w);      // S
+    options.Define("pad_h", params.pad_h);
+    options.Define("pad_w", params.pad_w);
+    options.Define("stride_h", params.kernel_stride_h);
+    options.Define("stride_w", params.kernel_stride_w);
+    options.Define("weights_layout", 0);
+    options.Define("reverse_weights", 0);
+    options.Define("ROCM_METADATA_VERSION", (params.rmv == rocm_meta_version::V3) ? 3 : 4);
     // Perf tune:
     const PerformanceConfigAsmDirect3x3WrW* pcfg = &config;
     PerformanceConfigAsmDirect3x3WrW fromEnv;
@@ -455,26 +455,28 @@ ConvSolution ConvAsmBwdWrW3x3::GetSolution(const ConvolutionContext& params,
             }
         }
     }
-    GenerateClangDefsym(options, "limit_wave_cnt", pcfg->GetLimitWaveCnt());
-    GenerateClangDefsym(options, "chunk_size", pcfg->GetChunkSize());
-    GenerateClangDefsym(options, "c_per_wave", pcfg->GetCPerWave());
-    GenerateClangDefsym(options, "k_per_wave", pcfg->GetKPerWave());
-    GenerateClangDefsym(options, "n_per_group", pcfg->GetNPerGroup());
-    GenerateClangDefsym(options, "pipe_lines_depth", pcfg->GetPipeLinesDepth());
-    GenerateClangDefsym(options, "reverse_inout", pcfg->GetReverseInout());
+    options.Define("limit_wave_cnt", pcfg->GetLimitWaveCnt());
+    options.Define("chunk_size", pcfg->GetChunkSize());
+    options.Define("c_per_wave", pcfg->GetCPerWave());
+    options.Define("k_per_wave", pcfg->GetKPerWave());
+    options.Define("n_per_group", pcfg->GetNPerGroup());
+    options.Define("pipe_lines_depth", pcfg->GetPipeLinesDepth());
+    options.Define("reverse_inout", pcfg->GetReverseInout());
     // Debugging:
-    GenerateClangDefsym(options, "enable_debug_output", 0);
-    GenerateClangDefsym(options, "group_counts", params.group_counts);
+    options.Define("enable_debug_output", 0);
+    options.Define("group_counts", params.group_counts);
 
     const int k_group_size =
         params.n_inputs / (pcfg->reverse_inout != 0 ? pcfg->GetCPerWave() : pcfg->GetKPerWave()) /
         params.group_counts;
     const bool k_group_size_is_power_of_two = ((k_group_size & (k_group_size - 1)) == 0);
-    GenerateClangDefsym(options, "k_group_size_is_power_of_two", k_group_size_is_power_of_two);
+    options.Define("k_group_size_is_power_of_two", k_group_size_is_power_of_two);
+
+    options.Canonicalize();
 
     KernelInfo kernel;
 
-    kernel.comp_options = options.str();
+    kernel.comp_options = options.GenerateFor(kbp::GcnAsm{});
 
     kernel.l_wk.clear(); // workgroupsize
     kernel.l_wk.push_back(64 * pcfg->GetNPerGroup());
@@ -26,6 +26,7 @@
 
 #include "miopen/solver.hpp"
 #include "miopen/handle.hpp"
+#include "miopen/kernel_build_params.hpp"
 
 namespace miopen {
 namespace solver {
@@ -188,72 +189,70 @@ ConvSolution ConvOclDirectFwd11x11::GetSolution(const ConvolutionContext& params
 #endif
 
     // it's backward - inputs are outputs and vs versa
-    const auto comp_options =
-        std::string(" -DMLO_DIR_FORWARD=") + (is_forward ? "1" : "0") +
-        std::string(" -DMLO_GRP_SZ=") + std::to_string(GRP_SZ) + std::string(" -DMLO_GRP_SZ0=") +
-        std::to_string(result.grp_tile0) + std::string(" -DMLO_GRP_SZ1=") +
-        std::to_string(result.grp_tile1) + std::string(" -DMLO_GRP_SZ2=") +
-        std::to_string(grp_tile2) + std::string(" -DMLO_FILTER_SIZE0=") +
-        std::to_string(params.kernel_size_w) + std::string(" -DMLO_FILTER_SIZE1=") +
-        std::to_string(params.kernel_size_h) + std::string(" -DMLO_FILTER_PAD0=") +
-        std::to_string(params.pad_w) + std::string(" -DMLO_FILTER_PAD1=") +
-        std::to_string(params.pad_h) + std::string(" -DMLO_FILTER_STRIDE0=") +
-        std::to_string(params.kernel_stride_w) + std::string(" -DMLO_FILTER_STRIDE1=") +
-        std::to_string(params.kernel_stride_h) + std::string(" -DSTRIDE_W=") +
-        std::to_string(params.kernel_stride_w) + std::string(" -DSTRIDE_H=") +
-        std::to_string(params.kernel_stride_h) + std::string(" -DMLO_N_OUTPUTS=") +
-        std::to_string(params.n_outputs) + std::string(" -DMLO_N_INPUTS=") +
-        std::to_string(params.n_inputs) + std::string(" -DMLO_BATCH_SZ=") +
-        std::to_string(params.batch_sz) + std::string(" -DMLO_N_BATCH_LOOPS=") +
-        std::to_string(N_BATCH_LOOPS) + std::string(" -DMLO_OUT_BATCH_STRIDE=") +
-        std::to_string(params.out_batch_stride) + std::string(" -DMLO_OUT_CHANNEL_STRIDE=") +
-        std::to_string(params.out_channel_stride) + std::string(" -DMLO_OUT_STRIDE=") +
-        std::to_string(params.out_stride) + std::string(" -DMLO_IN_BATCH_STRIDE=") +
-        std::to_string(params.in_batch_stride) + std::string(" -DMLO_IN_CHANNEL_STRIDE=") +
-        std::to_string(params.in_channel_stride) + std::string(" -DMLO_IN_STRIDE=") +
-        std::to_string(params.in_stride) + std::string(" -DMLO_WEI_BATCH_STRIDE=") +
-        std::to_string(wei_bstride) + std::string(" -DMLO_WEI_CHANNEL_STRIDE=") +
-        std::to_string(wei_cstride) + std::string(" -DMLO_IN_WIDTH=") +
-        std::to_string(params.in_width) + std::string(" -DMLO_IN_HEIGHT=") +
-        std::to_string(params.in_height) + std::string(" -DMLO_OUT_WIDTH=") +
-        std::to_string(params.out_width) + std::string(" -DMLO_OUT_HEIGHT=") +
-        std::to_string(params.out_height) + std::string(" -DMLO_IN_TILE1=") +
-        std::to_string(result.in_tile1) + std::string(" -DMLO_IN_TILE0=") +
-        std::to_string(result.in_tile0) + std::string(" -DMLO_N_LCL_BATCHS=") +
-        std::to_string(result.n_stacks) // # of diff stacks (part of batch).
-        + std::string(" -DMLO_N_LCL_OUT_MAPS=") +
-        std::to_string(result.n_out_pix_tiles) // # output pixel tiles per wk-item (ALU)
-        + std::string(" -DMLO_N_LCL_IN_MAPS=") +
-        std::to_string(result.n_in_data_tiles) // total # of blocks of different inputs in LDS
-        + std::string(" -DMLO_IN_PIX_TILE1=") +
-        std::to_string(in_pix_tile1) // size of ouptput tile per wk-item (ALU)
-        + std::string(" -DMLO_IN_PIX_TILE0=") + std::to_string(in_pix_tile0) //
-        + std::string(" -DMLO_OUT_PIX_TILE1=") +
-        std::to_string(result.out_pix_tile1) // size of ouptput tile per wk-item (ALU)
-        + std::string(" -DMLO_OUT_PIX_TILE0=") + std::to_string(result.out_pix_tile0) //
-        + std::string(" -DMLO_OUT_STACKS=") + std::to_string(n_out_stacks) +
-        std::string(" -DMLO_IN_STACKS=") + std::to_string(n_in_stacks) +
-        std::string(" -DMLO_N_WAVES=") + std::to_string(n_waves) +
-        std::string(" -DMLO_N_FILTER_SPLITS0=") + std::to_string(N_FILTER_SPLITS0) +
-        std::string(" -DMLO_N_FILTER_SPLITS1=") + std::to_string(N_FILTER_SPLITS1) +
-        std::string(" -DMLO_PROCESSING_WIDTH=") + std::to_string(PROCESING_WIDTH) +
-        std::string(" -DMLO_OUT_EXTENT1=") + std::to_string(OUT_EXTENT1) +
-        std::string(" -DMLO_LAST_OUT_EXTENT1=") + std::to_string(last_out_extent1) +
-        std::string(" -DMLO_N_LCL_BATCHS_PASS2=") + std::to_string(n_batches_pass2) +
-        std::string(" -DMLO_TILE_REPLICATE0=") + std::to_string(data_multiplier0) +
-        std::string(" -DMLO_TILE_REPLICATE1=") + std::to_string(data_multiplier1) +
-        std::string(" -DMLO_LCL_BWD_MEM_SZ=") + std::to_string(lcl_bwd_sz) +
-        std::string(" -DMLO_N_IN_BWD_HORIZ_READS=") + std::to_string(in_data0) +
-        std::string(" -DMLO_N_IN_BWD_VERT_READS=") + std::to_string(in_data1)
-
-        + std::string(" -DMLO_READ_TYPE=") + READ_TYPE + std::string(" -DMLO_READ_UNIT=") +
-        std::to_string(read_unit) + std::string(" -DMLO_HW_WAVE_SZ=") + std::to_string(hw_wave_sz) +
-        std::string(" -DMLO_LG2_WAVE_SZ=") + std::to_string(LG2_WAVE_SZ) +
-        std::string(" -DMLO_N_WAVES_MASK=") + std::to_string(static_cast<long long>(N_WAVES_MASK))
-
-        + std::string(" -DMLO_CONV_BIAS=") + std::to_string(params.bias)
-
-        + std::string(" -cl-denorms-are-zero  ") + params.general_compile_options;
+    KernelBuildParameters options{
+        {"MLO_DIR_FORWARD", is_forward ? 1 : 0},
+        {"MLO_GRP_SZ", GRP_SZ},
+        {"MLO_GRP_SZ0", result.grp_tile0},
+        {"MLO_GRP_SZ1", result.grp_tile1},
+        {"MLO_GRP_SZ2", grp_tile2},
+        {"MLO_FILTER_SIZE0", params.kernel_size_w},
+        {"MLO_FILTER_SIZE1", params.kernel_size_h},
+        {"MLO_FILTER_PAD0", params.pad_w},
+        {"MLO_FILTER_PAD1", params.pad_h},
+        {"MLO_FILTER_STRIDE0", params.kernel_stride_w},
+        {"MLO_FILTER_STRIDE1", params.kernel_stride_h},
+        {"STRIDE_W", params.kernel_stride_w},
+        {"STRIDE_H", params.kernel_stride_h},
+        {"MLO_N_OUTPUTS", params.n_outputs},
+        {"MLO_N_INPUTS", params.n_inputs},
+        {"MLO_BATCH_SZ", params.batch_sz},
+        {"MLO_N_BATCH_LOOPS", N_BATCH_LOOPS},
+        {"MLO_OUT_BATCH_STRIDE", params.out_batch_stride},
+        {"MLO_OUT_CHANNEL_STRIDE", params.out_channel_stride},
+        {"MLO_OUT_STRIDE", params.out_stride},
+        {"MLO_IN_BATCH_STRIDE", params.in_batch_stride},
+        {"MLO_IN_CHANNEL_STRIDE", params.in_channel_stride},
+        {"MLO_IN_STRIDE", params.in_stride},
+        {"MLO_WEI_BATCH_STRIDE", wei_bstride},
+        {"MLO_WEI_CHANNEL_STRIDE", wei_cstride},
+        {"MLO_IN_WIDTH", params.in_width},
+        {"MLO_IN_HEIGHT", params.in_height},
+        {"MLO_OUT_WIDTH", params.out_width},
+        {"MLO_OUT_HEIGHT", params.out_height},
+        {"MLO_IN_TILE1", result.in_tile1},
+        {"MLO_IN_TILE0", result.in_tile0},
+        {"MLO_N_LCL_BATCHS", result.n_stacks},          // # of diff stacks (part of batch).
+        {"MLO_N_LCL_OUT_MAPS", result.n_out_pix_tiles}, // # output pixel tiles per wk-item (ALU)
+        {"MLO_N_LCL_IN_MAPS", result.n_in_data_tiles},  // # of blocks of different inputs in LDS
+        {"MLO_IN_PIX_TILE1", in_pix_tile1},             // size of ouptput tile per wk-item (ALU)
+        {"MLO_IN_PIX_TILE0", in_pix_tile0},
+        {"MLO_OUT_PIX_TILE1", result.out_pix_tile1}, // size of ouptput tile per wk-item (ALU)
+        {"MLO_OUT_PIX_TILE0", result.out_pix_tile0},
+        {"MLO_OUT_STACKS", n_out_stacks},
+        {"MLO_IN_STACKS", n_in_stacks},
+        {"MLO_N_WAVES", n_waves},
+        {"MLO_N_FILTER_SPLITS0", N_FILTER_SPLITS0},
+        {"MLO_N_FILTER_SPLITS1", N_FILTER_SPLITS1},
+        {"MLO_PROCESSING_WIDTH", PROCESING_WIDTH},
+        {"MLO_OUT_EXTENT1", OUT_EXTENT1},
+        {"MLO_LAST_OUT_EXTENT1", last_out_extent1},
+        {"MLO_N_LCL_BATCHS_PASS2", n_batches_pass2},
+        {"MLO_TILE_REPLICATE0", data_multiplier0},
+        {"MLO_TILE_REPLICATE1", data_multiplier1},
+        {"MLO_LCL_BWD_MEM_SZ", lcl_bwd_sz},
+        {"MLO_N_IN_BWD_HORIZ_READS", in_data0},
+        {"MLO_N_IN_BWD_VERT_READS", in_data1},
+        {"MLO_READ_TYPE", READ_TYPE},
+        {"MLO_READ_UNIT", read_unit},
+        {"MLO_HW_WAVE_SZ", hw_wave_sz},
+        {"MLO_LG2_WAVE_SZ", LG2_WAVE_SZ},
+        {"MLO_N_WAVES_MASK", N_WAVES_MASK},
+        {"MLO_CONV_BIAS", params.bias},
+        {kbp::Option{}, "cl-denorms-are-zero"},
+    };
+    options << params.general_compile_options;
+    options.Canonicalize();
+    const auto comp_options = options.GenerateFor(kbp::OpenCL{});
 
     // 1st pass
     {
@@ -26,6 +26,7 @@
 
 #include "miopen/solver.hpp"
 #include "miopen/handle.hpp"
+#include "miopen/kernel_build_params.hpp"
 
 namespace miopen {
 namespace solver {
@@ -111,69 +112,51 @@ ConvSolution ConvOclDirectFwd3x3::GetSolution(const ConvolutionContext& params)
 
     KernelInfo construction_parameters;
 
-    construction_parameters.comp_options =
-        std::string(" -DMLO_DIR_FORWARD=") + (params.direction.IsForward() ? "1" : "0") +
-        std::string(" -DMLO_GRP_SZ=") + std::to_string(static_cast<long long>(GRP_SZ)) +
-        std::string(" -DMLO_GRP_SZ0=") + std::to_string(static_cast<long long>(result.grp_tile0)) +
-        std::string(" -DMLO_GRP_SZ1=") + std::to_string(static_cast<long long>(result.grp_tile1)) +
-        std::string(" -DMLO_GRP_SZ2=") + std::to_string(static_cast<long long>(grp_tile2)) +
-        std::string(" -DMLO_FILTER_SIZE0=") +
-        std::to_string(static_cast<long long>(params.kernel_size_w)) +
-        std::string(" -DMLO_FILTER_SIZE1=") +
-        std::to_string(static_cast<long long>(params.kernel_size_h)) +
-        std::string(" -DMLO_FILTER_PAD0=") + std::to_string(static_cast<long long>(params.pad_w)) +
-        std::string(" -DMLO_FILTER_PAD1=") + std::to_string(static_cast<long long>(params.pad_h)) +
-        std::string(" -DMLO_N_OUTPUTS=") +
-        std::to_string(static_cast<long long>(params.n_outputs)) + std::string(" -DMLO_N_INPUTS=") +
-        std::to_string(static_cast<long long>(params.n_inputs)) + std::string(" -DMLO_BATCH_SZ=") +
-        std::to_string(static_cast<long long>(params.batch_sz)) +
-        std::string(" -DMLO_OUT_BATCH_STRIDE=") +
-        std::to_string(static_cast<long long>(params.out_batch_stride)) +
-        std::string(" -DMLO_OUT_CHANNEL_STRIDE=") +
-        std::to_string(static_cast<long long>(params.out_channel_stride)) +
-        std::string(" -DMLO_OUT_STRIDE=") +
-        std::to_string(static_cast<long long>(params.out_stride)) +
-        std::string(" -DMLO_IN_BATCH_STRIDE=") +
-        std::to_string(static_cast<long long>(params.in_batch_stride)) +
-        std::string(" -DMLO_IN_CHANNEL_STRIDE=") +
-        std::to_string(static_cast<long long>(params.in_channel_stride)) +
-        std::string(" -DMLO_IN_STRIDE=") +
-        std::to_string(static_cast<long long>(params.in_stride)) +
-        std::string(" -DMLO_WEI_BATCH_STRIDE=") +
-        std::to_string(static_cast<long long>(wei_bstride)) +
-        std::string(" -DMLO_WEI_CHANNEL_STRIDE=") +
-        std::to_string(static_cast<long long>(wei_cstride)) + std::string(" -DMLO_IN_WIDTH=") +
-        std::to_string(static_cast<long long>(params.in_width)) + std::string(" -DMLO_IN_HEIGHT=") +
-        std::to_string(static_cast<long long>(params.in_height)) +
-        std::string(" -DMLO_N_LCL_BATCHS=") +
-        std::to_string(static_cast<long long>(result.n_stacks)) // # of diff stacks (part of batch).
-        + std::string(" -DMLO_N_LCL_OUT_MAPS=") +
-        std::to_string(static_cast<long long>(
-            result.n_out_pix_tiles)) // # output pixel tiles per wk-item (ALU)
-        + std::string(" -DMLO_N_LCL_IN_MAPS=") +
-        std::to_string(
-            static_cast<long long>(n_in_data_tiles)) // total # of blocks of different inputs in LDS
-        + std::string(" -DMLO_OUT_TILE0=") +
-        std::to_string(
-            static_cast<long long>(result.out_pix_tile0)) // size of ouptput tile per wk-item (ALU))
-        + std::string(" -DMLO_OUT_TILE1=") +
-        std::to_string(static_cast<long long>(result.out_pix_tile1)) //
-        + std::string(" -DMLO_ALU_EXTENT_X=") +
-        std::to_string(static_cast<long long>(ALU_EXTENT_X)) +
-        std::string(" -DMLO_LG2ALU_EXTENT_X=") +
-        std::to_string(static_cast<long long>(LG2ALU_EXTENT_X)) +
-        std::string(" -DMLO_ALU_EXTENT_Y=") + std::to_string(static_cast<long long>(ALU_EXTENT_Y)) +
-        std::string(" -DMLO_LG2ALU_EXTENT_Y=") +
-        std::to_string(static_cast<long long>(LG2ALU_EXTENT_Y)) +
-        std::string(" -DMLO_OUT_EXTENT1=") + std::to_string(static_cast<long long>(OUT_EXTENT1)) +
-        std::string(" -DMLO_OUT_EXTENT0=") + std::to_string(static_cast<long long>(OUT_EXTENT0)) +
-        std::string(" -DMLO_N_WAVES=") + std::to_string(static_cast<long long>(logical_n_waves)) +
-        std::string(" -DMLO_N_WAVES_MASK=") + std::to_string(static_cast<long long>(N_WAVES_MASK)) +
-        std::string(" -DMLO_LG2_WAVE_SZ=") + std::to_string(static_cast<long long>(LG2_WAVE_SZ)) +
-        std::string(" -DMLO_LG2_WAVE_SZ0=") + std::to_string(static_cast<long long>(LG2_WAVE_SZ0)) +
-        std::string(" -DMLO_READ_TYPE=") + READ_TYPE + std::string(" -DMLO_READ_UNIT=") +
-        std::to_string(static_cast<long long>(read_unit)) + std::string(" -DMLO_CONV_BIAS=") +
-        std::to_string(static_cast<long long>(params.bias)) + params.general_compile_options;
+    KernelBuildParameters options{
+        {"MLO_DIR_FORWARD", params.direction.IsForward() ? 1 : 0},
+        {"MLO_GRP_SZ", GRP_SZ},
+        {"MLO_GRP_SZ0", result.grp_tile0},
+        {"MLO_GRP_SZ1", result.grp_tile1},
+        {"MLO_GRP_SZ2", grp_tile2},
+        {"MLO_FILTER_SIZE0", params.kernel_size_w},
+        {"MLO_FILTER_SIZE1", params.kernel_size_h},
+        {"MLO_FILTER_PAD0", params.pad_w},
+        {"MLO_FILTER_PAD1", params.pad_h},
+        {"MLO_N_OUTPUTS", params.n_outputs},
+        {"MLO_N_INPUTS", params.n_inputs},
+        {"MLO_BATCH_SZ", params.batch_sz},
+        {"MLO_OUT_BATCH_STRIDE", params.out_batch_stride},
+        {"MLO_OUT_CHANNEL_STRIDE", params.out_channel_stride},
+        {"MLO_OUT_STRIDE", params.out_stride},
+        {"MLO_IN_BATCH_STRIDE", params.in_batch_stride},
+        {"MLO_IN_CHANNEL_STRIDE", params.in_channel_stride},
+        {"MLO_IN_STRIDE", params.in_stride},
+        {"MLO_WEI_BATCH_STRIDE", wei_bstride},
+        {"MLO_WEI_CHANNEL_STRIDE", wei_cstride},
+        {"MLO_IN_WIDTH", params.in_width},
+        {"MLO_IN_HEIGHT", params.in_height},
+        {"MLO_N_LCL_BATCHS", result.n_stacks},          // # of diff stacks (part of batch).
+        {"MLO_N_LCL_OUT_MAPS", result.n_out_pix_tiles}, // # output pixel tiles per wk-item (ALU)
+        {"MLO_N_LCL_IN_MAPS", n_in_data_tiles},         // # of blocks of different inputs in LDS
+        {"MLO_OUT_TILE0", result.out_pix_tile0},        // size of ouptput tile per wk-item (ALU)
+        {"MLO_OUT_TILE1", result.out_pix_tile1},
+        {"MLO_ALU_EXTENT_X", ALU_EXTENT_X},
+        {"MLO_LG2ALU_EXTENT_X", LG2ALU_EXTENT_X},
+        {"MLO_ALU_EXTENT_Y", ALU_EXTENT_Y},
+        {"MLO_LG2ALU_EXTENT_Y", LG2ALU_EXTENT_Y},
+        {"MLO_OUT_EXTENT1", OUT_EXTENT1},
+        {"MLO_OUT_EXTENT0", OUT_EXTENT0},
+        {"MLO_N_WAVES", logical_n_waves},
+        {"MLO_N_WAVES_MASK", N_WAVES_MASK},
+        {"MLO_LG2_WAVE_SZ", LG2_WAVE_SZ},
+        {"MLO_LG2_WAVE_SZ0", LG2_WAVE_SZ0},
+        {"MLO_READ_TYPE", READ_TYPE},
+        {"MLO_READ_UNIT", read_unit},
+        {"MLO_CONV_BIAS", params.bias},
+    };
+    options << params.general_compile_options;
+    options.Canonicalize();
+    construction_parameters.comp_options = options.GenerateFor(kbp::OpenCL{});
 
     construction_parameters.l_wk.push_back(result.grp_tile0);
     construction_parameters.l_wk.push_back(result.grp_tile1);
@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include "miopen/solver.hpp"
+#include "miopen/kernel_build_params.hpp"
 
 #define TWO_PASSES 1
 
@@ -255,58 +256,63 @@ ConvSolution ConvOclBwdWrW1x1::GetSolution(const ConvolutionContext& params) con
         int kernel0_stride0    = params.kernel_stride_w;
         int kernel0_stride1    = params.kernel_stride_h;
 
-        const auto comp_options =
-            std::string(" -DMLO_GRP_SZ0=") + std::to_string(n_grp_size0) +
-            std::string(" -DMLO_GRP_SZ1=1 ") + std::string(" -DMLO_GRP_SZ2=1 ") +
-            std::string(" -DMLO_GRP0_SZ0=") + std::to_string(n_grp0_size0) +
-            std::string(" -DMLO_GRP0_SZ1=1 ") + std::string(" -DMLO_GRP0_SZ2=1 ") +
-            std::string(" -DMLO_FILTER_SIZE0=") + std::to_string(params.kernel_size_w) +
-            std::string(" -DMLO_FILTER_SIZE1=") + std::to_string(params.kernel_size_h) +
-            std::string(" -DMLO_FILTER_PAD0=") + std::to_string(params.pad_w) +
-            std::string(" -DMLO_FILTER_PAD1=") + std::to_string(params.pad_h) +
-            std::string(" -DMLO_FILTER_STRIDE0=") + std::to_string(kernel_stride_w) +
-            std::string(" -DMLO_FILTER_STRIDE1=") + std::to_string(kernel_stride_h) +
-            std::string(" -DMLO_FILTER0_STRIDE0=") + std::to_string(kernel0_stride0) +
-            std::string(" -DMLO_FILTER0_STRIDE1=") + std::to_string(kernel0_stride1) +
-            std::string(" -DMLO_N_OUTPUTS=") + std::to_string(params.n_inputs) +
-            std::string(" -DMLO_N_INPUTS=") + std::to_string(params.n_outputs) +
-            std::string(" -DMLO_BATCH_SZ=") + std::to_string(params.batch_sz) +
-            std::string(" -DMLO_IN_WIDTH=") + std::to_string(in_width) +
-            std::string(" -DMLO_IN_HEIGHT=") + std::to_string(in_height) +
-            std::string(" -DMLO_OUT_WIDTH=") + std::to_string(params.in_width) +
-            std::string(" -DMLO_OUT_HEIGHT=") + std::to_string(params.in_height) +
-            std::string(" -DMLO_N_LOAD_DWORDS_PER_MAP_ONCE=") +
-            std::to_string(n_load_dwords_per_map_once) + std::string(" -DMLO_N_LCL_IN_MAPS=") +
-            std::to_string(n_lcl_in_maps) + std::string(" -DMLO_N_LCL_OUT_MAPS=") +
-            std::to_string(n_lcl_out_maps) + std::string(" -DMLO_READ_UNIT=") +
-            std::to_string(read_unit) + std::string(" -DMLO_WRITE_UNIT=") +
-            std::to_string(write_unit) + std::string(" -DMLO_OUT_BATCH_STRIDE=") +
-            std::to_string(out_batch_stride) + std::string(" -DMLO_OUT_CHANNEL_STRIDE=") +
-            std::to_string(out_channel_stride) + std::string(" -DMLO_OUT_STRIDE=") +
-            std::to_string(out_stride) + std::string(" -DMLO_IN_BATCH_STRIDE=") +
-            std::to_string(in_batch_stride) + std::string(" -DMLO_IN_CHANNEL_STRIDE=") +
-            std::to_string(in_channel_stride) + std::string(" -DMLO_IN_STRIDE=") +
-            std::to_string(in_stride) + std::string(" -DMLO_IN0_BATCH_STRIDE=") +
-            std::to_string(in0_batch_stride) + std::string(" -DMLO_IN0_CHANNEL_STRIDE=") +
-            std::to_string(in0_channel_stride) + std::string(" -DMLO_IN0_STRIDE=") +
-            std::to_string(in0_stride) + std::string(" -DMLO_WEI_BATCH_STRIDE=") +
-            std::to_string(wei_batch_stride) + std::string(" -DMLO_WEI_CHANNEL_STRIDE=") +
-            std::to_string(wei_channel_stride) + std::string(" -DMLO_MAX_LOADS=") +
-            std::to_string(max_loads_per_readunit) + std::string(" -DMLO_ACCUM_SZ=") +
-            std::to_string(accum_sz) + std::string(" -DMLO_OUT_READ_SZ=") +
-            std::to_string(out_read_sz) + std::string(" -DMLO_IN_READ_SZ=") +
-            std::to_string(in_read_sz) + std::string(" -DMLO_OUT_CHANNEL_READ_SZ=") +
-            std::to_string(out_channel_read_sz) + std::string(" -DMLO_N_IN_TILE_BLOCK=") +
-            std::to_string(n_in_tile_block) + std::string(" -DMLO_N_LCL_OUT_MAPS_ONCE=") +
-            std::to_string(n_lcl_out_map_once) + std::string(" -DMLO_N_LCL_IN_MAPS_ONCE=") +
-            std::to_string(n_lcl_in_map_once) + std::string(" -DMLO_IN_PAD_MIN_X=") +
-            std::to_string(in_pad_min_x) + std::string(" -DMLO_IN_PAD_MIN_Y=") +
-            std::to_string(in_pad_min_y) + std::string(" -DMLO_OUT_PAD_MIN_X=") +
-            std::to_string(out_pad_min_x) + std::string(" -DMLO_OUT_PAD_MIN_Y=") +
-            std::to_string(out_pad_min_y) + std::string(" -DMLO_OUT_PAD_WIDTH=") +
-            std::to_string(out_pad_width) + std::string(" -DMLO_OUT_PAD_HEIGHT=") +
-            std::to_string(out_pad_height) + std::string(" -DMLO_TWO_PASSES=") +
-            std::to_string((n_passes == 1) ? 0 : 1) + params.general_compile_options;
+        KernelBuildParameters options{
+            {"MLO_GRP_SZ0", n_grp_size0},
+            {"MLO_GRP_SZ1", 1},
+            {"MLO_GRP_SZ2", 1},
+            {"MLO_GRP0_SZ0", n_grp0_size0},
+            {"MLO_GRP0_SZ1", 1},
+            {"MLO_GRP0_SZ2", 1},
+            {"MLO_FILTER_SIZE0", params.kernel_size_w},
+            {"MLO_FILTER_SIZE1", params.kernel_size_h},
+            {"MLO_FILTER_PAD0", params.pad_w},
+            {"MLO_FILTER_PAD1", params.pad_h},
+            {"MLO_FILTER_STRIDE0", kernel_stride_w},
+            {"MLO_FILTER_STRIDE1", kernel_stride_h},
+            {"MLO_FILTER0_STRIDE0", kernel0_stride0},
+            {"MLO_FILTER0_STRIDE1", kernel0_stride1},
+            {"MLO_N_OUTPUTS", params.n_inputs},
+            {"MLO_N_INPUTS", params.n_outputs},
+            {"MLO_BATCH_SZ", params.batch_sz},
+            {"MLO_IN_WIDTH", in_width},
+            {"MLO_IN_HEIGHT", in_height},
+            {"MLO_OUT_WIDTH", params.in_width},
+            {"MLO_OUT_HEIGHT", params.in_height},
+            {"MLO_N_LOAD_DWORDS_PER_MAP_ONCE", n_load_dwords_per_map_once},
+            {"MLO_N_LCL_IN_MAPS", n_lcl_in_maps},
+            {"MLO_N_LCL_OUT_MAPS", n_lcl_out_maps},
+            {"MLO_READ_UNIT", read_unit},
+            {"MLO_WRITE_UNIT", write_unit},
+            {"MLO_OUT_BATCH_STRIDE", out_batch_stride},
+            {"MLO_OUT_CHANNEL_STRIDE", out_channel_stride},
+            {"MLO_OUT_STRIDE", out_stride},
+            {"MLO_IN_BATCH_STRIDE", in_batch_stride},
+            {"MLO_IN_CHANNEL_STRIDE", in_channel_stride},
+            {"MLO_IN_STRIDE", in_stride},
+            {"MLO_IN0_BATCH_STRIDE", in0_batch_stride},
+            {"MLO_IN0_CHANNEL_STRIDE", in0_channel_stride},
+            {"MLO_IN0_STRIDE", in0_stride},
+            {"MLO_WEI_BATCH_STRIDE", wei_batch_stride},
+            {"MLO_WEI_CHANNEL_STRIDE", wei_channel_stride},
+            {"MLO_MAX_LOADS", max_loads_per_readunit},
+            {"MLO_ACCUM_SZ", accum_sz},
+            {"MLO_OUT_READ_SZ", out_read_sz},
+            {"MLO_IN_READ_SZ", in_read_sz},
+            {"MLO_OUT_CHANNEL_READ_SZ", out_channel_read_sz},
+            {"MLO_N_IN_TILE_BLOCK", n_in_tile_block},
+            {"MLO_N_LCL_OUT_MAPS_ONCE", n_lcl_out_map_once},
+            {"MLO_N_LCL_IN_MAPS_ONCE", n_lcl_in_map_once},
+            {"MLO_IN_PAD_MIN_X", in_pad_min_x},
+            {"MLO_IN_PAD_MIN_Y", in_pad_min_y},
+            {"MLO_OUT_PAD_MIN_X", out_pad_min_x},
+            {"MLO_OUT_PAD_MIN_Y", out_pad_min_y},
+            {"MLO_OUT_PAD_WIDTH", out_pad_width},
+            {"MLO_OUT_PAD_HEIGHT", out_pad_height},
+            {"MLO_TWO_PASSES", (n_passes == 1) ? 0 : 1},
+        };
+        options << params.general_compile_options;
+        options.Canonicalize();
+        const auto comp_options = options.GenerateFor(kbp::OpenCL{});
 
         result.workspce_sz = 0;
 
@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include "miopen/solver.hpp"
+#include "miopen/kernel_build_params.hpp"
 #include "miopen/mlo_utils.hpp"
 #include <miopen/generic_search.hpp>
 #include <algorithm>
@@ -600,58 +601,60 @@ ConvSolution ConvOclBwdWrW2<N_BATCH_LOOPS>::GetSolution(
     if(!params.direction.IsBackwardWrW())
         MIOPEN_THROW("!params.direction.IsBackwardWrW()");
     // it's backward - inputs are outputs and vs versa
-    const auto comp_options =
-        std::string(" -DMLO_DIR_FORWARD=0") + std::string(" -DMLO_GRP_SZ=") +
-        std::to_string((workgroup_size)) + std::string(" -DMLO_GRP_SZ0=") +
-        std::to_string((result.grp_tile0)) + std::string(" -DMLO_GRP_SZ1=") +
-        std::to_string((result.grp_tile1)) + std::string(" -DMLO_GRP_SZ2=") +
-        std::to_string((grp_tile2)) + std::string(" -DMLO_FILTER_SIZE0=") +
-        std::to_string(params.kernel_size_w) + std::string(" -DMLO_FILTER_SIZE1=") +
-        std::to_string(params.kernel_size_h) + std::string(" -DMLO_FILTER_PAD0=") +
-        std::to_string(params.pad_w) + std::string(" -DMLO_FILTER_PAD1=") +
-        std::to_string(params.pad_h) + std::string(" -DMLO_FILTER_STRIDE0=") +
-        std::to_string(params.kernel_stride_w) + std::string(" -DMLO_FILTER_STRIDE1=") +
-        std::to_string(params.kernel_stride_h) + std::string(" -DMLO_N_OUTPUTS=") +
-        std::to_string(params.n_inputs) + std::string(" -DMLO_N_INPUTS=") +
-        std::to_string(params.n_outputs) + std::string(" -DMLO_BATCH_SZ=") +
-        std::to_string(params.batch_sz) + std::string(" -DMLO_N_BATCH_LOOPS=") +
-        std::to_string(N_BATCH_LOOPS) + std::string(" -DMLO_N_BATCH_BLKS=") +
-        std::to_string(n_batch_blks) + std::string(" -DMLO_OUT_BATCH_STRIDE=") +
-        std::to_string((params.in_batch_stride)) + std::string(" -DMLO_OUT_CHANNEL_STRIDE=") +
-        std::to_string((params.in_channel_stride)) + std::string(" -DMLO_OUT_STRIDE=") +
-        std::to_string((params.in_stride)) + std::string(" -DMLO_IN_BATCH_STRIDE=") +
-        std::to_string((params.out_batch_stride)) + std::string(" -DMLO_IN_CHANNEL_STRIDE=") +
-        std::to_string((params.out_channel_stride)) + std::string(" -DMLO_IN_STRIDE=") +
-        std::to_string((params.out_stride)) + std::string(" -DMLO_WEI_BATCH_STRIDE=") +
-        std::to_string((wei_bstride)) + std::string(" -DMLO_WEI_CHANNEL_STRIDE=") +
-        std::to_string((wei_cstride)) + std::string(" -DMLO_IN_WIDTH=") +
-        std::to_string((params.out_width)) + std::string(" -DMLO_IN_HEIGHT=") +
-        std::to_string(params.out_height) + std::string(" -DMLO_OUT_WIDTH=") +
-        std::to_string(params.in_width) + std::string(" -DMLO_OUT_HEIGHT=") +
-        std::to_string(params.in_height) + std::string(" -DMLO_N_LCL_OUT_MAPS=") +
-        std::to_string(config.n_out_channels_tiles) +
-        // # output pixel tiles per wk-item (ALU)
-        std::string(" -DMLO_N_LCL_IN_MAPS=") + std::to_string(result.n_in_data_tiles) +
-        // total # of blocks of different inputs in LDS
-        std::string(" -DMLO_N_WAVES=") + std::to_string(config.n_waves) +
-        std::string(" -DMLO_READ_TYPE=") + READ_TYPE + std::string(" -DMLO_READ_UNIT=") +
-        std::to_string(config.read_size) + std::string(" -DMLO_ALIGNED_OUT_SCAN_LN=") +
-        std::to_string(aligned_out_scan_lane) + // image aligned scan
-        std::string(" -DMLO_N_ALIGNED_OUT_SCAN_BLK=") + std::to_string(config.n_out_rows_in_lcl) +
-        std::string(" -DMLO_WEI_WKITEM=") + std::to_string(wei_per_wkitem) +
-        std::string(" -DMLO_N_OUT_BLK_GRP=") + std::to_string(config.n_out_channels_per_tile) +
-        std::string(" -DMLO_N_OUT_BLK=") + std::to_string(n_out_blk) +
-        std::string(" -DMLO_HW_WAVE_SZ=") + std::to_string(hw_wave_size) +
-        std::string(" -DMLO_OUT_N_PIXS_OFF=") + std::to_string(out_n_pixels_off) +
-        std::string(" -DMLO_IN_LCL_WIDTH=") + std::to_string(in_lcl_width) +
-        std::string(" -DMLO_IN_LCL_SZ=") + std::to_string(in_lcl_sz) +
-        std::string(" -DMLO_CONV_BIAS=") + std::to_string(params.bias) +
-        std::string(" -DMLO_UT_READ_TYPE=") + UT_READ_TYPE + std::string(" -DMLO_UT_READ_UNIT=") +
-        std::to_string(utility_read_unit) + std::string(" -DMLO_UT_GRP_SZ0=") +
-        std::to_string(utility_workgroup_size) + std::string(" -DMLO_GROUP_COUNTS=") +
-        std::to_string(params.group_counts) + std::string(" -DMLO_N_INPUTS_PER_GROUP=") +
-        std::to_string(n_input_channels_per_group) + std::string(" -DMLO_N_OUTPUTS_PER_GROUP=") +
-        std::to_string(n_output_channels_per_group) + params.general_compile_options;
+    KernelBuildParameters options{
+        {"MLO_DIR_FORWARD", 0},
+        {"MLO_GRP_SZ", workgroup_size},
+        {"MLO_GRP_SZ0", result.grp_tile0},
+        {"MLO_GRP_SZ1", result.grp_tile1},
+        {"MLO_GRP_SZ2", grp_tile2},
+        {"MLO_FILTER_SIZE0", params.kernel_size_w},
+        {"MLO_FILTER_SIZE1", params.kernel_size_h},
+        {"MLO_FILTER_PAD0", params.pad_w},
+        {"MLO_FILTER_PAD1", params.pad_h},
+        {"MLO_FILTER_STRIDE0", params.kernel_stride_w},
+        {"MLO_FILTER_STRIDE1", params.kernel_stride_h},
+        {"MLO_N_OUTPUTS", params.n_inputs},
+        {"MLO_N_INPUTS", params.n_outputs},
+        {"MLO_BATCH_SZ", params.batch_sz},
+        {"MLO_N_BATCH_LOOPS", N_BATCH_LOOPS},
+        {"MLO_N_BATCH_BLKS", n_batch_blks},
+        {"MLO_OUT_BATCH_STRIDE", params.in_batch_stride},
+        {"MLO_OUT_CHANNEL_STRIDE", params.in_channel_stride},
+        {"MLO_OUT_STRIDE", params.in_stride},
+        {"MLO_IN_BATCH_STRIDE", params.out_batch_stride},
+        {"MLO_IN_CHANNEL_STRIDE", params.out_channel_stride},
+        {"MLO_IN_STRIDE", params.out_stride},
+        {"MLO_WEI_BATCH_STRIDE", wei_bstride},
+        {"MLO_WEI_CHANNEL_STRIDE", wei_cstride},
+        {"MLO_IN_WIDTH", params.out_width},
+        {"MLO_IN_HEIGHT", params.out_height},
+        {"MLO_OUT_WIDTH", params.in_width},
+        {"MLO_OUT_HEIGHT", params.in_height},
+        {"MLO_N_LCL_OUT_MAPS", config.n_out_channels_tiles}, // # output pixel tiles per wk-item
+        {"MLO_N_LCL_IN_MAPS", result.n_in_data_tiles},       // # of blocks of inputs in LDS
+        {"MLO_N_WAVES", config.n_waves},
+        {"MLO_READ_TYPE", READ_TYPE},
+        {"MLO_READ_UNIT", config.read_size},
+        {"MLO_ALIGNED_OUT_SCAN_LN", aligned_out_scan_lane}, // image aligned scan
+        {"MLO_N_ALIGNED_OUT_SCAN_BLK", config.n_out_rows_in_lcl},
+        {"MLO_WEI_WKITEM", wei_per_wkitem},
+        {"MLO_N_OUT_BLK_GRP", config.n_out_channels_per_tile},
+        {"MLO_N_OUT_BLK", n_out_blk},
+        {"MLO_HW_WAVE_SZ", hw_wave_size},
+        {"MLO_OUT_N_PIXS_OFF", out_n_pixels_off},
+        {"MLO_IN_LCL_WIDTH", in_lcl_width},
+        {"MLO_IN_LCL_SZ", in_lcl_sz},
+        {"MLO_CONV_BIAS", params.bias},
+        {"MLO_UT_READ_TYPE", UT_READ_TYPE},
+        {"MLO_UT_READ_UNIT", utility_read_unit},
+        {"MLO_UT_GRP_SZ0", utility_workgroup_size},
+        {"MLO_GROUP_COUNTS", params.group_counts},
+        {"MLO_N_INPUTS_PER_GROUP", n_input_channels_per_group},
+        {"MLO_N_OUTPUTS_PER_GROUP", n_output_channels_per_group},
+    };
+    options << params.general_compile_options;
+    options.Canonicalize();
+    const auto comp_options = options.GenerateFor(kbp::OpenCL{});
 
     // wrt to W
     {
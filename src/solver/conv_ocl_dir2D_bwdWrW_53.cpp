@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include "miopen/solver.hpp"
+#include "miopen/kernel_build_params.hpp"
 #include <miopen/env.hpp>
 
 namespace miopen {
@@ -429,76 +430,73 @@ ConvSolution ConvOclBwdWrW53::GetSolution(const ConvolutionContext& params) cons
     if(!params.direction.IsBackwardWrW())
         MIOPEN_THROW("!params.direction.IsBackwardWrW()");
     // it's backward - inputs are outputs and vs versa
-    const auto comp_options =
-        std::string(" -DMLO_DIR_FORWARD=0") + std::string(" -DMLO_GRP_SZ=") +
-        std::to_string(GRP_SZ) + std::string(" -DMLO_GRP_SZ0=") + std::to_string(result.grp_tile0) +
-        std::string(" -DMLO_GRP_SZ1=") + std::to_string(result.grp_tile1) +
-        std::string(" -DMLO_GRP_SZ2=") + std::to_string(grp_tile2) +
-        std::string(" -DMLO_FILTER_SIZE0=") + std::to_string(params.kernel_size_w) +
-        std::string(" -DMLO_FILTER_SIZE1=") + std::to_string(params.kernel_size_h) +
-        std::string(" -DMLO_FILTER_PAD0=") + std::to_string(params.pad_w) +
-        std::string(" -DMLO_FILTER_PAD1=") + std::to_string(params.pad_h) +
-        std::string(" -DMLO_FILTER_STRIDE0=") + std::to_string(params.kernel_stride_w) +
-        std::string(" -DMLO_FILTER_STRIDE1=") + std::to_string(params.kernel_stride_h) +
-        std::string(" -DSTRIDE_W=") + std::to_string(params.kernel_stride_w) +
-        std::string(" -DSTRIDE_H=") + std::to_string(params.kernel_stride_h) +
-        std::string(" -DMLO_N_OUTPUTS=") + std::to_string(params.n_inputs) +
-        std::string(" -DMLO_N_INPUTS=") + std::to_string(params.n_outputs) +
-        std::string(" -DMLO_GROUP_COUNTS=") + std::to_string(params.group_counts) +
-        std::string(" -DMLO_N_INPUTS_PER_GROUP=") + std::to_string(n_input_channels_per_group) +
-        std::string(" -DMLO_N_OUTPUTS_PER_GROUP=") + std::to_string(n_output_channels_per_group) +
-        std::string(" -DMLO_BATCH_SZ=") + std::to_string(params.batch_sz) +
-        std::string(" -DMLO_N_BATCH_LOOPS=") + std::to_string(N_BATCH_LOOPS) +
-        std::string(" -DMLO_OUT_BATCH_STRIDE=") + std::to_string(params.in_batch_stride) +
-        std::string(" -DMLO_OUT_CHANNEL_STRIDE=") + std::to_string(params.in_channel_stride) +
-        std::string(" -DMLO_OUT_STRIDE=") + std::to_string(params.in_stride) +
-        std::string(" -DMLO_IN_BATCH_STRIDE=") + std::to_string(params.out_batch_stride) +
-        std::string(" -DMLO_IN_CHANNEL_STRIDE=") + std::to_string(params.out_channel_stride) +
-        std::string(" -DMLO_IN_STRIDE=") + std::to_string(params.out_stride) +
-        std::string(" -DMLO_WEI_BATCH_STRIDE=") + std::to_string(wei_bstride) +
-        std::string(" -DMLO_WEI_CHANNEL_STRIDE=") + std::to_string(wei_cstride) +
-        std::string(" -DMLO_IN_WIDTH=") + std::to_string(params.out_width) +
-        std::string(" -DMLO_IN_HEIGHT=") + std::to_string(params.out_height) +
-        std::string(" -DMLO_OUT_WIDTH=") + std::to_string(params.in_width) +
-        std::string(" -DMLO_OUT_HEIGHT=") + std::to_string(params.in_height) +
-        std::string(" -DMLO_IN_TILE1=") + std::to_string(result.in_tile1) +
-        std::string(" -DMLO_IN_TILE0=") + std::to_string(result.in_tile0) +
-        std::string(" -DMLO_N_LCL_BATCHS=") +
-        std::to_string(result.n_stacks) // # of diff stacks (part of batch).
-        + std::string(" -DMLO_N_LCL_OUT_MAPS=") +
-        std::to_string(result.n_out_pix_tiles) // # output pixel tiles per wk-item (ALU)
-        + std::string(" -DMLO_N_LCL_IN_MAPS=") +
-        std::to_string(result.n_in_data_tiles) // total # of blocks of different inputs in LDS
-        + std::string(" -DMLO_OUT_TILE0=") +
-        std::to_string(result.out_pix_tile0) // size of ouptput tile per wk-item (ALU)
-        + std::string(" -DMLO_OUT_TILE1=") + std::to_string(result.out_pix_tile1) //
-        + std::string(" -DMLO_OUT_STACKS=") + std::to_string(n_out_stacks) +
-        std::string(" -DMLO_N_WAVES=") + std::to_string(n_waves) +
-        std::string(" -DMLO_READ_TYPE=") + READ_TYPE + std::string(" -DMLO_READ_UNIT=") +
-        std::to_string(read_unit) + std::string(" -DMLO_HW_WAVE_SZ=") + std::to_string(hw_wave_sz) +
-        std::string(" -DMLO_LG2_PHYS_WAVE_SZ=") + std::to_string(mloLg2(hw_wave_sz)) +
-        std::string(" -DMLO_IN_EXTENT1=") + std::to_string(out_n_vert_reads) +
-        std::string(" -DMLO_IN_N_VERT_LOOPS=") + std::to_string(out_n_vert_read_loops) +
-        std::string(" -DMLO_IN_WIDTH_CHUNK=") +
-        std::to_string((out_n_horizon_read_loops == 1) ? params.out_width : out_n_horizon_reads) +
-        std::string(" -DMLO_IN_WIDTH_N_LOOPS=") + std::to_string(out_n_horizon_read_loops) +
-        std::string(" -DMLO_IN_WIDTH_LAST_CHUNK_VALID_READ_UNITS=") +
-        std::to_string(out_horizon_last_chunk_valid_read_units) +
-        std::string(" -DMLO_IN_WIDTH_LAST_CHUNK_VALID_PIXELS_IN_LAST_READ_UNIT=") +
-        std::to_string(out_horizon_last_chunk_valid_pixels_in_last_read_unit) +
-        std::string(" -DMLO_OUT_WIDTH_CHUNK=") + std::to_string(in_width_chunk) +
-        std::string(" -DMLO_OUT_WIDTH_N_LOOPS=") + std::to_string(out_n_horizon_read_loops) +
-        std::string(" -DMLO_OUT_WIDTH_LAST_CHUNK_VALID_SPANS=") +
-        std::to_string(in_width_last_chunk_valid_spans) +
-        std::string(" -DMLO_OUT_WIDTH_LAST_CHUNK_VALID_PIXELS_IN_LAST_SPAN=") +
-        std::to_string(in_width_last_chunk_valid_pixels_in_last_span) +
-        std::string(" -DMLO_CONV_BIAS=") + std::to_string(params.bias) +
-        std::string(" -DMLO_UT_READ_TYPE=") + UT_READ_TYPE + std::string(" -DMLO_UT_READ_UNIT=") +
-        std::to_string(ut_read_unit) + std::string(" -DMLO_UT_GRP_SZ0=") +
-        std::to_string(UT_GRP_SZ0)
-
-        //		+ std::string(" -limit-vector-registers=64 ")
-        + params.general_compile_options;
+    KernelBuildParameters options{
+        {"MLO_DIR_FORWARD", 0},
+        {"MLO_GRP_SZ", GRP_SZ},
+        {"MLO_GRP_SZ0", result.grp_tile0},
+        {"MLO_GRP_SZ1", result.grp_tile1},
+        {"MLO_GRP_SZ2", grp_tile2},
+        {"MLO_FILTER_SIZE0", params.kernel_size_w},
+        {"MLO_FILTER_SIZE1", params.kernel_size_h},
+        {"MLO_FILTER_PAD0", params.pad_w},
+        {"MLO_FILTER_PAD1", params.pad_h},
+        {"MLO_FILTER_STRIDE0", params.kernel_stride_w},
+        {"MLO_FILTER_STRIDE1", params.kernel_stride_h},
+        {"STRIDE_W", params.kernel_stride_w},
+        {"STRIDE_H", params.kernel_stride_h},
+        {"MLO_N_OUTPUTS", params.n_inputs},
+        {"MLO_N_INPUTS", params.n_outputs},
+        {"MLO_GROUP_COUNTS", params.group_counts},
+        {"MLO_N_INPUTS_PER_GROUP", n_input_channels_per_group},
+        {"MLO_N_OUTPUTS_PER_GROUP", n_output_channels_per_group},
+        {"MLO_BATCH_SZ", params.batch_sz},
+        {"MLO_N_BATCH_LOOPS", N_BATCH_LOOPS},
+        {"MLO_OUT_BATCH_STRIDE", params.in_batch_stride},
+        {"MLO_OUT_CHANNEL_STRIDE", params.in_channel_stride},
+        {"MLO_OUT_STRIDE", params.in_stride},
+        {"MLO_IN_BATCH_STRIDE", params.out_batch_stride},
+        {"MLO_IN_CHANNEL_STRIDE", params.out_channel_stride},
+        {"MLO_IN_STRIDE", params.out_stride},
+        {"MLO_WEI_BATCH_STRIDE", wei_bstride},
+        {"MLO_WEI_CHANNEL_STRIDE", wei_cstride},
+        {"MLO_IN_WIDTH", params.out_width},
+        {"MLO_IN_HEIGHT", params.out_height},
+        {"MLO_OUT_WIDTH", params.in_width},
+        {"MLO_OUT_HEIGHT", params.in_height},
+        {"MLO_IN_TILE1", result.in_tile1},
+        {"MLO_IN_TILE0", result.in_tile0},
+        {"MLO_N_LCL_BATCHS", result.n_stacks},          // # of diff stacks (part of batch).
+        {"MLO_N_LCL_OUT_MAPS", result.n_out_pix_tiles}, // # output pixel tiles per wk-item
+        {"MLO_N_LCL_IN_MAPS", result.n_in_data_tiles},  // # of blocks of inputs in LDS
+        {"MLO_OUT_TILE0", result.out_pix_tile0},        // size of ouptput tile per wk-item (ALU)
+        {"MLO_OUT_TILE1", result.out_pix_tile1},
+        {"MLO_OUT_STACKS", n_out_stacks},
+        {"MLO_N_WAVES", n_waves},
+        {"MLO_READ_TYPE", READ_TYPE},
+        {"MLO_READ_UNIT", read_unit},
+        {"MLO_HW_WAVE_SZ", hw_wave_sz},
+        {"MLO_LG2_PHYS_WAVE_SZ", mloLg2(hw_wave_sz)},
+        {"MLO_IN_EXTENT1", out_n_vert_reads},
+        {"MLO_IN_N_VERT_LOOPS", out_n_vert_read_loops},
+        {"MLO_IN_WIDTH_CHUNK",
+         (out_n_horizon_read_loops == 1) ? params.out_width : out_n_horizon_reads},
+        {"MLO_IN_WIDTH_N_LOOPS", out_n_horizon_read_loops},
+        {"MLO_IN_WIDTH_LAST_CHUNK_VALID_READ_UNITS", out_horizon_last_chunk_valid_read_units},
+        {"MLO_IN_WIDTH_LAST_CHUNK_VALID_PIXELS_IN_LAST_READ_UNIT",
+         out_horizon_last_chunk_valid_pixels_in_last_read_unit},
+        {"MLO_OUT_WIDTH_CHUNK", in_width_chunk},
+        {"MLO_OUT_WIDTH_N_LOOPS", out_n_horizon_read_loops},
+        {"MLO_OUT_WIDTH_LAST_CHUNK_VALID_SPANS", in_width_last_chunk_valid_spans},
+        {"MLO_OUT_WIDTH_LAST_CHUNK_VALID_PIXELS_IN_LAST_SPAN",
+         in_width_last_chunk_valid_pixels_in_last_span},
+        {"MLO_CONV_BIAS", params.bias},
+        {"MLO_UT_READ_TYPE", UT_READ_TYPE},
+        {"MLO_UT_READ_UNIT", ut_read_unit},
+        {"MLO_UT_GRP_SZ0", UT_GRP_SZ0},
+    };
+    options << params.general_compile_options;
+    options.Canonicalize();
+    const auto comp_options = options.GenerateFor(kbp::OpenCL{});
 
     // wrt to W
     {
@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include "miopen/handle.hpp"
+#include "miopen/kernel_build_params.hpp"
 #include "miopen/legacy_exhaustive_search.hpp"
 #include "miopen/solver.hpp"
 
@@ -251,7 +252,8 @@ bool ConvOclDirectFwd::IsValidPerformanceConfig(
 }
 
 inline ConvSolution BaseGetSolution(const ConvolutionContext& params,
-                                    const LegacyPerformanceConfig& searched_params)
+                                    const LegacyPerformanceConfig& searched_params,
+                                    const KernelBuildParameters& extra_options)
 {
     ConvSolution result;
 
@@ -340,82 +342,55 @@ inline ConvSolution BaseGetSolution(const ConvolutionContext& params,
 
     KernelInfo kernel_params;
 
-    kernel_params.comp_options =
-        std::string(" -DMLO_HW_WAVE_SZ=") + std::to_string(static_cast<long long>(hw_wave_sz)) +
-        std::string(" -DMLO_DIR_FORWARD=") + (params.direction.IsForward() ? "1" : "0") +
-        std::string(" -DMLO_FILTER_SIZE0=") +
-        std::to_string(static_cast<long long>(params.kernel_size_w)) +
-        std::string(" -DMLO_FILTER_SIZE1=") +
-        std::to_string(static_cast<long long>(params.kernel_size_h)) +
-        std::string(" -DMLO_FILTER_PAD0=") + std::to_string(static_cast<long long>(pad_w)) +
-        std::string(" -DMLO_FILTER_PAD1=") + std::to_string(static_cast<long long>(pad_h)) +
-        std::string(" -DMLO_FILTER_STRIDE0=") +
-        std::to_string(static_cast<long long>(params.kernel_stride_w)) +
-        std::string(" -DMLO_FILTER_STRIDE1=") +
-        std::to_string(static_cast<long long>(params.kernel_stride_h)) +
-        std::string(" -DMLO_N_OUTPUTS=") +
-        std::to_string(static_cast<long long>(params.n_outputs)) + std::string(" -DMLO_N_INPUTS=") +
-        std::to_string(static_cast<long long>(params.n_inputs)) + std::string(" -DMLO_BATCH_SZ=") +
-        std::to_string(static_cast<long long>(params.batch_sz)) + std::string(" -DMLO_OUT_WIDTH=") +
-        std::to_string(static_cast<long long>(params.out_width)) +
-        std::string(" -DMLO_OUT_HEIGHT=") +
-        std::to_string(static_cast<long long>(params.out_height)) +
-        std::string(" -DMLO_OUT_BATCH_STRIDE=") +
-        std::to_string(static_cast<long long>(params.out_batch_stride)) +
-        std::string(" -DMLO_OUT_CHANNEL_STRIDE=") +
-        std::to_string(static_cast<long long>(params.out_channel_stride)) +
-        std::string(" -DMLO_OUT_STRIDE=") +
-        std::to_string(static_cast<long long>(params.out_stride)) +
-        std::string(" -DMLO_IN_WIDTH=") + std::to_string(static_cast<long long>(params.in_width)) +
-        std::string(" -DMLO_IN_HEIGHT=") +
-        std::to_string(static_cast<long long>(params.in_height)) +
-        std::string(" -DMLO_IN_BATCH_STRIDE=") +
-        std::to_string(static_cast<long long>(params.in_batch_stride)) +
-        std::string(" -DMLO_IN_CHANNEL_STRIDE=") +
-        std::to_string(static_cast<long long>(params.in_channel_stride)) +
-        std::string(" -DMLO_IN_STRIDE=") + std::to_string(static_cast<long long>(params.in_stride))
+    KernelBuildParameters options{
+        {"MLO_HW_WAVE_SZ", hw_wave_sz},
+        {"MLO_DIR_FORWARD", params.direction.IsForward() ? 1 : 0},
+        {"MLO_FILTER_SIZE0", params.kernel_size_w},
+        {"MLO_FILTER_SIZE1", params.kernel_size_h},
+        {"MLO_FILTER_PAD0", pad_w},
+        {"MLO_FILTER_PAD1", pad_h},
+        {"MLO_FILTER_STRIDE0", params.kernel_stride_w},
+        {"MLO_FILTER_STRIDE1", params.kernel_stride_h},
+        {"MLO_N_OUTPUTS", params.n_outputs},
+        {"MLO_N_INPUTS", params.n_inputs},
+        {"MLO_BATCH_SZ", params.batch_sz},
+        {"MLO_OUT_WIDTH", params.out_width},
+        {"MLO_OUT_HEIGHT", params.out_height},
+        {"MLO_OUT_BATCH_STRIDE", params.out_batch_stride},
+        {"MLO_OUT_CHANNEL_STRIDE", params.out_channel_stride},
+        {"MLO_OUT_STRIDE", params.out_stride},
+        {"MLO_IN_WIDTH", params.in_width},
+        {"MLO_IN_HEIGHT", params.in_height},
+        {"MLO_IN_BATCH_STRIDE", params.in_batch_stride},
+        {"MLO_IN_CHANNEL_STRIDE", params.in_channel_stride},
+        {"MLO_IN_STRIDE", params.in_stride},
         // algorithm parameters
-        + std::string(" -DMLO_IN_TILE0=") +
-        std::to_string(static_cast<long long>(result.in_tile0)) // size of input data per ALU plane
-        + std::string(" -DMLO_IN_TILE1=") +
-        std::to_string(static_cast<long long>(result.in_tile1)) // size of input data per ALU plane
-        + std::string(" -DMLO_GRP_TILE0=") +
-        std::to_string(static_cast<long long>(result.grp_tile0)) // # of ALUs (group size)
-        + std::string(" -DMLO_GRP_TILE1=") +
-        std::to_string(static_cast<long long>(result.grp_tile1)) //
-        + std::string(" -DMLO_OUT_TILE0=") +
-        std::to_string(
-            static_cast<long long>(result.out_pix_tile0)) // size of ouptput tile per wk-item (ALU))
-        + std::string(" -DMLO_OUT_TILE1=") +
-        std::to_string(static_cast<long long>(result.out_pix_tile1)) //
-        + std::string(" -DMLO_N_STACKS=") +
-        std::to_string(static_cast<long long>(result.n_stacks)) // # of diff stacks (part of batch).
-        + std::string(" -DMLO_N_OUT_TILES=") +
-        std::to_string(static_cast<long long>(
-            result.n_out_pix_tiles)) // # output pixel tiles per wk-item (ALU)
-        + std::string(" -DMLO_N_OUT_TILES_PERSTACK=") +
-        std::to_string(static_cast<long long>(n_out_tiles_perstack)) +
-        std::string(" -DMLO_N_IN_TILES_PERSTACK=") +
-        std::to_string(static_cast<long long>(
-            result.n_in_data_tiles)) // total # of blocks of different inputs in LDS
-        + std::string(" -DMLO_N_READ_PROCS=") +
-        std::to_string(static_cast<long long>(n_read_procs)) + std::string(" -DMLO_ALU_VTILE0=") +
-        std::to_string(static_cast<long long>(alu_tile0)) + std::string(" -DMLO_ALU_VTILE1=") +
-        std::to_string(static_cast<long long>(alu_tile1));
+        {"MLO_IN_TILE0", result.in_tile0},                   // size of input data per ALU plane
+        {"MLO_IN_TILE1", result.in_tile1},                   // size of input data per ALU plane
+        {"MLO_GRP_TILE0", result.grp_tile0},                 // # of ALUs (group size)
+        {"MLO_GRP_TILE1", result.grp_tile1},
+        {"MLO_OUT_TILE0", result.out_pix_tile0},             // output tile per wk-item (ALU)
+        {"MLO_OUT_TILE1", result.out_pix_tile1},
+        {"MLO_N_STACKS", result.n_stacks},                   // # of diff stacks (part of batch).
+        {"MLO_N_OUT_TILES", result.n_out_pix_tiles},         // output pixel tiles per wk-item
+        {"MLO_N_OUT_TILES_PERSTACK", n_out_tiles_perstack},
+        {"MLO_N_IN_TILES_PERSTACK", result.n_in_data_tiles}, // blocks of different inputs in LDS
+        {"MLO_N_READ_PROCS", n_read_procs},
+        {"MLO_ALU_VTILE0", alu_tile0},
+        {"MLO_ALU_VTILE1", alu_tile1},
+    };
     if(group_counts >= 2)
     {
-        kernel_params.comp_options += (std::string(" -DMLO_GROUP_COUNTS=") +
-                                       std::to_string(static_cast<long long>(group_counts)));
-        kernel_params.comp_options +=
-            (std::string(" -DMLO_GROUP_TILES=") +
-             std::to_string(static_cast<long long>(params.n_outputs / group_counts)));
-        kernel_params.comp_options +=
-            (std::string(" -DMLO_STACK_PERGROUP=") +
-             std::to_string(static_cast<long long>(
-                 (params.n_outputs / group_counts + n_out_tiles_perstack - 1) /
-                 n_out_tiles_perstack)));
-        kernel_params.comp_options += std::string(" -DGRP_MOD_ENABLE");
+        options.Define("MLO_GROUP_COUNTS", group_counts);
+        options.Define("MLO_GROUP_TILES", params.n_outputs / group_counts);
+        options.Define("MLO_STACK_PERGROUP",
+                       (params.n_outputs / group_counts + n_out_tiles_perstack - 1) /
+                           n_out_tiles_perstack);
+        options.Define("GRP_MOD_ENABLE");
     }
+    options << extra_options << params.general_compile_options;
+    options.Canonicalize();
+    kernel_params.comp_options = options.GenerateFor(kbp::OpenCL{});
 
     kernel_params.l_wk.push_back(result.grp_tile1 * result.grp_tile0);
     kernel_params.l_wk.push_back(1);
@@ -450,28 +425,14 @@ inline ConvSolution BaseGetSolution(const ConvolutionContext& params,
 ConvSolution ConvOclDirectFwd::GetSolution(const ConvolutionContext& params,
                                            const LegacyPerformanceConfig& searched_params) const
 {
-    ConvSolution result = BaseGetSolution(params, searched_params);
-
-    if(result.Succeeded())
-    {
-        result.construction_params[0].comp_options +=
-            std::string(" -DMLO_CONV_BIAS=") + std::to_string(static_cast<long long>(params.bias)) +
-            params.general_compile_options;
-    }
-
-    return result;
+    return BaseGetSolution(params, searched_params, {{"MLO_CONV_BIAS", params.bias}});
 }
 
 ConvSolution
 ConvOclDirectFwdFused::GetSolution(const ConvolutionContext& params,
                                    const LegacyPerformanceConfig& searched_params) const
 {
-    ConvSolution result = BaseGetSolution(params, searched_params);
-    if(result.Succeeded())
-    {
-        result.construction_params[0].comp_options += params.general_compile_options;
-    }
-    return result;
+    return BaseGetSolution(params, searched_params, {});
 }
 } // namespace solver
 } // namespace miopen
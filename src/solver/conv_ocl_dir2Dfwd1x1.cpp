@@ -25,6 +25,7 @@
  *******************************************************************************/
 
 #include "miopen/handle.hpp"
+#include "miopen/kernel_build_params.hpp"
 #include "miopen/legacy_exhaustive_search.hpp"
 #include "miopen/solver.hpp"
 
@@ -128,29 +129,30 @@ ConvSolution ConvOclDirectFwd1x1::GetSolution(const ConvolutionContext& params,
 
             KernelInfo kernel;
 
-            kernel.comp_options =
-                std::string(" -DMLO_N_LCL_IN_MAPS_ONCE=") + std::to_string(N_LCL_IN_MAPS_ONCE) +
-                std::string(" -DBATCHSIZE=") + std::to_string(BATCHSIZE) + std::string(" -DH=") +
-                std::to_string(H) + std::string(" -DW=") + std::to_string(W) +
-                std::string(" -DC=") + std::to_string(C) + std::string(" -DK=") +
-                std::to_string(K) + std::string(" -DMLO_N_LCL_IN_MAPS=") +
-                std::to_string(N_LCL_IN_MAPS) + std::string(" -DMLO_N_INPUTS=") +
-                std::to_string(C) + std::string(" -DMLO_N_OUTPUTS=") + std::to_string(K) +
-                std::string(" -DH_out=") + std::to_string(H_out) + std::string(" -DW_out=") +
-                std::to_string(W_out) + std::string(" -DMLO_N_IN_GROUPS=") +
-                std::to_string(N_IN_GROUPS) + std::string(" -DMLO_CLOOP0=") +
-                std::to_string(CLOOP0) + std::string(" -DMLO_CLOOP2=") + std::to_string(CLOOP2) +
-                std::string(" -DMLO_N_LCL_OUT_MAPS=") + std::to_string(N_LCL_OUT_MAPS) +
-                std::string(" -DMLO_CHEAT_SHADER_COMPILER=") +
-                std::to_string(CHEAT_SHADER_COMPILER) +
-                std::string(
-                    " -DMLopen_RUNNING=1") + // to disable macro defines for CodeXL Shader Analyzer
-                params.general_compile_options;
-
-            kernel.comp_options = std::string(" -DMLO_FILTER_STRIDE0=") +
-                                  std::to_string(params.kernel_stride_w) +
-                                  std::string(" -DMLO_FILTER_STRIDE1=") +
-                                  std::to_string(params.kernel_stride_h) + kernel.comp_options;
+            KernelBuildParameters options{
+                {"MLO_FILTER_STRIDE0", params.kernel_stride_w},
+                {"MLO_FILTER_STRIDE1", params.kernel_stride_h},
+                {"MLO_N_LCL_IN_MAPS_ONCE", N_LCL_IN_MAPS_ONCE},
+                {"BATCHSIZE", BATCHSIZE},
+                {"H", H},
+                {"W", W},
+                {"C", C},
+                {"K", K},
+                {"MLO_N_LCL_IN_MAPS", N_LCL_IN_MAPS},
+                {"MLO_N_INPUTS", C},
+                {"MLO_N_OUTPUTS", K},
+                {"H_out", H_out},
+                {"W_out", W_out},
+                {"MLO_N_IN_GROUPS", N_IN_GROUPS},
+                {"MLO_CLOOP0", CLOOP0},
+                {"MLO_CLOOP2", CLOOP2},
+                {"MLO_N_LCL_OUT_MAPS", N_LCL_OUT_MAPS},
+                {"MLO_CHEAT_SHADER_COMPILER", CHEAT_SHADER_COMPILER},
+                {"MLopen_RUNNING", 1}, // to disable macro defines for CodeXL Shader Analyzer
+            };
+            options << params.general_compile_options;
+            options.Canonicalize();
+            kernel.comp_options = options.GenerateFor(kbp::OpenCL{});
 
             // std::cout << "compile options:\n"<< _comp_options << std::endl;
 
@@ -289,54 +291,47 @@ ConvSolution ConvOclDirectFwd1x1::GetSolution(const ConvolutionContext& params,
 
             KernelInfo kernel;
 
-            kernel.comp_options =
-                std::string(" -DMLO_DIR_FORWARD=") + (is_forward ? "1" : "0") +
-                std::string(" -DMLO_FILTER_SIZE0=") + std::to_string(params.kernel_size_w) +
-                std::string(" -DMLO_FILTER_SIZE1=") + std::to_string(params.kernel_size_h) +
-                std::string(" -DMLO_FILTER_STRIDE0=") + std::to_string(params.kernel_stride_w) +
-                std::string(" -DMLO_FILTER_STRIDE1=") + std::to_string(params.kernel_stride_h) +
-                std::string(" -DMLO_FILTER_PAD0=") + std::to_string(params.pad_w) +
-                std::string(" -DMLO_FILTER_PAD1=") + std::to_string(params.pad_h) +
-                std::string(" -DMLO_IN_WIDTH=") + std::to_string(params.in_width) +
-                std::string(" -DMLO_IN_HEIGHT=") + std::to_string(params.in_height) +
-                std::string(" -DMLO_OUT_WIDTH=") + std::to_string(params.out_width) +
-                std::string(" -DMLO_OUT_HEIGHT=") + std::to_string(params.out_height) +
-                std::string(" -DMLO_N_OUTPUTS=") + std::to_string(params.n_outputs) +
-                std::string(" -DMLO_N_INPUTS=") + std::to_string(params.n_inputs) +
-                std::string(" -DMLO_BATCH_SZ=") + std::to_string(params.batch_sz) +
-                std::string(" -DMLO_OUT_BATCH_STRIDE=") + std::to_string(params.out_batch_stride) +
-                std::string(" -DMLO_OUT_CHANNEL_STRIDE=") +
-                std::to_string(params.out_channel_stride) + std::string(" -DMLO_OUT_STRIDE=") +
-                std::to_string(params.out_stride) + std::string(" -DMLO_IN_BATCH_STRIDE=") +
-                std::to_string(params.in_batch_stride) + std::string(" -DMLO_IN_CHANNEL_STRIDE=") +
-                std::to_string(params.in_channel_stride) + std::string(" -DMLO_IN_STRIDE=") +
-                std::to_string(params.in_stride) + std::string(" -DMLO_WEI_BSTRIDE=") +
-                std::to_string(wei_bstride) + std::string(" -DMLO_WEI_CHANNEL_STRIDE=") +
-                std::to_string(wei_cstride) +
+            KernelBuildParameters options{
+                {"MLO_DIR_FORWARD", is_forward ? 1 : 0},
+                {"MLO_FILTER_SIZE0", params.kernel_size_w},
+                {"MLO_FILTER_SIZE1", params.kernel_size_h},
+                {"MLO_FILTER_STRIDE0", params.kernel_stride_w},
+                {"MLO_FILTER_STRIDE1", params.kernel_stride_h},
+                {"MLO_FILTER_PAD0", params.pad_w},
+                {"MLO_FILTER_PAD1", params.pad_h},
+                {"MLO_IN_WIDTH", params.in_width},
+                {"MLO_IN_HEIGHT", params.in_height},
+                {"MLO_OUT_WIDTH", params.out_width},
+                {"MLO_OUT_HEIGHT", params.out_height},
+                {"MLO_N_OUTPUTS", params.n_outputs},
+                {"MLO_N_INPUTS", params.n_inputs},
+                {"MLO_BATCH_SZ", params.batch_sz},
+                {"MLO_OUT_BATCH_STRIDE", params.out_batch_stride},
+                {"MLO_OUT_CHANNEL_STRIDE", params.out_channel_stride},
+                {"MLO_OUT_STRIDE", params.out_stride},
+                {"MLO_IN_BATCH_STRIDE", params.in_batch_stride},
+                {"MLO_IN_CHANNEL_STRIDE", params.in_channel_stride},
+                {"MLO_IN_STRIDE", params.in_stride},
+                {"MLO_WEI_BSTRIDE", wei_bstride},
+                {"MLO_WEI_CHANNEL_STRIDE", wei_cstride},
                 // algorithm parameters
-                std::string(" -DMLO_GRP_SZ0=") + std::to_string(GRP_SZ) +
-                std::string(" -DMLO_GRP_SZ1=") + std::to_string(1) +
-                std::string(" -DMLO_GRP_SZ2=") + std::to_string(1) +
-
-                std::string(" -DMLO_MAP_SZ4=") + std::to_string(MAP_SZ4) +
-                std::string(" -DMLO_OUT_WIDTH4=") + std::to_string(OUT_WIDTH4) +
-                std::string(" -DMLO_VERT_ALIGNED=") + std::to_string(VERT_ALIGNED) +
-                std::string(" -DMLO_HORIZ_ALIGNED=") + std::to_string(HORIZ_ALIGNED) +
-
-                std::string(" -DMLO_N_LCL_BATCHS=") +
-                std::to_string(result.n_stacks) + // # of diff stacks (part of batch).
-                std::string(" -DMLO_N_LCL_OUT_MAPS=") +
-                std::to_string(result.n_out_pix_tiles) + // # output pixel tiles per wk-item (ALU)
-                std::string(" -DMLO_N_LCL_IN_MAPS=") +
-                std::to_string(
-                    result.n_in_data_tiles) + // total # of blocks of different inputs in LDS
-                std::string(" -DMLO_CONV_BIAS=") +
-                std::to_string(params.bias) +
-
-                std::string(" -DMLO_READ_UNIT=") + std::to_string(read_unit) +
-                std::string(" -DMLO_CLOOP0=") + std::to_string(CLOOP0) +
-
-                params.general_compile_options;
+                {"MLO_GRP_SZ0", GRP_SZ},
+                {"MLO_GRP_SZ1", 1},
+                {"MLO_GRP_SZ2", 1},
+                {"MLO_MAP_SZ4", MAP_SZ4},
+                {"MLO_OUT_WIDTH4", OUT_WIDTH4},
+                {"MLO_VERT_ALIGNED", VERT_ALIGNED},
+                {"MLO_HORIZ_ALIGNED", HORIZ_ALIGNED},
+                {"MLO_N_LCL_BATCHS", result.n_stacks},          // # of diff stacks (part of batch).
+                {"MLO_N_LCL_OUT_MAPS", result.n_out_pix_tiles}, // # output pixel tiles per wk-item
+                {"MLO_N_LCL_IN_MAPS", result.n_in_data_tiles},  // # of blocks of inputs in LDS
+                {"MLO_CONV_BIAS", params.bias},
+                {"MLO_READ_UNIT", read_unit},
+                {"MLO_CLOOP0", CLOOP0},
+            };
+            options << params.general_compile_options;
+            options.Canonicalize();
+            kernel.comp_options = options.GenerateFor(kbp::OpenCL{});
 
             kernel.l_wk.push_back(result.grp_tile0);
             kernel.l_wk.push_back(1);
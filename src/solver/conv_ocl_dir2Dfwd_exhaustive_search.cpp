@@ -161,7 +161,8 @@ static int MeasurePerfConfig(Handle* profile_h,
 
     MIOPEN_LOG_I2("Trying " << result);
     const auto kernel_params     = kernel_search_result.construction_params[0];
-    std::string compiler_options = params.general_compile_options + kernel_params.comp_options;
+    // The solvers add general_compile_options to their own.
+    const auto& compiler_options = kernel_params.comp_options;
 
     // Creating OCLKernel obj
     try
@@ -262,7 +263,7 @@ ConvOclDirectFwdLegacyExhaustiveSearch::SearchImpl(const ConvolutionContext& par
     LegacyPerformanceConfig result;
     bool is_passed = false;
 
-    miopen::Handle profile_h;
+    auto profile_h         = params.GetStream().CreateSibling();
     double processing_time = std::numeric_limits<double>::max();
 
     LegacyPerformanceConfig candidate;
@@ -26,6 +26,7 @@
 
 #include "miopen/solver.hpp"
 #include "miopen/handle.hpp"
+#include "miopen/kernel_build_params.hpp"
 
 namespace miopen {
 namespace solver {
@@ -173,90 +174,59 @@ ConvSolution ConvOclDirectFwdGen::GetSolution(const ConvolutionContext& params)
     int bias = params.bias;
     KernelInfo construction_params;
 
-    construction_params.comp_options =
-        std::string("-DMLO_GRP_SZ=") +
-        std::to_string(static_cast<long long>(ocl_group_sz0) * ocl_group_sz1 * ocl_group_sz2) +
-        std::string(" -DMLO_GRP_SZ0=") + std::to_string(static_cast<long long>(ocl_group_sz0)) +
-        std::string(" -DMLO_GRP_SZ1=") + std::to_string(static_cast<long long>(ocl_group_sz1)) +
-        std::string(" -DMLO_GRP_SZ2=") + std::to_string(static_cast<long long>(ocl_group_sz2)) +
-        std::string(" -DMLO_LCL_N_IN_CHNLS=") + std::to_string(static_cast<long long>(n_ins)) +
-        std::string(" -DMLO_LCL_N_OUT_CHNLS=") + std::to_string(static_cast<long long>(n_outs)) +
-        std::string(" -DMLO_OUT_STACKS=") + std::to_string(static_cast<long long>(n_out_stacks)) +
-        std::string(" -DMLO_IN_STACKS=") + std::to_string(static_cast<long long>(n_in_stacks)) +
-        std::string(" -DMLO_BATCH_SZ=") + std::to_string(static_cast<long long>(params.batch_sz)) +
-        std::string(" -DMLO_FLTR_SZ0=") +
-        std::to_string(static_cast<long long>(params.kernel_size_w)) +
-        std::string(" -DMLO_FLTR_PAD_SZ0=") + std::to_string(static_cast<long long>(params.pad_w)) +
-        std::string(" -DMLO_FLTR_STRIDE0=") +
-        std::to_string(static_cast<long long>(params.kernel_stride_w)) +
-        std::string(" -DMLO_FLTR_SZ1=") +
-        std::to_string(static_cast<long long>(params.kernel_size_h)) +
-        std::string(" -DMLO_FLTR_PAD_SZ1=") + std::to_string(static_cast<long long>(params.pad_h)) +
-        std::string(" -DMLO_FLTR_STRIDE1=") +
-        std::to_string(static_cast<long long>(params.kernel_stride_h)) +
-        std::string(" -DMLO_N_OUT_CHNLS=") +
-        std::to_string(static_cast<long long>(params.n_outputs)) // total number of output channels
-        + std::string(" -DMLO_OUT_WIDTH=") +
-        std::to_string(static_cast<long long>(params.out_width)) +
-        std::string(" -DMLO_OUT_HEIGHT=") +
-        std::to_string(static_cast<long long>(params.out_height)) +
-        std::string(" -DMLO_OUT_STRIDE=") +
-        std::to_string(static_cast<long long>(params.out_stride)) +
-        std::string(" -DMLO_OUT_CHNL_STRIDE=") +
-        std::to_string(static_cast<long long>(params.out_channel_stride)) +
-        std::string(" -DMLO_OUT_BATCH_STRIDE=") +
-        std::to_string(static_cast<long long>(params.out_batch_stride)) +
-        std::string(" -DMLO_N_OUT_PIX_SZ0=") +
-        std::to_string(static_cast<long long>(n_out_pix_horiz)) +
-        std::string(" -DMLO_N_OUT_PIX_SZ1=") +
-        std::to_string(static_cast<long long>(n_out_pix_vert)) + std::string(" -DMLO_N_IN_CHNLS=") +
-        std::to_string(static_cast<long long>(params.n_inputs)) + std::string(" -DMLO_IN_WIDTH=") +
-        std::to_string(static_cast<long long>(params.in_width)) + std::string(" -DMLO_IN_HEIGHT=") +
-        std::to_string(static_cast<long long>(params.in_height)) +
-        std::string(" -DMLO_IN_STRIDE=") +
-        std::to_string(static_cast<long long>(params.in_stride)) +
-        std::string(" -DMLO_IN_CHNL_STRIDE=") +
-        std::to_string(static_cast<long long>(params.in_channel_stride)) +
-        std::string(" -DMLO_IN_BATCH_STRIDE=") +
-        std::to_string(static_cast<long long>(params.in_batch_stride)) +
-        std::string(" -DMLO_N_IN_PIX_SZ0=") +
-        std::to_string(
-            static_cast<long long>(n_in_pix_horiz)) // size of output processing group in 0 dim
-        + std::string(" -DMLO_N_IN_PIX_SZ1=") +
-        std::to_string(
-            static_cast<long long>(n_in_pix_vert)) // size of output processing group in 1 dim
-        + std::string(" -DMLO_WEI_SZ=") +
-        std::to_string(static_cast<long long>(params.n_outputs) * params.n_inputs *
-                       params.kernel_size_w * params.kernel_size_h) +
-        std::string(" -DMLO_WEIGHTS_STRIDE=") +
-        std::to_string(static_cast<long long>(params.n_inputs) * params.kernel_size_w *
-                       params.kernel_size_h) //	weights stride
-        + std::string(" -DMLO_N_STACKS=") +
-        std::to_string(static_cast<long long>(n_stack_blocks)) // n of separate data stacks
-        + std::string(" -DMLO_N_PROCS0=") +
-        std::to_string(static_cast<long long>(n_procs0)) // n of processors per stack
-        + std::string(" -DMLO_N_PROCS1=") +
-        std::to_string(static_cast<long long>(n_procs1)) // n of processors per stack
-        + std::string(" -DMLO_ALIGNED=") +
-        std::to_string(static_cast<long long>(aligned_out)) //	dimesions aligned
-        + std::string(" -DMLO_BATCH_ALIGNED=") +
-        std::to_string(static_cast<long long>(batch_aligned)) // batch is multiple of n_ins
-        + std::string(" -DMLO_OUT_ALINED=") +
-        std::to_string(static_cast<long long>(out_aligned)) // outputs is multiple of n_outs
-        + std::string(" -DMLO_IN_SZ0=") +
-        std::to_string(static_cast<long long>(in_sz0)) // horizontal read dim 0
-        + std::string(" -DMLO_IN_SZ1=") +
-        std::to_string(static_cast<long long>(in_sz1)) // vertical read dim 1
-        + std::string(" -DMLO_LG2N_PROC_TILES=") +
-        std::to_string(static_cast<long long>(lg2n_proc_supertiles)) +
-        std::string(" -DMLO_LG2N_PROC_TILE1=") +
-        std::to_string(static_cast<long long>(lg2n_proc_supertile1)) + std::string(" -DMLO_BIG=") +
-        std::to_string(static_cast<long long>(big)) //	resolution > 32 x 32
-        + std::string(" -DMLO_CONV_BIAS=") + std::to_string(static_cast<long long>(bias))
-
-        //		+ std::string(" -limit-vector-registers=64 ")
-
-        + params.general_compile_options;
+    KernelBuildParameters options{
+        {"MLO_GRP_SZ", static_cast<long long>(ocl_group_sz0) * ocl_group_sz1 * ocl_group_sz2},
+        {"MLO_GRP_SZ0", ocl_group_sz0},
+        {"MLO_GRP_SZ1", ocl_group_sz1},
+        {"MLO_GRP_SZ2", ocl_group_sz2},
+        {"MLO_LCL_N_IN_CHNLS", n_ins},
+        {"MLO_LCL_N_OUT_CHNLS", n_outs},
+        {"MLO_OUT_STACKS", n_out_stacks},
+        {"MLO_IN_STACKS", n_in_stacks},
+        {"MLO_BATCH_SZ", params.batch_sz},
+        {"MLO_FLTR_SZ0", params.kernel_size_w},
+        {"MLO_FLTR_PAD_SZ0", params.pad_w},
+        {"MLO_FLTR_STRIDE0", params.kernel_stride_w},
+        {"MLO_FLTR_SZ1", params.kernel_size_h},
+        {"MLO_FLTR_PAD_SZ1", params.pad_h},
+        {"MLO_FLTR_STRIDE1", params.kernel_stride_h},
+        {"MLO_N_OUT_CHNLS", params.n_outputs}, // total number of output channels
+        {"MLO_OUT_WIDTH", params.out_width},
+        {"MLO_OUT_HEIGHT", params.out_height},
+        {"MLO_OUT_STRIDE", params.out_stride},
+        {"MLO_OUT_CHNL_STRIDE", params.out_channel_stride},
+        {"MLO_OUT_BATCH_STRIDE", params.out_batch_stride},
+        {"MLO_N_OUT_PIX_SZ0", n_out_pix_horiz},
+        {"MLO_N_OUT_PIX_SZ1", n_out_pix_vert},
+        {"MLO_N_IN_CHNLS", params.n_inputs},
+        {"MLO_IN_WIDTH", params.in_width},
+        {"MLO_IN_HEIGHT", params.in_height},
+        {"MLO_IN_STRIDE", params.in_stride},
+        {"MLO_IN_CHNL_STRIDE", params.in_channel_stride},
+        {"MLO_IN_BATCH_STRIDE", params.in_batch_stride},
+        {"MLO_N_IN_PIX_SZ0", n_in_pix_horiz}, // size of output processing group in 0 dim
+        {"MLO_N_IN_PIX_SZ1", n_in_pix_vert},  // size of output processing group in 1 dim
+        {"MLO_WEI_SZ",
+         static_cast<long long>(params.n_outputs) * params.n_inputs * params.kernel_size_w *
+             params.kernel_size_h},
+        {"MLO_WEIGHTS_STRIDE",
+         static_cast<long long>(params.n_inputs) * params.kernel_size_w * params.kernel_size_h},
+        {"MLO_N_STACKS", n_stack_blocks},     // n of separate data stacks
+        {"MLO_N_PROCS0", n_procs0},           // n of processors per stack
+        {"MLO_N_PROCS1", n_procs1},           // n of processors per stack
+        {"MLO_ALIGNED", aligned_out},         // dimesions aligned
+        {"MLO_BATCH_ALIGNED", batch_aligned}, // batch is multiple of n_ins
+        {"MLO_OUT_ALINED", out_aligned},      // outputs is multiple of n_outs
+        {"MLO_IN_SZ0", in_sz0},               // horizontal read dim 0
+        {"MLO_IN_SZ1", in_sz1},               // vertical read dim 1
+        {"MLO_LG2N_PROC_TILES", lg2n_proc_supertiles},
+        {"MLO_LG2N_PROC_TILE1", lg2n_proc_supertile1},
+        {"MLO_BIG", big}, // resolution > 32 x 32
+        {"MLO_CONV_BIAS", bias},
+    };
+    options << params.general_compile_options;
+    options.Canonicalize();
+    construction_params.comp_options = options.GenerateFor(kbp::OpenCL{});
 
     construction_params.kernel_file = "MIOpenConvDirGenFwd.cl";
     construction_params.kernel_name = (n_proc_supertiles == 1) ? "MIOpenCDFGen" : "MIOpenCDFGen4";
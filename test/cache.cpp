@@ -25,9 +25,15 @@
  *******************************************************************************/
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/kernel_cache.hpp>
 #include <miopen/md5.hpp>
 #include "test.hpp"
 
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
 void check_cache_file()
 {
     auto p = miopen::GetCacheFile("gfx", "base", "args", false);
@@ -41,8 +47,64 @@ void check_cache_str()
     CHECK(p.filename().string() == name + ".o");
 }
 
+void check_kernel_cache_concurrent_readers()
+{
+    miopen::KernelCache cache;
+    const std::size_t readers = 8;
+    const std::size_t configs = 16;
+    const std::size_t writes  = 10000;
+    const auto config         = [](std::size_t i) { return "config" + std::to_string(i); };
+
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> lookups{0};
+    std::atomic<std::size_t> failures{0};
+
+    std::vector<std::thread> threads;
+    for(std::size_t r = 0; r < readers; ++r)
+    {
+        threads.emplace_back([&, r]() {
+            // Sets of kernels once returned shall not change under the reader.
+            std::vector<std::pair<miopen::KernelCache::KernelsPtr, std::size_t>> held;
+            for(std::size_t n = 0; !done || n < configs; ++n)
+            {
+                const auto kernels = cache.GetKernels("algo", config((n + r) % configs));
+                if(kernels == nullptr || kernels->size() > 3)
+                    ++failures;
+                else if(n % 64 == 0)
+                    held.emplace_back(kernels, kernels->size());
+                cache.HasKernels("algo", config(n % configs));
+                ++lookups;
+            }
+            for(const auto& h : held)
+                if(h.first->size() != h.second)
+                    ++failures;
+        });
+    }
+
+    for(std::size_t w = 0; w < writes; ++w)
+    {
+        const auto key = config(w % configs);
+        cache.ClearKernels("algo", key);
+        for(std::size_t i = 0; i < 1 + w % 3; ++i)
+            cache.AddKernel({"algo", key}, miopen::Kernel{}, i);
+    }
+    done = true;
+
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT(failures == 0);
+    EXPECT(lookups >= readers * configs);
+    for(std::size_t i = 0; i < configs; ++i)
+    {
+        const auto expected = 1 + (writes - configs + i) % 3;
+        EXPECT(cache.GetKernels("algo", config(i))->size() == expected);
+    }
+}
+
 int main()
 {
     check_cache_file();
     check_cache_str();
+    check_kernel_cache_concurrent_readers();
 }
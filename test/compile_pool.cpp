@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/compile_pool.hpp>
+#include "test.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+static void check_results(miopen::CompilePool& pool)
+{
+    std::vector<std::shared_future<int>> results;
+    for(auto i = 0; i < 100; ++i)
+        results.push_back(pool.Submit([i]() { return i * i; }));
+    for(auto i = 0; i < 100; ++i)
+        EXPECT_EQUAL(results[i].get(), i * i);
+}
+
+static void check_exception(miopen::CompilePool& pool)
+{
+    auto result = pool.Submit([]() -> int { throw std::runtime_error("build failed"); });
+    auto thrown = false;
+    try
+    {
+        result.get();
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    EXPECT(thrown);
+}
+
+static void check_inline()
+{
+    miopen::CompilePool pool(1);
+    EXPECT_EQUAL(pool.Size(), 1u);
+    const auto caller = std::this_thread::get_id();
+    auto result       = pool.Submit([]() { return std::this_thread::get_id(); });
+    EXPECT(result.get() == caller);
+    check_results(pool);
+    check_exception(pool);
+}
+
+static void check_parallel()
+{
+    const std::size_t threads = 4;
+    miopen::CompilePool pool(threads);
+    EXPECT_EQUAL(pool.Size(), threads);
+    check_results(pool);
+    check_exception(pool);
+
+    // All the threads are busy at the same time.
+    std::atomic<std::size_t> running{0};
+    std::atomic<std::size_t> max_running{0};
+    std::vector<std::shared_future<void>> results;
+    for(std::size_t i = 0; i < threads; ++i)
+    {
+        results.push_back(pool.Submit([&]() {
+            const auto now = ++running;
+            auto max       = max_running.load();
+            while(now > max && !max_running.compare_exchange_weak(max, now))
+            {
+            }
+            const auto start = std::chrono::steady_clock::now();
+            while(max_running < threads &&
+                  std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+                std::this_thread::yield();
+            --running;
+        }));
+    }
+    for(const auto& result : results)
+        result.wait();
+    EXPECT_EQUAL(max_running.load(), threads);
+}
+
+int main()
+{
+    check_inline();
+    check_parallel();
+}
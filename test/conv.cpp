@@ -66,7 +66,7 @@ static bool is_direct_fwd_bwd_data_supported(miopen::Handle& handle,
         construct.setDoSearch(false);
         construct.saveSearchRequest(false);
         construct.setWorkaroundDisableSearchEnforce(true);
-        construct.setGeneralCompOptions("");
+        construct.setGeneralCompOptions({});
         construct.setStream(&handle);
         if(FindAllSolutions(construct).empty())
             return false;
@@ -87,7 +87,7 @@ static bool is_direct_bwd_wrw_supported(miopen::Handle& handle,
     construct_params.setDoSearch(false);
     construct_params.saveSearchRequest(false);
     construct_params.setWorkaroundDisableSearchEnforce(true);
-    construct_params.setGeneralCompOptions("");
+    construct_params.setGeneralCompOptions({});
     construct_params.setStream(&handle);
 
     return !FindAllSolutions(construct_params).empty();
@@ -0,0 +1,110 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/conv_warmup.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/problem_description.hpp>
+#include <miopen/temp_file.hpp>
+#include "test.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+static std::string RoundTrip(const std::string& key)
+{
+    const auto problem = miopen::ConvolutionProblem::Parse(key);
+    const auto forward = problem.direction.IsForward() ? 1 : 0;
+    miopen::ProblemDescription desc(problem.x, problem.w, problem.y, problem.conv, forward);
+    if(problem.direction.IsBackwardWrW())
+        desc.direction.SetBackwardWrW();
+
+    std::ostringstream ss;
+    desc.Serialize(ss);
+    return ss.str();
+}
+
+static bool Throws(const std::string& key)
+{
+    try
+    {
+        miopen::ConvolutionProblem::Parse(key);
+    }
+    catch(const miopen::Exception&)
+    {
+        return true;
+    }
+    return false;
+}
+
+static void check_parse()
+{
+    const std::string keys[] = {
+        "576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F",
+        "64-56-56-3x3-128-28-28-16-1x1-2x2-1x1-0-NCHW-FP16-B",
+        "32-14-14-5x5-32-14-14-4-2x2-1x1-1x1-0-NCHW-FP32-W_g4",
+        "16-7-9-3x1-8-5-9-2-0x0-1x1-1x1-0-NCHW-INT8x4INT8x4INT32-F",
+    };
+
+    for(const auto& key : keys)
+        EXPECT_EQUAL(RoundTrip(key), key);
+}
+
+static void check_malformed()
+{
+    EXPECT(Throws(""));
+    EXPECT(Throws("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32"));
+    EXPECT(Throws("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-X"));
+    EXPECT(Throws("576-4-4-1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F"));
+    EXPECT(Throws("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP64-F"));
+    EXPECT(Throws("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NHWC-FP32-F"));
+    EXPECT(Throws("576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F_g5"));
+}
+
+static void check_read()
+{
+    miopen::TempFile file("miopen.test.conv_warmup");
+    {
+        std::ofstream out(file.Path());
+        out << "# comment\n"
+            << "\n"
+            << "576-4-4-1x1-192-4-4-8-1x1-2x2-3x3-0-NCHW-FP32-F=ConvOclDirectFwd1x1:1,16,1,64\n"
+            << "32-14-14-5x5-32-14-14-4-2x2-1x1-1x1-0-NCHW-FP32-W_g4\n";
+    }
+
+    const auto problems = miopen::ReadConvolutionProblems(file.Path());
+    EXPECT_EQUAL(problems.size(), 2u);
+    EXPECT(problems[0].direction.IsForward());
+    EXPECT(problems[1].direction.IsBackwardWrW());
+    EXPECT_EQUAL(problems[1].conv.group_count, 4);
+}
+
+int main()
+{
+    check_parse();
+    check_malformed();
+    check_read();
+}
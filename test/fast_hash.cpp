@@ -0,0 +1,170 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/fast_hash.hpp>
+#include <miopen/md5.hpp>
+#include "test.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+static void check_reference()
+{
+    const auto all_bytes = [] {
+        std::string s;
+        for(auto i = 0; i < 1024; ++i)
+            s += static_cast<char>(i % 256);
+        return s;
+    }();
+
+    // Values of the reference XXH64 implementation.
+    EXPECT_EQUAL(miopen::FastHash64(""), 0xEF46DB3751D8E999ull);
+    EXPECT_EQUAL(miopen::FastHash64("a"), 0xD24EC4F1A98C6E5Bull);
+    EXPECT_EQUAL(miopen::FastHash64("abc"), 0x44BC2CF5AD770999ull);
+    EXPECT_EQUAL(miopen::FastHash64("Nobody inspects the spammish repetition"),
+                 0xFBCEA83C8A378BF1ull);
+    EXPECT_EQUAL(miopen::FastHash64(all_bytes), 0x6F3914F18FE4DF57ull);
+    EXPECT_EQUAL(miopen::FastHash64(std::string("abc"), 0x27D4EB2F165667C5ull),
+                 0x96A5E06F5BA066EAull);
+
+    EXPECT_EQUAL(miopen::FastHashHex("abc"), "44bc2cf5ad77099996a5e06f5ba066ea");
+}
+
+/// Builds options the way ConvOclDirectFwd does for the given problem.
+static std::string DirectFwdOptions(int n_inputs, int n_outputs, int size, int filter, int batch)
+{
+    const std::vector<std::pair<std::string, int>> defines = {
+        {"MLO_HW_WAVE_SZ", 64},
+        {"MLO_DIR_FORWARD", 1},
+        {"MLO_FILTER_SIZE0", filter},
+        {"MLO_FILTER_SIZE1", filter},
+        {"MLO_FILTER_PAD0", filter / 2},
+        {"MLO_FILTER_PAD1", filter / 2},
+        {"MLO_FILTER_STRIDE0", 1},
+        {"MLO_FILTER_STRIDE1", 1},
+        {"MLO_N_OUTPUTS", n_outputs},
+        {"MLO_N_INPUTS", n_inputs},
+        {"MLO_BATCH_SZ", batch},
+        {"MLO_OUT_WIDTH", size},
+        {"MLO_OUT_HEIGHT", size},
+        {"MLO_OUT_BATCH_STRIDE", n_outputs * size * size},
+        {"MLO_OUT_CHANNEL_STRIDE", size * size},
+        {"MLO_OUT_STRIDE", size},
+        {"MLO_IN_WIDTH", size},
+        {"MLO_IN_HEIGHT", size},
+        {"MLO_IN_BATCH_STRIDE", n_inputs * size * size},
+        {"MLO_IN_CHANNEL_STRIDE", size * size},
+        {"MLO_IN_STRIDE", size},
+        {"MLO_IN_TILE0", 16},
+        {"MLO_IN_TILE1", 16},
+        {"MLO_GRP_TILE0", 16},
+        {"MLO_GRP_TILE1", 16},
+        {"MLO_OUT_TILE0", 2},
+        {"MLO_OUT_TILE1", 2},
+        {"MLO_N_STACKS", 1},
+        {"MLO_N_OUT_TILES", 8},
+        {"MLO_N_OUT_TILES_PERSTACK", 8},
+        {"MLO_N_IN_TILES_PERSTACK", 2},
+        {"MLO_N_READ_PROCS", 256},
+        {"MLO_CONV_BIAS", 0},
+        {"MLO_ALU_VTILE0", 8},
+        {"MLO_ALU_VTILE1", 8},
+        {"MIOPEN_USE_FP32", 1},
+        {"MIOPEN_USE_FP16", 0},
+    };
+
+    std::string options;
+    for(const auto& define : defines)
+        options += " -D" + define.first + "=" + std::to_string(define.second);
+    return options;
+}
+
+static std::vector<std::string> SolverOptions()
+{
+    std::vector<std::string> options;
+    for(auto channels : {3, 64, 256, 1024})
+        for(auto size : {7, 28, 224})
+            for(auto filter : {1, 3, 5})
+                options.push_back(DirectFwdOptions(channels, channels * 2, size, filter, 32));
+    return options;
+}
+
+static void check_distinct()
+{
+    const auto options = SolverOptions();
+    std::set<std::uint64_t> hashes;
+    std::set<std::string> hex;
+    for(const auto& o : options)
+    {
+        hashes.insert(miopen::FastHash64(o));
+        hex.insert(miopen::FastHashHex(o));
+    }
+    EXPECT_EQUAL(hashes.size(), options.size());
+    EXPECT_EQUAL(hex.size(), options.size());
+}
+
+template <class F>
+static double MeasureNsPerKey(const std::vector<std::string>& keys, F f)
+{
+    const auto repeats = 200;
+    std::size_t sink   = 0;
+    const auto start   = std::chrono::steady_clock::now();
+    for(auto i = 0; i < repeats; ++i)
+        for(const auto& key : keys)
+            sink += f(key).size();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    CHECK(sink != 0);
+    return std::chrono::duration<double, std::nano>(elapsed).count() / (repeats * keys.size());
+}
+
+/// Compares the cost of cache KEY computation on options made by the solvers.
+static void benchmark_keys()
+{
+    const auto options = SolverOptions();
+    std::size_t total  = 0;
+    for(const auto& o : options)
+        total += o.size();
+
+    const auto md5  = MeasureNsPerKey(options, [](const std::string& s) { return miopen::md5(s); });
+    const auto fast = MeasureNsPerKey(options, miopen::FastHashHex);
+
+    std::cout << "Options: " << options.size() << " strings, " << total / options.size()
+              << " bytes on average" << std::endl;
+    std::cout << "md5:         " << md5 << " ns per key" << std::endl;
+    std::cout << "FastHashHex: " << fast << " ns per key" << std::endl;
+}
+
+int main()
+{
+    check_reference();
+    check_distinct();
+    benchmark_keys();
+}
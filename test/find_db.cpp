@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/convolution.hpp>
+#include <miopen/float_equal.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/tensor.hpp>
+#include <miopen/tmp_dir.hpp>
+#include "test.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+struct Problem
+{
+    miopen::TensorDescriptor x{miopenFloat, {1, 8, 16, 16}};
+    miopen::TensorDescriptor w{miopenFloat, {8, 8, 3, 3}};
+    miopen::ConvolutionDescriptor conv{{1, 1}};
+    miopen::TensorDescriptor y = conv.GetForwardOutputTensor(x, w);
+};
+
+/// Runs Find on a handle of its own, as another process would, and runs the algorithms found.
+static std::vector<miopenConvAlgoPerf_t> FindAndRun(const Problem& p)
+{
+    miopen::Handle handle;
+    const auto x = handle.Write(std::vector<float>(p.x.GetElementSize(), 1.0f));
+    const auto w = handle.Write(std::vector<float>(p.w.GetElementSize(), 1.0f));
+    const auto y = handle.Write(std::vector<float>(p.y.GetElementSize(), 0.0f));
+    const auto workspace_size = p.conv.ForwardGetWorkSpaceSize(handle, p.w, p.x, p.y);
+    const auto workspace =
+        handle.Write(std::vector<char>(std::max<std::size_t>(workspace_size, 1)));
+
+    std::vector<miopenConvAlgoPerf_t> perf(4);
+    int count = 0;
+    p.conv.FindConvFwdAlgorithm(handle,
+                                p.x,
+                                x.get(),
+                                p.w,
+                                w.get(),
+                                p.y,
+                                y.get(),
+                                perf.size(),
+                                &count,
+                                perf.data(),
+                                workspace.get(),
+                                workspace_size,
+                                false);
+    perf.resize(count);
+    EXPECT(!perf.empty());
+
+    const float alpha = 1.0f;
+    const float beta  = 0.0f;
+    for(const auto& algo : perf)
+    {
+        p.conv.ConvolutionForward(handle,
+                                  &alpha,
+                                  p.x,
+                                  x.get(),
+                                  p.w,
+                                  w.get(),
+                                  algo.fwd_algo,
+                                  &beta,
+                                  p.y,
+                                  y.get(),
+                                  workspace.get(),
+                                  workspace_size);
+    }
+    return perf;
+}
+
+int main()
+{
+    const miopen::TmpDir find_db_dir("find_db");
+    setenv("MIOPEN_FIND_DB_PATH", find_db_dir.path.string().c_str(), 1);
+
+    const Problem problem;
+    const auto first  = FindAndRun(problem);
+    const auto second = FindAndRun(problem);
+
+    // The times are those recorded by the first Find: nothing has been timed again.
+    EXPECT_EQUAL(first.size(), second.size());
+    for(std::size_t i = 0; i < first.size() && i < second.size(); ++i)
+    {
+        EXPECT_EQUAL(first[i].fwd_algo, second[i].fwd_algo);
+        EXPECT(miopen::float_equal(first[i].time, second[i].time));
+    }
+}
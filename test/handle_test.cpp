@@ -1,6 +1,7 @@
 
 #include <miopen/handle.hpp>
 #include "get_handle.hpp"
+#include <string>
 #include <vector>
 #include <thread>
 #include "test.hpp"
@@ -70,9 +71,28 @@ void test_arch_name()
         known_arch.begin(), known_arch.end(), [&](std::string arch) { return arch == this_arch; }));
 }
 
+void test_destroy_with_pending_builds()
+{
+    // The builds are still running or queued when the handle goes away.
+    miopen::Handle h;
+    for(int i = 0; i < 8; ++i)
+        h.BuildProgramAsync("MIOpenCheckNumerics.cl", "-DMIOPEN_TEST_BUILD=" + std::to_string(i));
+}
+
+void test_sibling()
+{
+    auto&& h     = get_handle();
+    auto sibling = h.CreateSibling();
+    // Programs built by either handle are shared.
+    EXPECT(sibling.GetProgramScope() == h.GetProgramScope());
+    EXPECT(sibling.GetDeviceName() == h.GetDeviceName());
+}
+
 int main()
 {
     test_multithreads();
+    test_destroy_with_pending_builds();
+    test_sibling();
     test_errors();
     test_arch_name();
 // Warnings currently dont work in opencl
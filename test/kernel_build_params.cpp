@@ -51,6 +51,20 @@ struct KBPTestDriver : test_driver
             "-Wa,-defsym,DefineWithValue=0 -TrivialOption -OptionWithValue 0 -Wa,-defsym,Shifted "
             "-Wa,-defsym,DefineDefine "
             "-Wa,-defsym,DefineDefineWithValue=1");
+
+        auto canonical = KernelBuildParameters{{"B", 1},
+                                               {kbp::Option{}, "cl-std=CL1.2"},
+                                               {"A"},
+                                               {kbp::Option{}, "I", "dir"}}
+                         << KernelBuildParameters{{"B", 1}} << KernelBuildParameters{{"C", 2}};
+        canonical.Canonicalize();
+        EXPECT_EQUAL(canonical.GenerateFor(kbp::OpenCL{}), "-cl-std=CL1.2 -I dir -DA -DB=1 -DC=2");
+        EXPECT_EQUAL(canonical.GenerateFor(kbp::GcnAsm{}),
+                     "-cl-std=CL1.2 -I dir -Wa,-defsym,A -Wa,-defsym,B=1 -Wa,-defsym,C=2");
+
+        auto overridden = KernelBuildParameters{{"A", 2}} << KernelBuildParameters{{"A", 1}};
+        overridden.Canonicalize();
+        EXPECT_EQUAL(overridden.GenerateFor(kbp::OpenCL{}), "-DA=2 -DA=1");
     }
 };
 } // namespace tests
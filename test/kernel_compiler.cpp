@@ -0,0 +1,125 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/errors.hpp>
+#include <miopen/kernel_compiler.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/write_file.hpp>
+#include "test.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Writes "<options>|<source>" to the object file, fails if the source says so.
+/// Leaves a file in the working directory and fails if it finds one left before.
+static const char fake_compiler[] = R"(#!/bin/sh
+out=""
+src=""
+opts=""
+while [ $# -gt 0 ]; do
+    case "$1" in
+        -o) out="$2"; shift 2;;
+        *.cpp) src="$1"; shift;;
+        *) opts="$opts $1"; shift;;
+    esac
+done
+grep -q error "$src" && exit 3
+[ -e leftover ] && exit 4
+touch leftover
+printf '%s|' "$opts" > "$out"
+cat "$src" >> "$out"
+)";
+
+static std::string MakeFakeCompiler(const miopen::TmpDir& dir)
+{
+    const auto path = dir.path / "fake-compiler";
+    miopen::WriteFile(fake_compiler, path);
+    boost::filesystem::permissions(path,
+                                   boost::filesystem::owner_all | boost::filesystem::group_read);
+    return path.string();
+}
+
+static void check_compile()
+{
+    const miopen::TmpDir dir("test-kernel-compiler");
+    miopen::ExternalCompiler compiler(MakeFakeCompiler(dir));
+
+    EXPECT_EQUAL(compiler.Compile("a.cpp", "source", " -DA=1  -O3"), " -DA=1 -O3|source");
+    // Shell syntax in options goes through the shell.
+    EXPECT_EQUAL(compiler.Compile("a.cpp", "source", "-DA=\"x y\""), " -DA=x y|source");
+    // Leftovers of the previous run have been removed, so the directory has been reused.
+    EXPECT_EQUAL(compiler.Compile("b.cpp", "other", ""), "|other");
+    EXPECT_EQUAL(compiler.ScratchDirs(), 1u);
+    // The compiler has not run in the working directory of the caller.
+    EXPECT(!boost::filesystem::exists("leftover"));
+
+    auto failed = false;
+    try
+    {
+        compiler.Compile("a.cpp", "error", "");
+    }
+    catch(const miopen::Exception&)
+    {
+        failed = true;
+    }
+    EXPECT(failed);
+    EXPECT_EQUAL(compiler.Compile("a.cpp", "source", ""), "|source");
+}
+
+static void check_concurrent()
+{
+    const miopen::TmpDir dir("test-kernel-compiler");
+    miopen::ExternalCompiler compiler(MakeFakeCompiler(dir));
+
+    const auto n_threads = 4;
+    std::vector<std::string> results(n_threads);
+    std::vector<std::thread> threads;
+    for(auto i = 0; i < n_threads; ++i)
+    {
+        threads.emplace_back([&, i]() {
+            for(auto j = 0; j < 8; ++j)
+            {
+                const auto options = "-DJ=" + std::to_string(j);
+                results[i]         = compiler.Compile("k.cpp", std::to_string(i), options);
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    for(auto i = 0; i < n_threads; ++i)
+        EXPECT_EQUAL(results[i], " -DJ=7|" + std::to_string(i));
+    EXPECT(compiler.ScratchDirs() <= static_cast<std::size_t>(n_threads));
+}
+
+int main()
+{
+    check_compile();
+    check_concurrent();
+}
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/kernel.hpp>
+#include "test.hpp"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+static void check_lookup()
+{
+    const auto src = miopen::GetKernelSrc("MIOpenSoftmax.cl");
+    EXPECT(src.find("__kernel") != std::string::npos);
+    // Kernels are keyed by the upper-cased base name of the file.
+    EXPECT(miopen::GetKernelSrc("kernels/MIOpenSoftmax.cl") == src);
+    EXPECT(miopen::GetKernelSrc("miopensoftmax") == src);
+    EXPECT(throws([] { miopen::GetKernelSrc("NoSuchKernel.cl"); }));
+}
+
+static void check_concurrent_first_use()
+{
+    const std::vector<std::string> names = {
+        "MIOpenPooling.cl", "MIOpenLRNFwd.cl", "MIOpenNeuron.cl", "MIOpenUtilKernels3.cl"};
+
+    std::vector<std::vector<std::string>> results(8);
+    std::vector<std::thread> threads;
+    for(auto& result : results)
+        threads.emplace_back([&] {
+            for(const auto& name : names)
+                result.push_back(miopen::GetKernelSrc(name));
+        });
+    for(auto& thread : threads)
+        thread.join();
+
+    for(const auto& result : results)
+    {
+        EXPECT(result == results.front());
+        for(const auto& src : result)
+            EXPECT(!src.empty());
+    }
+}
+
+int main()
+{
+    check_lookup();
+    check_concurrent_first_use();
+}
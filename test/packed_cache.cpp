@@ -0,0 +1,290 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db.hpp>
+#include <miopen/packed_cache.hpp>
+#include <miopen/temp_file.hpp>
+#include "test.hpp"
+
+#include <boost/filesystem/operations.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using miopen::PackedCache;
+
+static std::string MakeBlob(std::size_t size, char seed)
+{
+    std::string blob(size, '\0');
+    for(std::size_t i = 0; i < size; ++i)
+        blob[i] = static_cast<char>(seed + i * 7);
+    return blob;
+}
+
+static void Append(const std::string& path, const std::string& data)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    file.write(data.data(), data.size());
+}
+
+static std::uint32_t Now()
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+static std::uint32_t GetLastUse(const std::string& path, const std::string& key)
+{
+    const miopen::PackedCacheView view(path, miopen::FileStamp::Get(path));
+    return view.GetLastUse(*view.Find(key));
+}
+
+static void SetLastUse(const std::string& path, const std::string& key, std::uint32_t last_use)
+{
+    const miopen::PackedCacheView view(path, miopen::FileStamp::Get(path));
+    std::fstream stream(path, std::ios::binary | std::ios::in | std::ios::out);
+    stream.seekp(view.Find(key)->record_offset + offsetof(miopen::PackedCacheRecord, last_use));
+    stream.write(reinterpret_cast<const char*>(&last_use), sizeof(last_use));
+}
+
+static void check_store_load()
+{
+    const miopen::TempFile file("miopen.test.packed_cache");
+    PackedCache cache(file);
+
+    EXPECT(cache.Load("a").empty());
+    EXPECT(cache.Store("a", MakeBlob(100, 'a')));
+    EXPECT(cache.Store("b", MakeBlob(0, 'b')));
+    EXPECT(cache.Store("", MakeBlob(3, 'c')));
+    EXPECT_EQUAL(cache.Load("a"), MakeBlob(100, 'a'));
+    EXPECT_EQUAL(cache.Load(""), MakeBlob(3, 'c'));
+    EXPECT(cache.Load("c").empty());
+
+    // Programs already stored are not replaced.
+    const auto size = boost::filesystem::file_size(file.Path());
+    EXPECT(cache.Store("a", MakeBlob(10, 'x')));
+    EXPECT_EQUAL(cache.Load("a"), MakeBlob(100, 'a'));
+    EXPECT_EQUAL(boost::filesystem::file_size(file.Path()), size);
+
+    EXPECT_EQUAL(cache.Store({{"c", "1"}, {"c", "2"}, {"a", "3"}, {"d", "4"}}), 2);
+    EXPECT_EQUAL(cache.Load("c"), "1");
+    EXPECT_EQUAL(cache.Load("d"), "4");
+
+    auto n = 0;
+    cache.Visit([&](const std::string&, const char*, std::size_t) { ++n; });
+    EXPECT_EQUAL(n, 5);
+
+    std::remove(miopen::LockFilePath(file.Path()).c_str());
+}
+
+static void check_other_writer()
+{
+    const miopen::TempFile file("miopen.test.packed_cache");
+    PackedCache reader(file);
+    PackedCache writer(file);
+
+    EXPECT(writer.Store("a", "1"));
+    EXPECT_EQUAL(reader.Load("a"), "1");
+
+    // Appends of another writer are seen on a miss.
+    EXPECT(writer.Store("b", "2"));
+    EXPECT_EQUAL(reader.Load("b"), "2");
+    EXPECT_EQUAL(reader.Load("a"), "1");
+
+    // Both the writers know about each other's records.
+    EXPECT_EQUAL(reader.Store({{"a", "x"}, {"b", "y"}}), 0);
+
+    std::remove(miopen::LockFilePath(file.Path()).c_str());
+}
+
+static void check_interrupted_append()
+{
+    const miopen::TempFile file("miopen.test.packed_cache");
+
+    {
+        PackedCache cache(file);
+        EXPECT(cache.Store("a", MakeBlob(64, 'a')));
+    }
+
+    const auto size = boost::filesystem::file_size(file.Path());
+    Append(file, std::string(sizeof(miopen::PackedCacheRecord) + 5, '\x7f'));
+
+    PackedCache cache(file);
+    EXPECT_EQUAL(cache.Load("a"), MakeBlob(64, 'a'));
+    EXPECT(cache.Load("b").empty());
+
+    // The tail is dropped before the next record.
+    EXPECT(cache.Store("b", "2"));
+    EXPECT_EQUAL(cache.Load("b"), "2");
+    EXPECT_EQUAL(boost::filesystem::file_size(file.Path()),
+                 size + sizeof(miopen::PackedCacheRecord) + 2);
+
+    EXPECT_EQUAL(PackedCache(file).Load("b"), "2");
+
+    std::remove(miopen::LockFilePath(file.Path()).c_str());
+}
+
+static void check_corruption()
+{
+    const miopen::TempFile file("miopen.test.packed_cache");
+
+    {
+        PackedCache cache(file);
+        EXPECT(cache.Store("a", MakeBlob(64, 'a')));
+    }
+
+    {
+        std::fstream stream(file.Path(), std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(-1, std::ios::end);
+        stream.put('!');
+    }
+
+    EXPECT(PackedCache(file).Load("a").empty());
+
+    // A file of unknown format is replaced.
+    {
+        std::ofstream stream(file.Path(), std::ios::binary | std::ios::trunc);
+        stream << "Unknown format of the file";
+    }
+
+    PackedCache cache(file);
+    EXPECT(cache.Load("a").empty());
+    EXPECT(cache.Store("a", "1"));
+    EXPECT_EQUAL(cache.Load("a"), "1");
+    EXPECT_EQUAL(boost::filesystem::file_size(file.Path()),
+                 sizeof(miopen::PackedCacheHeader) + sizeof(miopen::PackedCacheRecord) + 2);
+
+    std::remove(miopen::LockFilePath(file.Path()).c_str());
+}
+
+static void check_concurrent()
+{
+    const miopen::TempFile file("miopen.test.packed_cache");
+    PackedCache cache(file);
+    const auto n_threads = 8;
+    const auto n_records = 64;
+
+    std::vector<std::thread> threads;
+    for(auto t = 0; t < n_threads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for(auto i = 0; i < n_records; ++i)
+            {
+                const auto key = std::to_string((i + t) % n_records);
+                if(cache.Load(key).empty())
+                    cache.Store(key, MakeBlob(i + t + 1, key[0]));
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    auto n = 0;
+    PackedCache(file).Visit([&](const std::string&, const char*, std::size_t) { ++n; });
+    EXPECT_EQUAL(n, n_records);
+
+    std::remove(miopen::LockFilePath(file.Path()).c_str());
+}
+
+static void check_last_use()
+{
+    const miopen::TempFile file("miopen.test.packed_cache");
+
+    {
+        PackedCache cache(file);
+        EXPECT(cache.Store("a", "1"));
+        EXPECT(cache.Store("b", "2"));
+        EXPECT(GetLastUse(file, "a") + 10 > Now());
+    }
+
+    // Recent use is not written again.
+    SetLastUse(file, "a", Now() - 2 * 3600);
+    SetLastUse(file, "b", Now() - 600);
+
+    PackedCache cache(file);
+    EXPECT_EQUAL(cache.Load("a"), "1");
+    EXPECT_EQUAL(cache.Load("b"), "2");
+    EXPECT(GetLastUse(file, "a") + 10 > Now());
+    EXPECT(GetLastUse(file, "b") + 600 <= Now());
+
+    std::remove(miopen::LockFilePath(file.Path()).c_str());
+}
+
+static void check_eviction()
+{
+    const miopen::TempFile file("miopen.test.packed_cache");
+    const std::size_t blob_size   = 1000;
+    const std::size_t record_size = sizeof(miopen::PackedCacheRecord) + 1 + blob_size;
+
+    PackedCache other(file);
+    PackedCache cache(file);
+    cache.SetSizeLimit(sizeof(miopen::PackedCacheHeader) + 4 * record_size - 1);
+
+    EXPECT(cache.Store({{"a", MakeBlob(blob_size, 'a')},
+                        {"b", MakeBlob(blob_size, 'b')},
+                        {"c", MakeBlob(blob_size, 'c')}}) == 3);
+    EXPECT_EQUAL(other.Load("a"), MakeBlob(blob_size, 'a'));
+
+    SetLastUse(file, "a", 100);
+    SetLastUse(file, "b", 300);
+    SetLastUse(file, "c", 200);
+
+    // The limit is exceeded, so the least recently used are evicted down to 3/4 of it.
+    EXPECT(cache.Store("d", MakeBlob(blob_size, 'd')));
+    EXPECT_EQUAL(boost::filesystem::file_size(file.Path()),
+                 sizeof(miopen::PackedCacheHeader) + 2 * record_size);
+
+    // Other instances keep their view until they miss.
+    for(const auto c : {&cache, &other})
+    {
+        EXPECT_EQUAL(c->Load("d"), MakeBlob(blob_size, 'd'));
+        EXPECT_EQUAL(c->Load("b"), MakeBlob(blob_size, 'b'));
+        EXPECT(c->Load("a").empty());
+        EXPECT(c->Load("c").empty());
+    }
+
+    // The replaced file is appended to as usual.
+    EXPECT(other.Store("e", "5"));
+    EXPECT_EQUAL(cache.Load("e"), "5");
+
+    std::remove(miopen::LockFilePath(file.Path()).c_str());
+}
+
+int main()
+{
+    check_store_load();
+    check_other_writer();
+    check_interrupted_append();
+    check_corruption();
+    check_concurrent();
+    check_last_use();
+    check_eviction();
+}
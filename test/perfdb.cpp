@@ -28,20 +28,27 @@
 #include "driver.hpp"
 
 #include <miopen/db.hpp>
+#include <miopen/db_binary.hpp>
+#include <miopen/db_cache.hpp>
+#include <miopen/db_index.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/lock_file.hpp>
+#include <miopen/serializable.hpp>
 #include <miopen/temp_file.hpp>
 
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/optional.hpp>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <mutex>
 #include <random>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <vector>
@@ -512,6 +519,328 @@ class DbParallelTest : public DbTest
     }
 };
 
+class DbIndexedFindTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing db index for big, irregular and externally modified files..."
+                  << std::endl;
+
+        ResetDb();
+
+        {
+            std::ofstream file(temp_file);
+            for(auto i = 0; i < 1000; ++i)
+                file << (2 * i) << ",0=" << id0() << ':' << i << ",0" << std::endl;
+            file << "ill-formed line" << std::endl;
+            file << std::endl;
+            file << "5,5=" << std::endl;
+            file << "5,5=" << id0() << ":5,5" << std::endl;
+            file << "0,0=" << id0() << ":-1,-1" << std::endl; // Duplicate, shall be ignored.
+            file << "7,7=" << id0() << ":7,7"; // No trailing newline.
+        }
+
+        Db db(temp_file);
+        TestData read(TestData::NoInit{});
+
+        EXPECT(db.Load(TestData(0, 0), id0(), read));
+        EXPECT_EQUAL(read, TestData(0, 0));
+        EXPECT(db.Load(TestData(1998, 0), id0(), read));
+        EXPECT_EQUAL(read, TestData(999, 0));
+        EXPECT(!db.FindRecord(TestData(1, 0)));
+        EXPECT(db.Load(TestData(5, 5), id0(), read));
+        EXPECT_EQUAL(read, TestData(5, 5));
+        EXPECT(db.Load(TestData(7, 7), id0(), read));
+        EXPECT_EQUAL(read, TestData(7, 7));
+
+        // The last record has no trailing newline, it shall be replaced in place.
+        EXPECT(db.Update(TestData(7, 7), id0(), TestData(8, 8)));
+        EXPECT(db.Load(TestData(7, 7), id0(), read));
+        EXPECT_EQUAL(read, TestData(8, 8));
+
+        // External modification shall be noticed by the same Db instance.
+        RawWrite(temp_file, key(), common_data());
+        EXPECT(!db.FindRecord(TestData(0, 0)));
+        ValidateSingleEntry(key(), common_data(), db);
+
+        ResetDb();
+        EXPECT(!db.FindRecord(key()));
+    }
+};
+
+class DbReadonlyTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing read-only db..." << std::endl;
+
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        const auto lock_file_path = LockFilePath(temp_file.Path());
+        std::remove(lock_file_path.c_str());
+
+        const ReadonlyDb db(temp_file);
+        ValidateSingleEntry(key(), common_data(), db);
+        EXPECT(!db.FindRecord(TestData(100, 200)));
+
+        // Installed db is read without locking.
+        EXPECT(!boost::filesystem::exists(lock_file_path));
+
+        ResetDb();
+        EXPECT(!db.FindRecord(key()));
+    }
+};
+
+class DbBatchTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing batched db modifications..." << std::endl;
+
+        ResetDb();
+        Run(Db(temp_file));
+
+        ResetDb();
+        Run(Db(temp_file, false));
+        std::remove(DbJournal::GetPath(temp_file).c_str());
+    }
+
+    private:
+    void Run(Db db) const
+    {
+        RawWrite(temp_file, key(), common_data());
+        {
+            // No trailing newline.
+            std::ofstream(temp_file, std::ios::app) << "10,10=" << id0() << ":10,10";
+        }
+
+        std::vector<DbRecord> records;
+        for(auto i = 0; i < 100; ++i)
+        {
+            records.emplace_back(TestData(i, 100));
+            EXPECT(records.back().SetValues(id0(), TestData(i, 0)));
+        }
+
+        records.emplace_back(key());
+        EXPECT(records.back().SetValues(id0(), value2()));
+        records.emplace_back(TestData(0, 100));
+        EXPECT(records.back().SetValues(id1(), value1())); // Replaces the first one.
+        EXPECT(db.StoreRecords(records));
+
+        TestData read(TestData::NoInit{});
+        EXPECT(db.Load(key(), id0(), read));
+        EXPECT_EQUAL(read, value2());
+        EXPECT(!db.Load(key(), id1(), read));
+        EXPECT(db.Load(TestData(99, 100), id0(), read));
+        EXPECT_EQUAL(read, TestData(99, 0));
+        EXPECT(!db.Load(TestData(0, 100), id0(), read));
+        EXPECT(db.Load(TestData(0, 100), id1(), read));
+        EXPECT(db.Load(TestData(10, 10), id0(), read));
+        EXPECT_EQUAL(read, TestData(10, 10));
+
+        records.clear();
+        records.emplace_back(key());
+        EXPECT(records.back().SetValues(id1(), value1()));
+        records.emplace_back(TestData(1000, 0));
+        EXPECT(records.back().SetValues(id0(), value0()));
+        records.emplace_back(key());
+        EXPECT(records.back().SetValues(id2(), value2()));
+        records.emplace_back(TestData(10, 10));
+        EXPECT(records.back().SetValues(id1(), value1()));
+        EXPECT(db.UpdateRecords(records));
+
+        // Records are updated with merged data.
+        EXPECT(records[2].GetValues(id0(), read));
+        EXPECT_EQUAL(read, value2());
+        EXPECT(records[2].GetValues(id1(), read));
+        EXPECT_EQUAL(read, value1());
+
+        EXPECT(db.Load(key(), id0(), read));
+        EXPECT_EQUAL(read, value2());
+        EXPECT(db.Load(key(), id1(), read));
+        EXPECT_EQUAL(read, value1());
+        EXPECT(db.Load(key(), id2(), read));
+        EXPECT_EQUAL(read, value2());
+        EXPECT(db.Load(TestData(1000, 0), id0(), read));
+        EXPECT_EQUAL(read, value0());
+        EXPECT(db.Load(TestData(10, 10), id0(), read));
+        EXPECT_EQUAL(read, TestData(10, 10));
+        EXPECT(db.Load(TestData(10, 10), id1(), read));
+        EXPECT_EQUAL(read, value1());
+        EXPECT(db.Load(TestData(50, 100), id0(), read));
+        EXPECT_EQUAL(read, TestData(50, 0));
+
+        EXPECT(db.StoreRecords({}));
+    }
+};
+
+class DbJournalTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing user db journal..." << std::endl;
+
+        const auto journal_path = DbJournal::GetPath(temp_file);
+        ResetDb();
+        RawWrite(temp_file, key(), common_data());
+
+        Db db(temp_file, false);
+        TestData read(TestData::NoInit{});
+
+        // Modifications leave the db file intact.
+        const auto db_stamp = FileStamp::Get(temp_file);
+        EXPECT(db.Update(key(), id0(), value2()));
+        EXPECT(db.Update(key(), id2(), value2()));
+        EXPECT(db.Load(key(), id0(), read));
+        EXPECT_EQUAL(read, value2());
+        EXPECT(db.Load(key(), id1(), read));
+        EXPECT_EQUAL(read, value1());
+        EXPECT(db.RemoveRecord(TestData(100, 200)));
+        EXPECT(db.Update(TestData(100, 200), id0(), value0()));
+        EXPECT(db.RemoveRecord(TestData(100, 200)));
+        EXPECT(!db.FindRecord(TestData(100, 200)));
+        EXPECT(FileStamp::Get(temp_file) == db_stamp);
+        EXPECT(FileStamp::Get(journal_path).exists);
+
+        // Interrupted write shall be ignored and shall not spoil subsequent ones.
+        std::ofstream(journal_path, std::ios::app) << "1,2=0:9,";
+        EXPECT(db.Load(key(), id0(), read));
+        EXPECT_EQUAL(read, value2());
+        EXPECT(db.Update(TestData(3, 4), id0(), value0()));
+        EXPECT(db.Load(key(), id0(), read));
+        EXPECT_EQUAL(read, value2());
+        EXPECT(db.Load(TestData(3, 4), id0(), read));
+        EXPECT_EQUAL(read, value0());
+
+        // Another instance, e.g. in another process, sees the same.
+        EXPECT(Db(temp_file, false).Load(key(), id2(), read));
+        EXPECT_EQUAL(read, value2());
+
+        const auto all = db.GetAllRecords();
+        EXPECT_EQUAL(all.size(), 2);
+        EXPECT(all[0].GetKey() == "1,2" && all[1].GetKey() == "3,4");
+        EXPECT(all[0].GetValues(id2(), read));
+        EXPECT_EQUAL(read, value2());
+
+        EXPECT(db.Compact());
+        EXPECT(!FileStamp::Get(journal_path).exists);
+        EXPECT(!db.FindRecord(TestData(100, 200)));
+        EXPECT(db.Load(TestData(3, 4), id0(), read));
+        EXPECT_EQUAL(read, value0());
+
+        // Compacted records are in the db file itself now.
+        Db system(temp_file);
+        EXPECT(system.Load(key(), id0(), read));
+        EXPECT_EQUAL(read, value2());
+        EXPECT(system.Load(key(), id1(), read));
+        EXPECT_EQUAL(read, value1());
+
+        // Others are kept from modifying the db until a rewrite is in place.
+        EXPECT(db.Update(TestData(5, 6), id0(), value1()));
+        std::thread writer;
+        EXPECT(db.Rewrite([&](std::vector<DbRecord>& records) {
+            writer = std::thread(
+                [&]() { EXPECT(Db(temp_file, false).Update(TestData(7, 8), id0(), value2())); });
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            records.erase(std::remove_if(records.begin(),
+                                         records.end(),
+                                         [](const DbRecord& r) { return r.GetKey() == "3,4"; }),
+                          records.end());
+        }));
+        writer.join();
+        EXPECT(!db.FindRecord(TestData(3, 4)));
+        EXPECT(db.Load(TestData(5, 6), id0(), read));
+        EXPECT_EQUAL(read, value1());
+        EXPECT(db.Load(TestData(7, 8), id0(), read));
+        EXPECT_EQUAL(read, value2());
+
+        // Big journal is compacted automatically.
+        for(auto i = 0; i < 20000 && FileStamp::Get(journal_path).size < 1024 * 1024; ++i)
+            EXPECT(db.Update(TestData(i, i), id0(), TestData(i, 0)));
+        EXPECT(db.Update(TestData(-1, -1), id0(), value0()));
+        EXPECT(FileStamp::Get(journal_path).size < 1024 * 1024);
+        EXPECT(db.Load(TestData(1000, 1000), id0(), read));
+        EXPECT_EQUAL(read, TestData(1000, 0));
+
+        std::remove(journal_path.c_str());
+    }
+};
+
+struct CompiledTestData : solver::Serializable<CompiledTestData>
+{
+    int x = 0;
+    int y = 0;
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.x, "x");
+        f(self.y, "y");
+    }
+};
+
+class DbCompiledTest : public DbTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Testing compiled db..." << std::endl;
+
+        const auto binary_path = GetDbBinaryPath(temp_file);
+        std::stringstream text;
+
+        for(auto i = 0; i < 100; ++i)
+            text << i << ",0=" << id0() << ':' << i << ',' << -i << ';' << id1() << ":not,ints"
+                 << std::endl;
+        text << "ill-formed line" << std::endl;
+        text << "0,0=" << id0() << ":-1,-1" << std::endl; // Duplicate, shall be ignored.
+
+        // Compiled db is used while it is not older than the text one, which is not read then.
+        RawWrite(temp_file, key(), common_data());
+        {
+            std::ofstream binary(binary_path, std::ios::binary);
+            EXPECT_EQUAL(CompileDb(text, binary), 100);
+        }
+
+        Db db(temp_file);
+        TestData read(TestData::NoInit{});
+        CompiledTestData compiled;
+
+        EXPECT(db.Load(TestData(42, 0), id0(), read));
+        EXPECT_EQUAL(read, TestData(42, -42));
+        EXPECT(db.Load(TestData(0, 0), id0(), compiled));
+        EXPECT(compiled.x == 0 && compiled.y == 0);
+        EXPECT(db.Load(TestData(99, 0), id0(), compiled));
+        EXPECT(compiled.x == 99 && compiled.y == -99);
+        EXPECT(!db.FindRecord(TestData(100, 0)));
+        EXPECT(!db.FindRecord(key()));
+
+        // Modifications go through the text db, which makes the compiled one obsolete.
+        EXPECT(db.Update(TestData(100, 0), id0(), TestData(1, 1)));
+        EXPECT(db.Load(TestData(100, 0), id0(), read));
+        EXPECT_EQUAL(read, TestData(1, 1));
+        EXPECT(!db.FindRecord(TestData(42, 0)));
+        ValidateSingleEntry(key(), common_data(), db);
+
+        // User db never reads compiled files.
+        ResetDb();
+        {
+            std::istringstream user_text("1,2=0:3,4");
+            std::ofstream binary(binary_path, std::ios::binary);
+            EXPECT_EQUAL(CompileDb(user_text, binary), 1);
+        }
+        EXPECT(Db(temp_file).FindRecord(key()));
+        EXPECT(!Db(temp_file, false).FindRecord(key()));
+
+        std::remove(binary_path.c_str());
+    }
+};
+
 class DBMultiThreadedTestWork
 {
     public:
@@ -962,6 +1291,7 @@ class DbMultiFileTest : public DbTest
     {
         DbTest::ResetDb();
         (void)std::ofstream(user_db_path);
+        std::remove(DbJournal::GetPath(user_db_path).c_str());
     }
 };
 
@@ -1045,7 +1375,8 @@ class DbMultiFileWriteTest : public DbMultiFileTest
 
         std::string read;
         EXPECT(!std::getline(std::ifstream(temp_file), read).good());
-        EXPECT(std::getline(std::ifstream(user_db_path), read).good());
+        // User db is journaled.
+        EXPECT(std::getline(std::ifstream(DbJournal::GetPath(user_db_path)), read).good());
 
         ValidateSingleEntry(key(), common_data(), MultiFileDb(temp_file, user_db_path));
     }
@@ -1088,7 +1419,7 @@ class DbMultiFileOperationsTest : public DbMultiFileTest
         }
 
         {
-            Db db(user_db_path);
+            Db db(user_db_path, false);
             TestData read(TestData::NoInit{});
             EXPECT(!db.Load(key(), id0(), read));
             EXPECT(db.Load(key(), id1(), read));
@@ -1142,6 +1473,105 @@ class DbMultiFileOperationsTest : public DbMultiFileTest
     }
 };
 
+class DbMultiFileCacheTest : public DbMultiFileTest
+{
+    public:
+    void Run() const
+    {
+        std::cout << "Running multifile cache test..." << std::endl;
+
+        ResetDb();
+        Lru();
+        OwnWrites();
+        ForeignWrites();
+    }
+
+    private:
+    static void Lru()
+    {
+        DbCache cache(2);
+        const DbCache::Stamps stamps{};
+        boost::optional<DbRecord> record;
+
+        cache.Insert("db", DbKey("1"), stamps, boost::none);
+        cache.Insert("db", DbKey("2"), stamps, boost::none);
+        EXPECT(cache.Find("db", DbKey("1"), stamps, record));
+        cache.Insert("db", DbKey("3"), stamps, boost::none);
+
+        EXPECT(cache.Find("db", DbKey("1"), stamps, record));
+        EXPECT(!cache.Find("db", DbKey("2"), stamps, record));
+        EXPECT(cache.Find("db", DbKey("3"), stamps, record));
+        EXPECT(!cache.Find("db", DbKey("3"), DbCache::Stamps{{FileStamp{true}, {}}}, record));
+        EXPECT(!cache.Find("db2", DbKey("3"), stamps, record));
+
+        cache.Invalidate("db", DbKey("1"));
+        EXPECT(!cache.Find("db", DbKey("1"), stamps, record));
+        cache.Invalidate("db");
+        EXPECT_EQUAL(cache.Size(), 0);
+    }
+
+    void OwnWrites() const
+    {
+        RawWrite(temp_file, key(), common_data());
+
+        MultiFileDb db(temp_file, user_db_path);
+        auto& cache       = DbCache::Instance();
+        const auto misses = cache.Misses();
+        const auto hits   = cache.Hits();
+
+        ValidateSingleEntry(key(), common_data(), db);
+        EXPECT(!db.FindRecord(TestData(100, 200)));
+        ValidateSingleEntry(key(), common_data(), db);
+        EXPECT(!db.FindRecord(TestData(100, 200)));
+        EXPECT_EQUAL(cache.Misses() - misses, 2);
+        EXPECT_EQUAL(cache.Hits() - hits, 2);
+
+        // Another instance targeting the same files shares cached records.
+        ValidateSingleEntry(key(), common_data(), MultiFileDb(temp_file, user_db_path));
+        EXPECT_EQUAL(cache.Hits() - hits, 3);
+
+        TestData read(TestData::NoInit{});
+        // Precomputed key is the same KEY and hits the same cache entry.
+        const DbKey precomputed(key());
+        EXPECT(precomputed == DbKey(DbRecord(key()).GetKey()));
+        EXPECT(db.Load(precomputed, id0(), read));
+        EXPECT_EQUAL(read, value0());
+        EXPECT_EQUAL(cache.Hits() - hits, 4);
+
+        EXPECT(db.Update(key(), id0(), value2()));
+        EXPECT(db.Load(key(), id0(), read));
+        EXPECT_EQUAL(read, value2());
+
+        EXPECT(db.Remove(key(), id0()));
+        EXPECT(db.Load(key(), id0(), read));
+        EXPECT_EQUAL(read, value0());
+
+        DbRecord record(TestData(100, 200));
+        EXPECT(record.SetValues(id1(), value1()));
+        EXPECT(db.StoreRecord(record));
+        EXPECT(db.Load(TestData(100, 200), id1(), read));
+        EXPECT_EQUAL(read, value1());
+
+        EXPECT(db.RemoveRecord(TestData(100, 200)));
+        EXPECT(!db.FindRecord(TestData(100, 200)));
+    }
+
+    void ForeignWrites() const
+    {
+        ResetDb();
+
+        MultiFileDb db(temp_file, user_db_path);
+        EXPECT(!db.FindRecord(key()));
+
+        // Writes done bypassing MultiFileDb are noticed by file stamps.
+        RawWrite(user_db_path, key(), common_data());
+        ValidateSingleEntry(key(), common_data(), db);
+
+        Db(user_db_path, false).RemoveRecord(key());
+        EXPECT(!db.FindRecord(key()));
+    }
+};
+
 class DbMultiFileMultiThreadedReadTest : public DbMultiFileTest
 {
     public:
@@ -1263,6 +1693,11 @@ struct PerfDbDriver : test_driver
         DbWriteTest().Run();
         DbOperationsTest().Run();
         DbParallelTest().Run();
+        DbIndexedFindTest().Run();
+        DbCompiledTest().Run();
+        DbJournalTest().Run();
+        DbBatchTest().Run();
+        DbReadonlyTest().Run();
 
         DbMultiThreadedReadTest().Run();
         DbMultiProcessReadTest().Run();
@@ -1272,6 +1707,7 @@ struct PerfDbDriver : test_driver
         DbMultiFileReadTest().Run();
         DbMultiFileWriteTest().Run();
         DbMultiFileOperationsTest().Run();
+        DbMultiFileCacheTest().Run();
         DbMultiFileMultiThreadedReadTest().Run();
         DbMultiFileMultiThreadedTest().Run();
     }
@@ -0,0 +1,160 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/program_registry.hpp>
+#include "test.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using Registry = miopen::ProgramRegistry;
+
+static const int scope0 = 0;
+static const int scope1 = 1;
+
+static Registry::Key MakeKey(const void* scope, const std::string& name)
+{
+    return {scope, name, " -DPARAM=1"};
+}
+
+static void check_sharing()
+{
+    Registry registry(1);
+    auto builds      = 0;
+    const auto build = [&]() {
+        ++builds;
+        return miopen::Program{};
+    };
+
+    const auto key = MakeKey(&scope0, "a.cl");
+    registry.Acquire(key, build, false).get();
+    registry.Acquire(key, build, false).get();
+    EXPECT_EQUAL(builds, 1);
+    EXPECT_EQUAL(registry.Hits(), 1u);
+    EXPECT_EQUAL(registry.Misses(), 1u);
+
+    // Another context or other params make another program.
+    registry.Acquire(MakeKey(&scope1, "a.cl"), build, false).get();
+    registry.Acquire({&scope0, "a.cl", ""}, build, false).get();
+    EXPECT_EQUAL(builds, 3);
+    EXPECT_EQUAL(registry.Size(), 3u);
+}
+
+static void check_references()
+{
+    Registry registry(1);
+    auto builds      = 0;
+    const auto build = [&]() {
+        ++builds;
+        return miopen::Program{};
+    };
+
+    const auto a = MakeKey(&scope0, "a.cl");
+    const auto b = MakeKey(&scope0, "b.cl");
+    registry.Acquire(a, build, false);
+    registry.Acquire(a, build, false);
+    registry.Acquire(b, build, false);
+
+    // Referenced programs are kept regardless of idle capacity.
+    registry.Release(a);
+    registry.Release(b);
+    EXPECT_EQUAL(registry.Size(), 2u);
+
+    // An idle program is kept until there are too many of them.
+    registry.Acquire(b, build, false);
+    EXPECT_EQUAL(builds, 2);
+    registry.Release(b);
+    registry.Release(a);
+    EXPECT_EQUAL(registry.Size(), 1u);
+    registry.Acquire(a, build, false);
+    registry.Acquire(b, build, false);
+    EXPECT_EQUAL(builds, 3);
+
+    registry.Release(a);
+    registry.Forget(&scope1);
+    EXPECT_EQUAL(registry.Size(), 2u);
+    registry.Forget(&scope0);
+    EXPECT_EQUAL(registry.Size(), 1u);
+}
+
+static void check_failure()
+{
+    Registry registry;
+    const auto key = MakeKey(&scope0, "a.cl");
+
+    auto failed = false;
+    try
+    {
+        registry.Acquire(key, []() -> miopen::Program { throw std::runtime_error("failed"); }, false)
+            .get();
+    }
+    catch(const std::runtime_error&)
+    {
+        failed = true;
+    }
+    EXPECT(failed);
+
+    auto builds = 0;
+    registry.Acquire(key,
+                     [&]() {
+                         ++builds;
+                         return miopen::Program{};
+                     },
+                     false)
+        .get();
+    EXPECT_EQUAL(builds, 1);
+}
+
+static void check_concurrent()
+{
+    Registry registry;
+    std::atomic<int> builds{0};
+    const auto build = [&]() {
+        ++builds;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        return miopen::Program{};
+    };
+
+    const auto key = MakeKey(&scope0, "a.cl");
+    std::vector<std::thread> threads;
+    for(auto i = 0; i < 8; ++i)
+        threads.emplace_back([&]() { registry.Acquire(key, build, true).get(); });
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQUAL(builds.load(), 1);
+    EXPECT_EQUAL(registry.Hits(), 7u);
+}
+
+int main()
+{
+    check_sharing();
+    check_references();
+    check_failure();
+    check_concurrent();
+}
@@ -0,0 +1,131 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/generic_search.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/search_checkpoint.hpp>
+#include <miopen/solver.hpp>
+#include "get_handle.hpp"
+#include "test.hpp"
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+struct BuildConfig : miopen::solver::Serializable<BuildConfig>
+{
+    int n = -1;
+
+    BuildConfig() = default;
+    BuildConfig(bool) : n(0) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.n, "n");
+    }
+
+    bool SetNextValue() { return ++n < 32; }
+    bool IsValid(const miopen::ConvolutionContext&) const { return true; }
+    bool operator==(const BuildConfig& other) const { return n == other.n; }
+};
+
+/// Each config is a program of its own, so the candidates prepared ahead of the one
+/// being measured are still building when the budget runs out.
+struct BuildingSolver : miopen::solver::SolverBase<miopen::ConvolutionContext>
+{
+    BuildConfig GetPerformanceConfig(const miopen::ConvolutionContext&) const
+    {
+        return BuildConfig{true};
+    }
+
+    bool IsValidPerformanceConfig(const miopen::ConvolutionContext&, const BuildConfig&) const
+    {
+        return true;
+    }
+
+    miopen::solver::ConvSolution GetSolution(const miopen::ConvolutionContext&,
+                                             const BuildConfig& config,
+                                             bool = false) const
+    {
+        miopen::solver::KernelInfo kernel;
+        kernel.kernel_file  = "MIOpenCheckNumerics.cl";
+        kernel.kernel_name  = "MIOpenCheckNumerics";
+        kernel.comp_options = "-DMIOPEN_TEST_CONFIG=" + std::to_string(config.n);
+        kernel.l_wk         = {64, 1, 1};
+        kernel.g_wk         = {64, 1, 1};
+
+        miopen::solver::ConvSolution solution;
+        solution.construction_params.push_back(kernel);
+        return solution;
+    }
+
+    int RunAndMeasureSolution(miopen::Handle&,
+                              Data_t,
+                              Data_t,
+                              Data_t,
+                              Data_t,
+                              const miopen::ConvolutionContext&,
+                              const miopen::solver::ConvSolution&,
+                              float& elapsed_time) const
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        elapsed_time = 1.0f;
+        return 0;
+    }
+};
+
+static void check_budget_cut()
+{
+    auto&& handle = get_handle();
+    miopen::ConvolutionContext context;
+    context.SetStream(&handle);
+    context.bot_sz     = 64 * sizeof(float);
+    context.top_sz     = 64 * sizeof(float);
+    context.weights_sz = 64 * sizeof(float);
+
+    const BuildingSolver solver;
+    miopen::solver::SearchCheckpoints checkpoints(context.GetSearchCheckpointPath(),
+                                                  miopen::DbKey(context),
+                                                  miopen::solver::SolverDbId(solver));
+    checkpoints.Remove();
+
+    miopen::solver::SearchOptions options;
+    options.strategy = miopen::solver::SearchStrategyKind::Exhaustive;
+    options.budget   = std::chrono::milliseconds(1);
+
+    // The search handle goes away with builds of the candidates past the cut pending.
+    const auto config = miopen::solver::GenericSearch(
+        solver, context, miopen::solver::SearchTweak::None, options);
+    EXPECT(config.n >= 0);
+
+    miopen::solver::SearchCheckpoint checkpoint;
+    EXPECT(checkpoints.Load(checkpoint));
+    EXPECT(checkpoint.position < 32);
+    checkpoints.Remove();
+}
+
+int main() { check_budget_cut(); }
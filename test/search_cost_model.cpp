@@ -0,0 +1,171 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/conv_warmup.hpp>
+#include <miopen/db_path.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/search_cost_model.hpp>
+#include <miopen/solver.hpp>
+#include "test.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+static void check_select_top()
+{
+    std::vector<int> all(100);
+    for(int i = 0; i < 100; ++i)
+        all[i] = (i * 37) % 100;
+    const auto cost = [](int x) { return static_cast<float>(std::abs(x - 50)); };
+
+    const auto top = miopen::solver::SelectTopCandidates<int>(all, 5, cost);
+    EXPECT_EQUAL(top.size(), 5u);
+    // The original order is kept.
+    for(std::size_t i = 1; i < top.size(); ++i)
+        EXPECT(std::find(all.begin(), all.end(), top[i - 1]) <
+               std::find(all.begin(), all.end(), top[i]));
+    for(const auto x : top)
+        EXPECT(48 <= x && x <= 52);
+
+    EXPECT(miopen::solver::SelectTopCandidates<int>(all, 0, cost) == all);
+    EXPECT(miopen::solver::SelectTopCandidates<int>(all, 200, cost) == all);
+}
+
+static miopen::solver::ConvSolution
+MakeSolution(std::size_t groups, std::size_t group_size, int out_pix_tile)
+{
+    miopen::solver::KernelInfo kernel;
+    kernel.l_wk = {group_size, 1, 1};
+    kernel.g_wk = {groups * group_size, 1, 1};
+
+    miopen::solver::ConvSolution solution;
+    solution.construction_params.push_back(kernel);
+    solution.out_pix_tile0 = out_pix_tile;
+    solution.out_pix_tile1 = out_pix_tile;
+    return solution;
+}
+
+static void check_default_model()
+{
+    miopen::ConvolutionContext context;
+    context.batch_sz      = 16;
+    context.n_inputs      = 64;
+    context.n_outputs     = 64;
+    context.out_height    = 28;
+    context.out_width     = 28;
+    context.kernel_size_h = 3;
+    context.kernel_size_w = 3;
+
+    const auto cost = [&](std::size_t groups, std::size_t group_size, int tile) {
+        return miopen::solver::EstimateSolutionCost(
+            context, MakeSolution(groups, group_size, tile), 64);
+    };
+
+    // 64 CUs run 256 waves at once: fewer leave the device partly idle.
+    EXPECT(cost(64, 64, 1) > cost(256, 64, 1));
+    EXPECT(cost(64, 256, 1) == cost(256, 64, 1));
+    // A round of 2 waves only is as long as a full one.
+    EXPECT(cost(258, 64, 1) > cost(512, 64, 1));
+    // Larger tiles per work item reuse the inputs.
+    EXPECT(cost(256, 64, 4) < cost(256, 64, 1));
+}
+
+/// The configs found by searches on the device are the ground truth: the estimate
+/// shall rank them among the cheapest of their spaces.
+static void check_ranking_of(const std::string& filename, std::size_t compute_units)
+{
+    std::ifstream file(miopen::GetDbPath() + "/" + filename);
+    if(!file)
+    {
+        std::cout << "Skipped, no " << filename << std::endl;
+        return;
+    }
+
+    const std::string id = "ConvAsm1x1U:";
+    const miopen::solver::ConvAsm1x1U solver;
+    std::vector<float> percentiles;
+    std::string line;
+    for(std::size_t n_record = 0; percentiles.size() < 40 && std::getline(file, line);)
+    {
+        const auto values = line.find(id);
+        if(values == std::string::npos || n_record++ % 97 != 0)
+            continue;
+
+        const auto problem = miopen::ConvolutionProblem::Parse(line.substr(0, line.find('=')));
+        const auto dir = problem.direction.IsForward() ? 1 : 0;
+        miopen::ConvolutionContext context(problem.x, problem.w, problem.y, problem.conv, dir, 0);
+
+        miopen::solver::PerformanceConfigConvAsm1x1U found;
+        const auto begin = values + id.size();
+        if(!found.Deserialize(line.substr(begin, line.find(';', begin) - begin)))
+            continue;
+
+        const miopen::solver::ComputedContainer<miopen::solver::PerformanceConfigConvAsm1x1U,
+                                                miopen::ConvolutionContext>
+            all_configs(context);
+        std::vector<float> costs;
+        float found_cost = -1.0f;
+        for(const auto& config : all_configs)
+        {
+            costs.push_back(miopen::solver::EstimateCost(solver, context, config, compute_units));
+            if(config.ToString() == found.ToString())
+                found_cost = costs.back();
+        }
+        if(found_cost < 0.0f) // Found in the spare or the full space.
+            continue;
+
+        // Ties count half, as a search would pick either.
+        const auto cheaper = std::count_if(
+            costs.begin(), costs.end(), [&](float c) { return c < found_cost; });
+        const auto tied = std::count(costs.begin(), costs.end(), found_cost);
+        percentiles.push_back((cheaper + 0.5f * tied) / costs.size());
+    }
+
+    EXPECT(!percentiles.empty());
+    std::sort(percentiles.begin(), percentiles.end());
+    const auto median = percentiles[percentiles.size() / 2];
+    const auto in_top_fifth =
+        std::count_if(percentiles.begin(), percentiles.end(), [](float p) { return p < 0.2f; });
+    std::cout << filename << ": median percentile " << median << ", "
+              << (100 * in_top_fifth / percentiles.size()) << "% in the top fifth" << std::endl;
+
+    // Random ranking would give 0.5 and 20%.
+    EXPECT(median < 0.2f);
+    EXPECT(static_cast<std::size_t>(in_top_fifth) * 2 > percentiles.size());
+}
+
+int main()
+{
+    check_select_top();
+    check_default_model();
+    check_ranking_of("gfx900_64.cd.pdb.txt", 64);
+    check_ranking_of("gfx803_36.cd.pdb.txt", 36);
+}
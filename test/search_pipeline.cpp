@@ -0,0 +1,228 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/generic_search.hpp>
+#include <miopen/search_pipeline.hpp>
+#include "test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using std::chrono::milliseconds;
+using Clock = std::chrono::steady_clock;
+
+struct FakeProblem
+{
+    int n_configs;
+};
+
+/// Enumerates 0..n_configs-1, except multiples of 5.
+struct FakeConfig
+{
+    int value = -1;
+
+    FakeConfig() = default;
+    FakeConfig(bool) : value(0) {}
+
+    bool SetNextValue() { return ++value < 1000; }
+    bool IsValid(const FakeProblem& problem) const
+    {
+        return value < problem.n_configs && value % 5 != 0;
+    }
+    bool operator==(const FakeConfig& other) const { return value == other.value; }
+    void Serialize(std::ostream& os) const { os << value; }
+
+    friend std::ostream& operator<<(std::ostream& os, const FakeConfig& config)
+    {
+        return os << config.value;
+    }
+};
+
+/// "Compiling" and "running" are sleeps, the run time is smallest for config 17.
+struct FakeSolver
+{
+    milliseconds compile_time;
+    milliseconds run_time;
+    std::atomic<int> compiled{0};
+
+    FakeSolver(milliseconds compile_time_, milliseconds run_time_)
+        : compile_time(compile_time_), run_time(run_time_)
+    {
+    }
+
+    int Compile(const FakeConfig& config)
+    {
+        std::this_thread::sleep_for(compile_time);
+        ++compiled;
+        return config.value;
+    }
+
+    int Run(int kernel, float& elapsed_time) const
+    {
+        std::this_thread::sleep_for(run_time);
+        elapsed_time = 1.0f + static_cast<float>(std::abs(kernel - 17));
+        return kernel == 23 ? -1 : 0;
+    }
+};
+
+static void check_order_and_lookahead()
+{
+    miopen::CompilePool pool(4);
+    const std::vector<int> items = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+    const std::size_t depth = 3;
+    std::atomic<int> prepared{0};
+    std::vector<int> consumed;
+
+    miopen::ForEachPrepared(items.begin(),
+                            items.end(),
+                            depth,
+                            pool,
+                            [&](int i) {
+                                ++prepared;
+                                return i * 10;
+                            },
+                            [&](int i, int result) {
+                                EXPECT_EQUAL(result, i * 10);
+                                // The current item and at most `depth` ones after it.
+                                EXPECT(prepared <= i + 1 + static_cast<int>(depth));
+                                consumed.push_back(i);
+                                return true;
+                            });
+
+    EXPECT(consumed == items);
+
+    // Stops when asked to.
+    consumed.clear();
+    miopen::ForEachPrepared(items.begin(),
+                            items.end(),
+                            depth,
+                            pool,
+                            [](int i) { return i; },
+                            [&](int i, int) {
+                                consumed.push_back(i);
+                                return i < 5;
+                            });
+    EXPECT(consumed == std::vector<int>({0, 1, 2, 3, 4, 5}));
+}
+
+static void check_exception()
+{
+    miopen::CompilePool pool(4);
+    const std::vector<int> items = {0, 1, 2, 3, 4, 5, 6, 7};
+    std::vector<int> consumed;
+
+    EXPECT(throws([&] {
+        miopen::ForEachPrepared(items.begin(),
+                                items.end(),
+                                4,
+                                pool,
+                                [](int i) {
+                                    if(i == 3)
+                                        throw std::runtime_error("compile failed");
+                                    return i;
+                                },
+                                [&](int i, int) {
+                                    consumed.push_back(i);
+                                    return true;
+                                });
+    }));
+    EXPECT(consumed == std::vector<int>({0, 1, 2}));
+}
+
+/// Wall time of consuming all the items with the given number of compile threads.
+static milliseconds
+TimePipeline(FakeSolver& solver, const std::vector<FakeConfig>& configs, int threads)
+{
+    miopen::CompilePool pool(threads);
+    const auto start = Clock::now();
+    miopen::ForEachPrepared(configs.begin(),
+                            configs.end(),
+                            2 * pool.Size(),
+                            pool,
+                            [&](const FakeConfig& config) { return solver.Compile(config); },
+                            [&](const FakeConfig&, int kernel) {
+                                float time;
+                                solver.Run(kernel, time);
+                                return true;
+                            });
+    return std::chrono::duration_cast<milliseconds>(Clock::now() - start);
+}
+
+static void check_overlap()
+{
+    FakeSolver solver{milliseconds{20}, milliseconds{5}};
+    const miopen::solver::ComputedContainer<FakeConfig, FakeProblem> container({40});
+    const std::vector<FakeConfig> configs(container.begin(), container.end());
+    EXPECT_EQUAL(configs.size(), 32u);
+
+    const auto serial    = TimePipeline(solver, configs, 1);
+    const auto pipelined = TimePipeline(solver, configs, 4);
+    std::cout << "Serial: " << serial.count() << " ms, pipelined: " << pipelined.count() << " ms"
+              << std::endl;
+
+    // Serial is 32 * (20 + 5) ms. With 4 threads compiling, the runs dominate: 32 * 5 ms,
+    // plus filling the pipeline.
+    EXPECT(serial >= milliseconds{32 * 25});
+    EXPECT(pipelined < serial / 2);
+}
+
+static void check_search_best()
+{
+    FakeSolver solver{milliseconds{2}, milliseconds{0}};
+    const miopen::solver::ComputedContainer<FakeConfig, FakeProblem> container({40});
+
+    const auto best = miopen::solver::SearchBest(
+        container,
+        [&](const FakeConfig& config) { return solver.Compile(config); },
+        [&](int kernel, float& elapsed_time) { return solver.Run(kernel, elapsed_time); },
+        miopen::solver::SearchOptions{});
+
+    EXPECT_EQUAL(best.config.value, 17);
+    EXPECT_EQUAL(best.time, 1.0f);
+    EXPECT_EQUAL(solver.compiled.load(), 32);
+
+    // Every candidate fails.
+    const miopen::solver::ComputedContainer<FakeConfig, FakeProblem> failing({4});
+    EXPECT(throws([&] {
+        miopen::solver::SearchBest(failing,
+                                   [&](const FakeConfig& config) { return config.value; },
+                                   [&](int, float&) { return -1; },
+                                   miopen::solver::SearchOptions{});
+    }));
+}
+
+int main()
+{
+    check_order_and_lookahead();
+    check_exception();
+    check_overlap();
+    check_search_best();
+}
@@ -0,0 +1,297 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/generic_search.hpp>
+#include <miopen/db.hpp>
+#include <miopen/search_checkpoint.hpp>
+#include <miopen/search_strategy.hpp>
+#include <miopen/serializable.hpp>
+#include <miopen/temp_file.hpp>
+#include "test.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+struct TileProblem
+{
+};
+
+/// Four tuning parameters of 8 values each, as in a real PerformanceConfig.
+struct TileConfig : miopen::solver::Serializable<TileConfig>
+{
+    int tile_x = -1;
+    int tile_y = -1;
+    int unroll = -1;
+    int waves  = -1;
+
+    TileConfig() = default;
+    TileConfig(bool) : tile_x(0), tile_y(0), unroll(0), waves(0) {}
+    TileConfig(int x, int y, int u, int w) : tile_x(x), tile_y(y), unroll(u), waves(w) {}
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.tile_x, "tile_x");
+        f(self.tile_y, "tile_y");
+        f(self.unroll, "unroll");
+        f(self.waves, "waves");
+    }
+
+    bool SetNextValue()
+    {
+        for(auto* field : {&waves, &unroll, &tile_y, &tile_x})
+        {
+            if(++*field < 8)
+                return true;
+            *field = 0;
+        }
+        return false;
+    }
+
+    bool IsValid(const TileProblem&) const { return !(tile_x == 7 && tile_y == 7); }
+    bool operator==(const TileConfig& other) const
+    {
+        return tile_x == other.tile_x && tile_y == other.tile_y && unroll == other.unroll &&
+               waves == other.waves;
+    }
+};
+
+/// Simulated kernel time: smooth in every parameter with the optimum at (5, 2, 6, 3),
+/// plus 2% measurement jitter. A few configs fail to run.
+struct CostModel
+{
+    std::mt19937 jitter{42};
+    int runs = 0;
+    std::mutex mutex;
+    std::set<int> compiled;
+
+    static float Time(const TileConfig& c)
+    {
+        return 10.0f + std::pow(c.tile_x - 5, 2) + 0.5f * std::pow(c.tile_y - 2, 2) +
+               0.25f * std::pow(c.unroll - 6, 2) * (c.waves + 1) + std::abs(c.waves - 3);
+    }
+
+    static int Id(const TileConfig& c)
+    {
+        return ((c.tile_x * 8 + c.tile_y) * 8 + c.unroll) * 8 + c.waves;
+    }
+
+    TileConfig Compile(const TileConfig& config)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        compiled.insert(Id(config));
+        return config;
+    }
+
+    int Run(const TileConfig& config, float& elapsed_time, std::chrono::milliseconds delay)
+    {
+        ++runs;
+        std::this_thread::sleep_for(delay);
+        if(config.unroll == 0 && config.waves == 0)
+            return -1;
+        elapsed_time =
+            Time(config) * (1.0f + std::uniform_real_distribution<float>(-0.02f, 0.02f)(jitter));
+        return 0;
+    }
+};
+
+struct Outcome
+{
+    TileConfig config;
+    std::size_t compiled;
+    int runs;
+};
+
+static Outcome Search(miopen::solver::SearchOptions options,
+                      std::chrono::milliseconds delay = std::chrono::milliseconds{0},
+                      miopen::solver::SearchCheckpoints* checkpoints = nullptr)
+{
+    CostModel model;
+    const miopen::solver::ComputedContainer<TileConfig, TileProblem> container({});
+    const auto best = miopen::solver::SearchBest(
+        container,
+        [&](const TileConfig& config) { return model.Compile(config); },
+        [&](const TileConfig& config, float& time) { return model.Run(config, time, delay); },
+        options,
+        checkpoints);
+    return {best.config, model.compiled.size(), model.runs};
+}
+
+static void check_strategies()
+{
+    const std::size_t space = 8 * 8 * 8 * 8 - 8 * 8;
+    const auto optimum      = CostModel::Time(TileConfig(5, 2, 6, 3));
+    miopen::solver::SearchOptions options;
+    options.seed = 18;
+
+    std::cout << std::left << std::setw(12) << "strategy" << std::setw(10) << "compiled"
+              << std::setw(8) << "runs"
+              << "best/optimum" << std::endl;
+
+    using Kind = miopen::solver::SearchStrategyKind;
+    for(const auto kind : {Kind::Exhaustive, Kind::Random, Kind::Halving, Kind::Evolution})
+    {
+        options.strategy   = kind;
+        const auto outcome = Search(options);
+        const auto quality = CostModel::Time(outcome.config) / optimum;
+
+        std::ostringstream name;
+        name << kind;
+        std::cout << std::setw(12) << name.str() << std::setw(10) << outcome.compiled
+                  << std::setw(8) << outcome.runs << quality << std::endl;
+
+        if(kind == Kind::Exhaustive)
+        {
+            EXPECT_EQUAL(outcome.compiled, space);
+            EXPECT(outcome.config == TileConfig(5, 2, 6, 3));
+        }
+        else
+        {
+            // A tenth of the space by default, and close to the optimum.
+            EXPECT(outcome.compiled <= space / 10);
+            EXPECT(quality < 1.1f);
+        }
+
+        // The same seed gives the same result.
+        EXPECT(Search(options).config == outcome.config);
+    }
+}
+
+static void check_random_index()
+{
+    // The same choices for a seed with any standard library.
+    std::mt19937 rng(0);
+    std::vector<std::size_t> drawn;
+    for(const auto size : {10u, 10u, 10u, 10u, 1000u, 1000u, 7u, 7u})
+        drawn.push_back(miopen::solver::RandomIndex(size, rng));
+    EXPECT(drawn == std::vector<std::size_t>({4, 9, 3, 0, 963, 379, 6, 3}));
+
+    std::vector<int> hits(5, 0);
+    for(auto i = 0; i < 5000; ++i)
+        ++hits[miopen::solver::RandomIndex(hits.size(), rng)];
+    for(const auto h : hits)
+        EXPECT(h > 800 && h < 1200);
+}
+
+static void check_budget()
+{
+    miopen::solver::SearchOptions options;
+    options.strategy = miopen::solver::SearchStrategyKind::Random;
+    options.budget   = std::chrono::milliseconds{100};
+
+    const auto outcome = Search(options, std::chrono::milliseconds{2});
+    EXPECT(outcome.runs > 0);
+    EXPECT(outcome.runs < 200);
+}
+
+static void check_checkpoint_format()
+{
+    miopen::solver::SearchCheckpoint saved;
+    saved.strategy    = miopen::solver::SearchStrategyKind::Halving;
+    saved.seed        = 3;
+    saved.size        = 4096;
+    saved.position    = 1234;
+    saved.best_time   = 0.123456789f;
+    saved.best_config = "1,2,3,4";
+
+    std::ostringstream ss;
+    saved.Serialize(ss);
+    EXPECT(ss.str().find_first_of(";:=") == std::string::npos);
+
+    miopen::solver::SearchCheckpoint loaded;
+    EXPECT(loaded.Deserialize(ss.str()));
+    EXPECT(loaded.strategy == saved.strategy);
+    EXPECT_EQUAL(loaded.seed, saved.seed);
+    EXPECT_EQUAL(loaded.size, saved.size);
+    EXPECT_EQUAL(loaded.position, saved.position);
+    EXPECT_EQUAL(loaded.best_time, saved.best_time);
+    EXPECT_EQUAL(loaded.best_config, saved.best_config);
+
+    EXPECT(!loaded.Deserialize("9,0,10,0,1.0,"));
+    EXPECT(!loaded.Deserialize("1,0,10,0"));
+}
+
+static void check_resume()
+{
+    const std::size_t space = 8 * 8 * 8 * 8 - 8 * 8;
+    const miopen::TempFile file("miopen.tests.search_checkpoint");
+    miopen::solver::SearchCheckpoints checkpoints(
+        file.Path(), miopen::DbKey(std::string("tile")), "TileSolver", std::chrono::seconds{0});
+
+    miopen::solver::SearchOptions options;
+    options.strategy = miopen::solver::SearchStrategyKind::Exhaustive;
+    options.budget   = std::chrono::milliseconds{100};
+
+    // The budget runs out: the best so far is returned and the progress is kept.
+    const auto cut = Search(options, std::chrono::milliseconds{1}, &checkpoints);
+    miopen::solver::SearchCheckpoint checkpoint;
+    EXPECT(checkpoints.Load(checkpoint));
+    EXPECT_EQUAL(checkpoint.size, space);
+    EXPECT(checkpoint.position > 0);
+    EXPECT(checkpoint.position < space);
+    EXPECT(checkpoint.position <= cut.compiled); // The next ones are built ahead.
+
+    std::ostringstream best;
+    cut.config.Serialize(best);
+    EXPECT_EQUAL(checkpoint.best_config, best.str());
+
+    // The next search only measures the rest and removes the checkpoint once complete.
+    options.budget    = std::chrono::milliseconds{0};
+    const auto resumed = Search(options, std::chrono::milliseconds{0}, &checkpoints);
+    EXPECT_EQUAL(resumed.compiled, space - checkpoint.position);
+    EXPECT(resumed.config == TileConfig(5, 2, 6, 3));
+    EXPECT(!checkpoints.Exists());
+
+    // A checkpoint of another seed or space is ignored.
+    checkpoint.seed = 1;
+    checkpoints.Save(checkpoint, true);
+    EXPECT_EQUAL(Search(options, std::chrono::milliseconds{0}, &checkpoints).compiled, space);
+    EXPECT(!checkpoints.Exists());
+
+    checkpoint.seed = 0;
+    checkpoint.size = space / 2;
+    checkpoints.Save(checkpoint, true);
+    EXPECT_EQUAL(Search(options, std::chrono::milliseconds{0}, &checkpoints).compiled, space);
+    EXPECT(!checkpoints.Exists());
+
+    std::remove(miopen::LockFilePath(file.Path()).c_str());
+}
+
+int main()
+{
+    check_strategies();
+    check_random_index();
+    check_budget();
+    check_checkpoint_format();
+    check_resume();
+}
@@ -0,0 +1,296 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/serializable.hpp>
+#include "test.hpp"
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct BenchConfig : miopen::solver::Serializable<BenchConfig>
+{
+    int a           = 0;
+    int b           = 0;
+    int c           = 0;
+    int d           = 0;
+    bool e          = false;
+    long long f     = 0;
+    std::size_t g   = 0;
+    std::string str = "";
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.a, "a");
+        f(self.b, "b");
+        f(self.c, "c");
+        f(self.d, "d");
+        f(self.e, "e");
+        f(self.f, "f");
+        f(self.g, "g");
+        f(self.str, "str");
+    }
+
+    bool operator==(const BenchConfig& other) const
+    {
+        return a == other.a && b == other.b && c == other.c && d == other.d && e == other.e &&
+               f == other.f && g == other.g && str == other.str;
+    }
+};
+
+/// Fields of a compiled (binary) db record are stored as int.
+struct NarrowConfig : miopen::solver::Serializable<NarrowConfig>
+{
+    bool flag                     = false;
+    short small                   = 0;
+    unsigned short unsigned_small = 0;
+    unsigned count                = 0;
+
+    template <class Self, class F>
+    static void Visit(Self&& self, F f)
+    {
+        f(self.flag, "flag");
+        f(self.small, "small");
+        f(self.unsigned_small, "unsigned_small");
+        f(self.count, "count");
+    }
+};
+
+/// The implementation Serializable had before, kept as the reference for comparison.
+struct LegacyDeserializeField
+{
+    template <class T>
+    void operator()(bool& ok, std::istream& stream, T& x) const
+    {
+        if(not ok)
+            return;
+        std::string part;
+        if(!std::getline(stream, part, ','))
+        {
+            ok = false;
+            return;
+        }
+        std::stringstream ss;
+        ss.str(part);
+        ss >> x;
+    }
+};
+
+struct LegacySerializeField
+{
+    template <class T>
+    void operator()(std::ostream& stream, char& sep, const T& x) const
+    {
+        if(sep != 0)
+            stream << sep;
+        stream << x;
+        sep = ',';
+    }
+};
+
+static bool LegacyDeserialize(BenchConfig& config, const std::string& s)
+{
+    auto out = config;
+    bool ok  = true;
+    std::istringstream ss(s);
+    BenchConfig::Visit(out, [&](auto& x, auto) { LegacyDeserializeField{}(ok, ss, x); });
+    if(ok)
+        config = out;
+    return ok;
+}
+
+static std::string LegacySerialize(const BenchConfig& config)
+{
+    std::ostringstream ss;
+    char sep = 0;
+    BenchConfig::Visit(config, [&](auto& x, auto) { LegacySerializeField{}(ss, sep, x); });
+    return ss.str();
+}
+
+static std::string Serialize(const BenchConfig& config)
+{
+    std::ostringstream ss;
+    config.Serialize(ss);
+    return ss.str();
+}
+
+static BenchConfig MakeConfig(int i)
+{
+    BenchConfig config;
+    config.a   = i;
+    config.b   = -i * 7;
+    config.c   = i % 64;
+    config.d   = INT_MIN + i;
+    config.e   = (i % 2) != 0;
+    config.f   = LLONG_MAX - i;
+    config.g   = static_cast<std::size_t>(-1) - i;
+    config.str = "s" + std::to_string(i);
+    return config;
+}
+
+static void TestRoundTrip()
+{
+    for(auto i = 0; i < 1000; ++i)
+    {
+        const auto config = MakeConfig(i);
+        const auto text   = Serialize(config);
+        EXPECT_EQUAL(text, LegacySerialize(config));
+
+        BenchConfig parsed;
+        EXPECT(parsed.Deserialize(text));
+        EXPECT(parsed == config);
+
+        BenchConfig legacy;
+        EXPECT(LegacyDeserialize(legacy, text));
+        EXPECT(legacy == parsed);
+    }
+
+    BenchConfig config;
+    EXPECT(config.Deserialize("-2147483648,2147483647,+3,0,1,-9223372036854775808,0,x"));
+    EXPECT_EQUAL(config.a, INT_MIN);
+    EXPECT_EQUAL(config.b, INT_MAX);
+    EXPECT_EQUAL(config.c, 3);
+    EXPECT_EQUAL(config.f, LLONG_MIN);
+    EXPECT(config.e);
+}
+
+static void TestMalformed()
+{
+    const auto valid = MakeConfig(5);
+    const std::vector<std::string> malformed = {
+        "",
+        "1,2,3",
+        "1,2,3,4,1,5,6",
+        "1,2,3,4,1,5,6,",
+        "x,2,3,4,1,5,6,s",
+        "1,,3,4,1,5,6,s",
+        "1,2,3,4,2,5,6,s",
+        "1,2,3,4,1,5,-6,s",
+        "2147483648,2,3,4,1,5,6,s",
+        "1,2,3,4,1,5,18446744073709551616,s",
+        "1 ,2,3,4,1,5,6,s",
+        "-,2,3,4,1,5,6,s",
+    };
+
+    for(const auto& s : malformed)
+    {
+        auto config = valid;
+        EXPECT(!config.Deserialize(s));
+        EXPECT(config == valid);
+    }
+}
+
+static void TestCompiledFields()
+{
+    NarrowConfig config;
+    EXPECT(config.Deserialize(std::vector<int>{1, -32768, 65535, 7}));
+    EXPECT(config.flag);
+    EXPECT_EQUAL(config.small, -32768);
+    EXPECT_EQUAL(config.unsigned_small, 65535);
+    EXPECT_EQUAL(config.count, 7u);
+
+    // The same values are rejected as in the text.
+    const std::vector<std::vector<int>> malformed = {
+        {2, 0, 0, 0}, {-1, 0, 0, 0}, {0, 32768, 0, 0}, {0, -32769, 0, 0}, {0, 0, 65536, 0},
+        {0, 0, -1, 0}, {0, 0, 0, -1},
+    };
+    for(const auto& fields : malformed)
+    {
+        std::string text;
+        for(const auto field : fields)
+            text += (text.empty() ? "" : ",") + std::to_string(field);
+        EXPECT(!config.Deserialize(fields));
+        EXPECT(!config.Deserialize(text));
+        EXPECT_EQUAL(config.count, 7u);
+    }
+}
+
+template <class F>
+static double Measure(F f)
+{
+    const auto start = std::chrono::steady_clock::now();
+    f();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+static void Benchmark()
+{
+    const auto n = 100000;
+    std::vector<std::string> texts;
+    texts.reserve(n);
+    for(auto i = 0; i < n; ++i)
+        texts.push_back(Serialize(MakeConfig(i)));
+
+    auto checksum_legacy = 0ll;
+    auto checksum        = 0ll;
+    BenchConfig config;
+
+    const auto legacy_ms = Measure([&] {
+        for(const auto& text : texts)
+        {
+            LegacyDeserialize(config, text);
+            checksum_legacy += config.a + config.c;
+        }
+    });
+    const auto current_ms = Measure([&] {
+        for(const auto& text : texts)
+        {
+            config.Deserialize(text);
+            checksum += config.a + config.c;
+        }
+    });
+    EXPECT_EQUAL(checksum, checksum_legacy);
+
+    std::cout << "Deserialize of " << n << " records: stringstream " << legacy_ms
+              << " ms, in place " << current_ms << " ms" << std::endl;
+
+    const auto legacy_serialize_ms = Measure([&] {
+        for(auto i = 0; i < n; ++i)
+            checksum_legacy += LegacySerialize(MakeConfig(i)).size();
+    });
+    const auto serialize_ms = Measure([&] {
+        for(auto i = 0; i < n; ++i)
+            checksum += Serialize(MakeConfig(i)).size();
+    });
+    EXPECT_EQUAL(checksum, checksum_legacy);
+
+    std::cout << "Serialize of " << n << " records: stream operators " << legacy_serialize_ms
+              << " ms, stack formatting " << serialize_ms << " ms" << std::endl;
+}
+
+int main()
+{
+    TestRoundTrip();
+    TestMalformed();
+    TestCompiledFields();
+    Benchmark();
+}
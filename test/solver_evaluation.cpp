@@ -0,0 +1,202 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2019 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/mlo_internal.hpp>
+#include <miopen/solver.hpp>
+#include "test.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/// Solvers which take longer the earlier they are in the list, so evaluations
+/// running at once finish in the reverse order.
+template <int N>
+struct SlowSolver
+{
+    static constexpr int Index() { return N; }
+    static std::chrono::milliseconds Duration() { return std::chrono::milliseconds(10 * (8 - N)); }
+};
+
+struct Concurrency
+{
+    std::atomic<int> current{0};
+    std::atomic<int> max{0};
+
+    void Enter()
+    {
+        const auto now = ++current;
+        auto seen      = max.load();
+        while(now > seen && !max.compare_exchange_weak(seen, now))
+        {
+        }
+    }
+
+    void Leave() { --current; }
+};
+
+template <class F>
+static void ForEachSlowSolver(bool parallel, F consume, int throwing = -1)
+{
+    Concurrency concurrency;
+    miopen::solver::ForEachSolver<SlowSolver<0>,
+                                  SlowSolver<1>,
+                                  SlowSolver<2>,
+                                  SlowSolver<3>,
+                                  SlowSolver<4>,
+                                  SlowSolver<5>,
+                                  SlowSolver<6>,
+                                  SlowSolver<7>>(
+        parallel,
+        [&](auto solver) {
+            concurrency.Enter();
+            std::this_thread::sleep_for(solver.Duration());
+            concurrency.Leave();
+            if(solver.Index() == throwing)
+                throw std::runtime_error("evaluation failed");
+            return solver.Index() * solver.Index();
+        },
+        consume);
+    if(!parallel)
+        EXPECT_EQUAL(concurrency.max.load(), 1);
+    else if(miopen::solver::GetSolverPool().Size() > 1)
+        EXPECT(concurrency.max.load() > 1);
+}
+
+static void check_order(bool parallel)
+{
+    std::vector<int> consumed;
+    ForEachSlowSolver(parallel, [&](auto solver, int result) {
+        EXPECT_EQUAL(result, solver.Index() * solver.Index());
+        consumed.push_back(solver.Index());
+    });
+    EXPECT(consumed.size() == 8);
+    EXPECT(std::is_sorted(consumed.begin(), consumed.end()));
+}
+
+static void check_errors(bool parallel)
+{
+    // An evaluation error is rethrown when its solver is due, after the ones before it.
+    std::vector<int> consumed;
+    auto thrown = false;
+    try
+    {
+        ForEachSlowSolver(
+            parallel, [&](auto solver, int) { consumed.push_back(solver.Index()); }, 5);
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    EXPECT(thrown);
+    EXPECT(consumed.size() == 5);
+
+    // An error of the consumer stops the rest, and the evaluations in flight are waited for.
+    consumed.clear();
+    thrown = false;
+    try
+    {
+        ForEachSlowSolver(parallel, [&](auto solver, int) {
+            consumed.push_back(solver.Index());
+            if(solver.Index() == 2)
+                throw std::runtime_error("consumer failed");
+        });
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    EXPECT(thrown);
+    EXPECT(consumed.size() == 3);
+}
+
+struct WorkingSolver : miopen::solver::SolverBase<miopen::ConvolutionContext>
+{
+    miopen::solver::ConvSolution GetSolution(const miopen::ConvolutionContext&) const
+    {
+        miopen::solver::KernelInfo kernel;
+        kernel.kernel_file = "WorkingSolver";
+
+        miopen::solver::ConvSolution solution;
+        solution.construction_params.push_back(kernel);
+        return solution;
+    }
+};
+
+struct ThrowingSolver : miopen::solver::SolverBase<miopen::ConvolutionContext>
+{
+    miopen::solver::ConvSolution GetSolution(const miopen::ConvolutionContext&) const
+    {
+        MIOPEN_THROW("Evaluated though not needed");
+    }
+};
+
+static void check_skipped_errors(bool parallel)
+{
+    // Only searches are done one by one.
+    miopen::ConvolutionContext context;
+    context.direction.Set(1);
+    context.do_search = !parallel;
+    int db            = 0;
+
+    // Errors of the solvers after the first success, as well as those after the rest
+    // is skipped in the find first mode, are of no interest.
+    const auto solution =
+        miopen::solver::SearchForSolution<WorkingSolver, ThrowingSolver>(context, db);
+    EXPECT(solution.Succeeded());
+    EXPECT_EQUAL(solution.construction_params[0].kernel_file, "WorkingSolver");
+
+    const auto all =
+        miopen::solver::SearchForAllSolutions<WorkingSolver, ThrowingSolver>(context, db);
+    EXPECT(all.size() == 1);
+
+    auto thrown = false;
+    try
+    {
+        miopen::solver::SearchForSolution<ThrowingSolver, WorkingSolver>(context, db);
+    }
+    catch(const miopen::Exception&)
+    {
+        thrown = true;
+    }
+    EXPECT(thrown);
+}
+
+int main()
+{
+    setenv("MIOPEN_DEBUG_FIND_FIRST_CONV", "1", 1);
+
+    for(const auto parallel : {false, true})
+    {
+        check_order(parallel);
+        check_errors(parallel);
+        check_skipped_errors(parallel);
+    }
+}